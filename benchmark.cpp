@@ -0,0 +1,769 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <set>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include "dingo_array.h"
+
+using namespace std;
+
+/*
+ * Helpers
+ */
+typedef chrono::high_resolution_clock Clock;
+
+double elapsedMs (Clock::time_point begin) {
+  return chrono::duration<double, milli>(Clock::now() - begin).count();
+}
+
+template <class T>
+vector<T> makeData (int n, const string &distribution, unsigned seed = 42) {
+  mt19937 gen(seed);
+  vector<T> data(n);
+  for (int i = 0; i < n; i++) data[i] = (T) (gen() % 1000000000) - (T) 500000000;
+  if (distribution == "sorted") sort(data.begin(), data.end());
+  else if (distribution == "reversed") sort(data.rbegin(), data.rend());
+  else if (distribution == "few-unique") for (int i = 0; i < n; i++) data[i] = (T) (gen() % 16);
+  return data;
+}
+
+void printRow (const string &name, int n, const string &distribution, double ms) {
+  cout<<left<<setw(32)<<name<<setw(12)<<n<<setw(14)<<distribution<<right<<setw(12)<<fixed<<setprecision(3)<<ms<<" ms"<<endl;
+}
+
+/*
+ * Sorting engines
+ */
+template <class T>
+void benchSort (const string &typeName) {
+  const int sizes[] = {1000, 100000, 1000000};
+  const string distributions[] = {"random", "sorted", "reversed", "few-unique"};
+  for (int n : sizes) {
+    for (const string &dist : distributions) {
+      vector<T> data = makeData<T>(n, dist);
+      vector<T> copy = data;
+      Clock::time_point t = Clock::now();
+      sort(copy.begin(), copy.end());
+      printRow("std::sort<" + typeName + ">", n, dist, elapsedMs(t));
+      copy = data;
+      t = Clock::now();
+      array_detail::introSort(copy.data(), n, true);
+      printRow("introSort<" + typeName + ">", n, dist, elapsedMs(t));
+      copy = data;
+      t = Clock::now();
+      array_detail::radixSort(copy.data(), n, true);
+      printRow("radixSort<" + typeName + ">", n, dist, elapsedMs(t));
+      Array<T> a(data);
+      t = Clock::now();
+      a.sort();
+      printRow("Array<" + typeName + ">::sort", n, dist, elapsedMs(t));
+    }
+  }
+}
+
+template <class T>
+void benchSortParallel (const string &typeName) {
+  const int sizes[] = {1000000, 10000000};
+  for (int n : sizes) {
+    vector<T> data = makeData<T>(n, "random");
+    Array<T> a(data);
+    Clock::time_point t = Clock::now();
+    a.sort();
+    printRow("Array<" + typeName + ">::sort", n, "random", elapsedMs(t));
+    Array<T> b(data);
+    t = Clock::now();
+    b.sortParallel();
+    printRow("Array<" + typeName + ">::sortParallel", n, "random", elapsedMs(t));
+  }
+}
+
+/*
+ * Reductions
+ */
+void benchReductions () {
+  const int n = 20000000;
+  vector<double> data = makeData<double>(n, "random");
+  Array<double> a(data);
+  ArrayPolicy parallel;
+  volatile double sink = 0;
+  Clock::time_point t = Clock::now();
+  sink = a.sum();
+  printRow("Array<double>::sum", n, "random", elapsedMs(t));
+  t = Clock::now();
+  sink = a.sum(parallel);
+  printRow("Array<double>::sum(policy)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  sink = a.max();
+  printRow("Array<double>::max", n, "random", elapsedMs(t));
+  t = Clock::now();
+  sink = a.max(parallel);
+  printRow("Array<double>::max(policy)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  sink = a.variance();
+  printRow("Array<double>::variance", n, "random", elapsedMs(t));
+  t = Clock::now();
+  sink = a.variance(parallel);
+  printRow("Array<double>::variance(policy)", n, "random", elapsedMs(t));
+  (void) sink;
+}
+
+/*
+ * Element-wise arithmetic kernels
+ */
+template <class T, int Op>
+void benchKernel (const string &name, const vector<T> &a, const vector<T> &b, vector<T> &out) {
+  const char* levels[] = {"scalar", "sse2", "avx2", "avx512"};
+  const int n = (int) a.size(), reps = 20;
+  for (int level = 0; level <= array_detail::detectSimdLevel(); level++) {
+    array_detail::setSimdLevel(level);
+    array_detail::arith<Op>(a.data(), b.data(), out.data(), n);
+    Clock::time_point t = Clock::now();
+    for (int r = 0; r < reps; r++) array_detail::arith<Op>(a.data(), b.data(), out.data(), n);
+    double ms = elapsedMs(t) / reps;
+    double gbs = 3.0 * n * sizeof(T) / (ms * 1e6);
+    cout<<left<<setw(32)<<name<<setw(12)<<n<<setw(14)<<levels[level]<<right<<setw(12)<<fixed<<setprecision(2)<<gbs<<" GB/s"<<endl;
+  }
+  array_detail::setSimdLevel(array_detail::detectSimdLevel());
+}
+
+template <class T>
+void benchKernels (const string &typeName) {
+  const int n = 1 << 20;
+  vector<T> a = makeData<T>(n, "random", 1), b = makeData<T>(n, "random", 2), out(n);
+  for (int i = 0; i < n; i++) if (b[i] == 0) b[i] = 1;
+  benchKernel<T, array_detail::OP_ADD>(typeName + " a + b", a, b, out);
+  benchKernel<T, array_detail::OP_SUB>(typeName + " a - b", a, b, out);
+  benchKernel<T, array_detail::OP_MUL>(typeName + " a * b", a, b, out);
+  benchKernel<T, array_detail::OP_DIV>(typeName + " a / b", a, b, out);
+}
+
+/*
+ * Expression templates
+ */
+void benchExpressions () {
+  const int n = 10000000;
+  Array<double> a(makeData<double>(n, "random", 1)), b(makeData<double>(n, "random", 2)), c(makeData<double>(n, "random", 3));
+  Clock::time_point t = Clock::now();
+  Array<double> t1 = (a * 2.0).eval();
+  Array<double> t2 = (t1 + b).eval();
+  Array<double> eager = (t2 - c).eval();
+  printRow("a * 2 + b - c (temporaries)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  Array<double> fused = a * 2.0 + b - c;
+  printRow("a * 2 + b - c (fused)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  volatile double s = (a * 2.0 + b - c).sum();
+  printRow("(a * 2 + b - c).sum() (fused)", n, "random", elapsedMs(t));
+  (void) s;
+}
+
+// Many short-lived Arrays per round: copy of a small source, multi-index subscripts, findAll, comparisons and slices of a small source
+template <class Alloc>
+void benchAllocator (const string &name, ArrayArena* arena = nullptr) {
+  const int rounds = 200000;
+  vector<int> data = makeData<int>(64, "few-unique", 5);
+  Array<int> index({1, 3, 5, 7, 11, 13, 17, 19});
+  Clock::time_point t = Clock::now();
+  volatile int sink = 0;
+  for (int r = 0; r < rounds; r++) {
+    {
+      Array<int, Alloc> a(data.data(), (int) data.size());
+      Array<int, Alloc> picked = a[index];
+      Array<int, Alloc> found = a.findAll(a[r % 64]);
+      Array<bool, Alloc> mask = a > a[0];
+      Array<int, Alloc> part = a.slice(r % 32, -1);
+      sink = sink + picked.size() + found.size() + mask.size() + part.size();
+    }
+    // Per-request bulk release of everything allocated in the round
+    if (arena != nullptr) arena->reset();
+  }
+  printRow(name, rounds, "few-unique", elapsedMs(t));
+}
+
+void benchAllocators () {
+  benchAllocator<ArrayMallocAllocator>("alloc churn (malloc)");
+  benchAllocator<ArrayPoolAllocator>("alloc churn (pool)");
+  benchAllocator<ArrayAlignedAllocator<64>>("alloc churn (aligned 64)");
+  ArrayArena arena;
+  ArrayArena::Scope scope(arena);
+  benchAllocator<ArrayArenaAllocator>("alloc churn (arena)", &arena);
+}
+
+// Opening a binary column: read into std::vector + copy into Array vs mapping the file
+void benchMapFile () {
+#if ARRAY_MMAP
+  const int n = 32000000;
+  const char* path = "dingo_array_bench.bin";
+  vector<double> data = makeData<double>(n, "random", 9);
+  FILE* f = fopen(path, "wb");
+  fwrite(data.data(), sizeof(double), n, f);
+  fclose(f);
+  data.clear();
+  data.shrink_to_fit();
+  Clock::time_point t = Clock::now();
+  {
+    vector<double> loaded(n);
+    f = fopen(path, "rb");
+    size_t got = fread(loaded.data(), sizeof(double), n, f);
+    fclose(f);
+    Array<double> a(loaded);
+    printRow("open file (fread + copy)", (int) got, "random", elapsedMs(t));
+  }
+  t = Clock::now();
+  {
+    Array<double, ArrayMapAllocator> m = Array<double>::mapFile(path);
+    printRow("open file (mapFile)", m.size(), "random", elapsedMs(t));
+    t = Clock::now();
+    m.advise('s');
+    volatile double s = m.sum();
+    printRow("mapFile + sum()", m.size(), "random", elapsedMs(t));
+    (void) s;
+  }
+  remove(path);
+#endif
+}
+
+// Persisting and reloading an Array: text (one value per line) vs binary `save` / `load`
+void benchSerialization () {
+  const int n = 10000000;
+  Array<double> a(makeData<double>(n, "random", 11));
+  const char* textPath = "dingo_array_bench.txt";
+  const char* binPath = "dingo_array_bench.dna";
+  Clock::time_point t = Clock::now();
+  {
+    ofstream out(textPath);
+    out<<setprecision(17);
+    for (int i = 0; i < n; i++) out<<a[i]<<'\n';
+  }
+  printRow("save (text)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  {
+    ifstream in(textPath);
+    Array<double> b;
+    b.reserve(n);
+    double v;
+    while (in>>v) b.append(v);
+  }
+  printRow("load (text)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  a.save(binPath);
+  printRow("save (binary)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  {
+    Array<double> b = Array<double>::load(binPath);
+  }
+  printRow("load (binary)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  {
+    ArrayReader<double> reader(binPath);
+    Array<double> chunk;
+    volatile double s = 0;
+    while (reader.read(chunk, 1 << 16) > 0) s = s + chunk.sum();
+  }
+  printRow("ArrayReader 64k chunks + sum", n, "random", elapsedMs(t));
+  remove(textPath);
+  remove(binPath);
+}
+
+// Combining and counting masks: one byte per element (previous `Array<bool>` layout) vs packed `Array<bool>`
+void benchMasks () {
+  const int n = 50000000;
+  mt19937 gen(13);
+  vector<char> ba(n), bb(n), bc(n), bm(n);
+  Array<bool> pa(n), pb(n), pc(n);
+  for (int i = 0; i < n; i++) {
+    unsigned r = gen();
+    ba[i] = r & 1;
+    bb[i] = (r >> 1) & 1;
+    bc[i] = (r >> 2) & 1;
+    pa[i] = r & 1;
+    pb[i] = (r >> 1) & 1;
+    pc[i] = (r >> 2) & 1;
+  }
+  Clock::time_point t = Clock::now();
+  for (int i = 0; i < n; i++) bm[i] = (ba[i] & bb[i]) | bc[i];
+  printRow("(a & b) | c (byte mask)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  Array<bool> pm = (pa & pb) | pc;
+  printRow("(a & b) | c (packed mask)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  pa &= pb;
+  pa |= pc;
+  printRow("a &= b; a |= c (packed mask)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  volatile int cnt = (int) count(bm.begin(), bm.end(), 1);
+  printRow("count true (byte mask)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  cnt = pm.countTrue();
+  printRow("countTrue() (packed mask)", n, "random", elapsedMs(t));
+  (void) cnt;
+  cout<<"mask memory: byte "<<(long long) n * sizeof(char) / 1024<<" KiB, packed "<<(long long) pm.capacity() / 8 / 1024<<" KiB"<<endl;
+}
+
+// Selecting elements by a mask: filter() with a function vs append loop vs compaction at each instruction set
+template <class T>
+void benchCompress (const string &typeName) {
+  const int n = 20000000;
+  const string levels[] = {"scalar", "sse2", "avx2", "avx512"};
+  Array<T> a(makeData<T>(n, "random", 17));
+  Array<bool> mask = a > 0;
+  Clock::time_point t = Clock::now();
+  Array<T> filtered = a.filter([] (T elem) { return elem > 0; });
+  printRow(typeName + " filter(elem > 0)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  Array<T> appended;
+  for (int i = 0; i < n; i++) if (mask[i]) appended.append(a[i]);
+  printRow(typeName + " append loop", n, "random", elapsedMs(t));
+  for (int level = array_detail::SIMD_SCALAR; level <= array_detail::detectSimdLevel(); level++) {
+    if (level == array_detail::SIMD_SSE2) continue;
+    array_detail::setSimdLevel(level);
+    t = Clock::now();
+    Array<T> selected = a[mask];
+    printRow(typeName + " a[mask] (" + levels[level] + ")", n, "random", elapsedMs(t));
+  }
+  array_detail::setSimdLevel(array_detail::detectSimdLevel());
+  t = Clock::now();
+  Array<T> fused = a[a > 0];
+  printRow(typeName + " a[a > 0]", n, "random", elapsedMs(t));
+}
+
+// Subsequence search: std::search vs Array::find / count on short, long and periodic (worst case) patterns
+void benchSearchCase (const string &name, const Array<int> &a, const vector<int> &hay, const vector<int> &pattern) {
+  Clock::time_point t = Clock::now();
+  volatile long long pos = search(hay.begin(), hay.end(), pattern.begin(), pattern.end()) - hay.begin();
+  printRow(name + " (std::search)", a.size(), "few-unique", elapsedMs(t));
+  t = Clock::now();
+  pos = a.find(pattern);
+  printRow(name + " (find)", a.size(), "few-unique", elapsedMs(t));
+  t = Clock::now();
+  pos = a.count(pattern);
+  printRow(name + " (count)", a.size(), "few-unique", elapsedMs(t));
+  (void) pos;
+}
+
+void benchSearch () {
+  const int n = 20000000;
+  vector<int> hay = makeData<int>(n, "few-unique", 19);
+  Array<int> a(hay);
+  vector<int> shortPattern = {16, 3, 7, 1};
+  vector<int> longPattern(64);
+  for (int i = 0; i < 64; i++) longPattern[i] = 16 + i;
+  benchSearchCase("short pattern (4)", a, hay, shortPattern);
+  benchSearchCase("long pattern (64)", a, hay, longPattern);
+  vector<int> ones(n, 1);
+  Array<int> b(ones);
+  vector<int> periodic(64, 1);
+  periodic.back() = 2;
+  benchSearchCase("periodic pattern (64)", b, ones, periodic);
+}
+
+void benchMultiSearchCase (const string &name, int alphabet, int patterns) {
+  const int n = 4000000;
+  mt19937 rng(23);
+  vector<int> hay(n);
+  for (int i = 0; i < n; i++) hay[i] = (int) (rng() % alphabet);
+  Array<int> a(hay);
+  PatternSet<int> set;
+  vector<Array<int>> list;
+  for (int p = 0; p < patterns; p++) {
+    int start = (int) (rng() % (n - 16)), len = 4 + (int) (rng() % 8);
+    Array<int> pattern(vector<int>(hay.begin() + start, hay.begin() + start + len));
+    set.add(pattern);
+    list.push_back(pattern);
+  }
+  Clock::time_point t = Clock::now();
+  volatile long long found = 0;
+  for (size_t p = 0; p < list.size(); p++) found = found + a.findAll(list[p]).size();
+  printRow(name + " (findAll)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  set.compile();
+  found = a.findAllMulti(set).size();
+  printRow(name + " (multi)", n, "random", elapsedMs(t));
+  (void) found;
+}
+
+void benchMultiSearch () {
+  benchMultiSearchCase("200 pat, 16 sym", 16, 200);
+  benchMultiSearchCase("200 pat, 1000 sym", 1000, 200);
+  benchMultiSearchCase("1000 pat, 2^30 sym", 1 << 30, 1000);
+}
+
+void benchUnique () {
+  const int n = 10000000;
+  const string distributions[] = {"random", "few-unique"};
+  for (const string &dist : distributions) {
+    vector<int> data = makeData<int>(n, dist, 29);
+    Array<int> a(data);
+    Clock::time_point t = Clock::now();
+    vector<int> copy(data);
+    sort(copy.begin(), copy.end());
+    volatile long long groups = unique(copy.begin(), copy.end()) - copy.begin();
+    printRow("std::sort + std::unique", n, dist, elapsedMs(t));
+    t = Clock::now();
+    groups = a.unique().size();
+    printRow("Array<int>::unique", n, dist, elapsedMs(t));
+    t = Clock::now();
+    groups = a.sortedUnique().size();
+    printRow("Array<int>::sortedUnique", n, dist, elapsedMs(t));
+    t = Clock::now();
+    groups = a.uniqueCounts().size();
+    printRow("Array<int>::uniqueCounts", n, dist, elapsedMs(t));
+    t = Clock::now();
+    groups = a.uniqueInverse(true).size();
+    printRow("Array<int>::uniqueInverse(true)", n, dist, elapsedMs(t));
+    (void) groups;
+  }
+}
+
+bool positivePtr (int elem) { return elem > 0; }
+double halfPtr (int elem) { return elem * 0.5; }
+
+void benchCallables () {
+  const int n = 20000000;
+  vector<int> data = makeData<int>(n, "random", 31);
+  Array<int> a(data);
+  bool (*positive)(int) = positivePtr;
+  double (*half)(int) = halfPtr;
+  // Opaque pointers keep the compiler from resolving the call target
+  volatile uintptr_t opaque = (uintptr_t) positive;
+  positive = (bool (*)(int)) opaque;
+  opaque = (uintptr_t) half;
+  half = (double (*)(int)) opaque;
+  Clock::time_point t = Clock::now();
+  volatile long long checksum = a.filter(positive).size();
+  printRow("filter (function pointer)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  int limit = 0;
+  checksum = a.filter([limit] (int elem) { return elem > limit; }).size();
+  printRow("filter (capturing lambda)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  checksum = a.map(half).size();
+  printRow("map (function pointer)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  double scale = 0.5;
+  checksum = a.map([scale] (int elem) { return elem * scale; }).size();
+  printRow("map (capturing lambda)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  long long sum = 0;
+  a.forEach([&sum] (int elem) { sum += elem; });
+  checksum = sum;
+  printRow("forEach (capturing lambda)", n, "random", elapsedMs(t));
+  (void) checksum;
+}
+
+void benchParallelCallables () {
+  const int n = 4000000;
+  vector<double> data = makeData<double>(n, "random", 37);
+  Array<double> a(data);
+  ArrayPolicy policy;
+  // CPU-heavy element function
+  auto heavy = [] (double elem) {
+    double x = elem * 1e-9;
+    for (int k = 0; k < 8; k++) x = sin(x) + cos(x);
+    return x;
+  };
+  Clock::time_point t = Clock::now();
+  volatile long long checksum = a.map(heavy).size();
+  printRow("map (heavy)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  checksum = a.map(policy, heavy).size();
+  printRow("map(policy) (heavy)", n, "random", elapsedMs(t));
+  auto keep = [&heavy] (double elem) { return heavy(elem) > 1.2; };
+  t = Clock::now();
+  checksum = a.filter(keep).size();
+  printRow("filter (heavy)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  checksum = a.filter(policy, keep).size();
+  printRow("filter(policy) (heavy)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  checksum = a.filter([] (double elem) { return elem > 0; }).size();
+  printRow("filter (cheap)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  checksum = a.filter(policy, [] (double elem) { return elem > 0; }).size();
+  printRow("filter(policy) (cheap)", n, "random", elapsedMs(t));
+  (void) checksum;
+}
+
+void benchDescribe () {
+  const int n = 20000000;
+  vector<double> data = makeData<double>(n, "random", 41);
+  Array<double> a(data);
+  Clock::time_point t = Clock::now();
+  volatile double checksum = a.min() + a.max() + a.mean() + a.variance() + a.stdev() + a.meanH();
+  printRow("min/max/mean/variance/stdev/meanH", n, "random", elapsedMs(t));
+  t = Clock::now();
+  ArrayStats<double> st = a.describe();
+  checksum = st.min + st.max + st.mean + st.variance() + st.stdev() + st.meanH();
+  printRow("describe()", n, "random", elapsedMs(t));
+  t = Clock::now();
+  st = a.describe(ArrayPolicy());
+  checksum = st.mean;
+  printRow("describe(policy)", n, "random", elapsedMs(t));
+  (void) checksum;
+}
+
+void benchRunningStats () {
+  const int n = 20000000;
+  vector<double> data = makeData<double>(n, "random", 43);
+  Clock::time_point t = Clock::now();
+  Array<double> a;
+  for (int i = 0; i < n; i++) a.append(data[i]);
+  volatile double checksum = a.mean() + a.variance();
+  printRow("append + mean/variance", n, "random", elapsedMs(t));
+  t = Clock::now();
+  RunningStats<double> r;
+  for (int i = 0; i < n; i++) r.push(data[i]);
+  checksum = r.mean() + r.variance();
+  printRow("RunningStats::push", n, "random", elapsedMs(t));
+  t = Clock::now();
+  RunningStats<double> batch;
+  const int chunk = 65536;
+  for (int i = 0; i < n; i += chunk) batch.push(Array<double>(&data[i], n - i < chunk ? n - i : chunk));
+  checksum = batch.mean() + batch.variance();
+  printRow("RunningStats::push(Array) 64k", n, "random", elapsedMs(t));
+  (void) checksum;
+}
+
+void benchMoving () {
+  const int n = 2000000;
+  Array<double> a(makeData<double>(n, "random", 47));
+  const int windows[] = {16, 256};
+  for (int w : windows) {
+    string suffix = " w=" + to_string(w);
+    Clock::time_point t = Clock::now();
+    Array<double> naive(n - w + 1);
+    for (int i = 0; i + w <= n; i++) naive[i] = a.sum(i, i + w - 1);
+    volatile double checksum = naive[0];
+    printRow("sum(i, i+w-1) loop" + suffix, n, "random", elapsedMs(t));
+    t = Clock::now();
+    checksum = a.movingSum(w)[0];
+    printRow("movingSum" + suffix, n, "random", elapsedMs(t));
+    t = Clock::now();
+    for (int i = 0; i + w <= n; i++) naive[i] = a.min(i, i + w - 1);
+    checksum = naive[0];
+    printRow("min(i, i+w-1) loop" + suffix, n, "random", elapsedMs(t));
+    t = Clock::now();
+    checksum = a.movingMin(w)[0];
+    printRow("movingMin" + suffix, n, "random", elapsedMs(t));
+    t = Clock::now();
+    for (int i = 0; i + w <= n; i++) naive[i] = a.variance(i, i + w - 1);
+    checksum = naive[0];
+    printRow("variance(i, i+w-1) loop" + suffix, n, "random", elapsedMs(t));
+    t = Clock::now();
+    checksum = a.movingVariance(w)[0];
+    printRow("movingVariance" + suffix, n, "random", elapsedMs(t));
+    (void) checksum;
+  }
+}
+
+template <class T>
+void benchCumulative (const string &typeName) {
+  const int n = 4000000;
+  Array<T> a(makeData<T>(n, "random", 53));
+  Array<T> x = a;
+  Clock::time_point t = Clock::now();
+  for (int i = 1; i < n; i++) x[i] += x[i - 1];
+  volatile double checksum = (double) x[n - 1];
+  printRow("x[i] += x[i-1] loop " + typeName, n, "random", elapsedMs(t));
+  int levels[] = { array_detail::SIMD_SCALAR, array_detail::detectSimdLevel() };
+  for (int level : levels) {
+    array_detail::setSimdLevel(level);
+    string suffix = " " + typeName + (level == array_detail::SIMD_SCALAR ? " scalar" : " simd");
+    x = a;
+    t = Clock::now();
+    x.cumsumInPlace();
+    checksum = (double) x[n - 1];
+    printRow("cumsumInPlace" + suffix, n, "random", elapsedMs(t));
+    x = a;
+    t = Clock::now();
+    x.cummaxInPlace();
+    checksum = (double) x[n - 1];
+    printRow("cummaxInPlace" + suffix, n, "random", elapsedMs(t));
+  }
+  t = Clock::now();
+  checksum = (double) a.cumsum()[n - 1];
+  printRow("cumsum " + typeName, n, "random", elapsedMs(t));
+  x = a;
+  t = Clock::now();
+  x.cumsumInPlace(ArrayPolicy());
+  checksum = (double) x[n - 1];
+  printRow("cumsumInPlace(policy) " + typeName, n, "random", elapsedMs(t));
+  (void) checksum;
+}
+
+void benchRangeQuery () {
+  const int n = 1000000, queries = 2000;
+  Array<double> a(makeData<double>(n, "random", 59));
+  vector<int> from(queries), to(queries);
+  mt19937 rng(61);
+  for (int q = 0; q < queries; q++) {
+    from[q] = (int) (rng() % n);
+    to[q] = from[q] + (int) (rng() % (n - from[q]));
+  }
+  Clock::time_point t = Clock::now();
+  volatile double checksum = 0;
+  for (int q = 0; q < queries; q++) checksum = checksum + a.min(from[q], to[q]) + a.sum(from[q], to[q]);
+  printRow("Array min + sum x2000", n, "random", elapsedMs(t));
+  t = Clock::now();
+  RangeQueryIndex<double> ix(a);
+  printRow("RangeQueryIndex build", n, "random", elapsedMs(t));
+  t = Clock::now();
+  for (int q = 0; q < queries; q++) checksum = checksum + ix.min(from[q], to[q]) + ix.sum(from[q], to[q]);
+  printRow("RangeQueryIndex min + sum x2000", n, "random", elapsedMs(t));
+  t = Clock::now();
+  RangeQueryTree<double> tr(a);
+  printRow("RangeQueryTree build", n, "random", elapsedMs(t));
+  t = Clock::now();
+  for (int q = 0; q < queries; q++) {
+    tr.set(from[q], 0.5);
+    checksum = checksum + tr.min(from[q], to[q]) + tr.sum(from[q], to[q]);
+  }
+  printRow("RangeQueryTree set+query x2000", n, "random", elapsedMs(t));
+  (void) checksum;
+}
+
+void benchSortedSearch () {
+  const int n = 1000000, queries = 2000, batch = 200000;
+  Array<int> a(makeData<int>(n, "random", 67));
+  a.sort();
+  Array<int> unknown = a;
+  unknown[0] = unknown[0];
+  mt19937 rng(71);
+  vector<int> values(batch);
+  for (int i = 0; i < batch; i++) values[i] = (int) rng();
+  Clock::time_point t = Clock::now();
+  volatile long long checksum = 0;
+  for (int q = 0; q < queries; q++) checksum = checksum + unknown.find(values[q]) + unknown.count(values[q]);
+  printRow("find + count x2000 (linear)", n, "sorted", elapsedMs(t));
+  t = Clock::now();
+  for (int q = 0; q < queries; q++) checksum = checksum + a.find(values[q]) + a.count(values[q]);
+  printRow("find + count x2000 (sorted)", n, "sorted", elapsedMs(t));
+  Array<int> randomBatch = Array<int>::fromVector(values);
+  t = Clock::now();
+  checksum = checksum + a.searchsorted(randomBatch)[batch - 1];
+  printRow("searchsorted 200k (random)", n, "sorted", elapsedMs(t));
+  Array<int> sortedBatch = randomBatch.toSorted();
+  t = Clock::now();
+  checksum = checksum + a.searchsorted(sortedBatch)[batch - 1];
+  printRow("searchsorted 200k (sorted)", n, "sorted", elapsedMs(t));
+  (void) checksum;
+}
+
+void benchSetOperations () {
+  const int n = 1000000;
+  Array<int> a(makeData<int>(n, "random", 73)), b(makeData<int>(n, "random", 79));
+  for (int i = 0; i < n; i++) {
+    a[i] &= 0xFFFFF;
+    b[i] &= 0xFFFFF;
+  }
+  Clock::time_point t = Clock::now();
+  set<int> sa = a.toSet(), sb = b.toSet();
+  volatile int common = 0;
+  for (set<int>::const_iterator it = sa.begin(); it != sa.end(); ++it) common = common + (int) sb.count(*it);
+  printRow("std::set intersection", n, "random", elapsedMs(t));
+  t = Clock::now();
+  common = common + a.setIntersection(b).size();
+  printRow("setIntersection (unsorted)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  common = common + a.setIntersection(b, 'h').size();
+  printRow("setIntersection hash", n, "random", elapsedMs(t));
+  Array<int> sortedA = a.sortedUnique(), sortedB = b.sortedUnique();
+  int level = array_detail::simdLevel();
+  array_detail::setSimdLevel(array_detail::SIMD_SCALAR);
+  t = Clock::now();
+  common = common + sortedA.setIntersection(sortedB).size();
+  printRow("setIntersection sorted (scalar)", n, "sorted", elapsedMs(t));
+  array_detail::setSimdLevel(level);
+  t = Clock::now();
+  common = common + sortedA.setIntersection(sortedB).size();
+  printRow("setIntersection sorted (simd)", n, "sorted", elapsedMs(t));
+  t = Clock::now();
+  common = common + sortedA.setUnion(sortedB).size() + sortedA.setDifference(sortedB).size();
+  printRow("setUnion + setDifference sorted", n, "sorted", elapsedMs(t));
+  vector<int> fewItems, manyItems = sortedA.toVector();
+  for (int i = 0; i < sortedB.size(); i += sortedB.size() / 1000) fewItems.push_back(sortedB[i]);
+  Array<int> few = Array<int>::fromVector(fewItems);
+  vector<int> out(fewItems.size());
+  t = Clock::now();
+  for (int r = 0; r < 100; r++) {
+    common = common + array_detail::intersectMerge(&fewItems[0], 0, (int) fewItems.size(), &manyItems[0], 0, (int) manyItems.size(), &out[0], 0);
+  }
+  printRow("1k x 1M merge x100", n, "sorted", elapsedMs(t));
+  t = Clock::now();
+  for (int r = 0; r < 100; r++) common = common + few.setIntersection(sortedA).size();
+  printRow("1k x 1M galloping x100", n, "sorted", elapsedMs(t));
+  (void) common;
+}
+
+void benchHashIndex () {
+  const int n = 1000000, probes = 1000000;
+  Array<int> a(makeData<int>(n, "random", 83));
+  for (int i = 0; i < n; i++) a[i] &= 0x3FFFFF;
+  vector<int> values(probes);
+  mt19937 rng(89);
+  for (int q = 0; q < probes; q++) values[q] = (int) (rng() & 0x3FFFFF);
+  Clock::time_point t = Clock::now();
+  volatile long long checksum = 0;
+  for (int q = 0; q < 200; q++) checksum = checksum + a.find(values[q]) + a.count(values[q]);
+  printRow("find + count x200 (linear)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  HashIndex<int> h(a);
+  printRow("HashIndex build", n, "random", elapsedMs(t));
+  t = Clock::now();
+  for (int q = 0; q < probes; q++) checksum = checksum + h.find(values[q]) + h.count(values[q]);
+  printRow("HashIndex find + count x1M", n, "random", elapsedMs(t));
+  Array<int> extra(makeData<int>(1000, "random", 97));
+  a.append(extra);
+  t = Clock::now();
+  h.afterAppend(a);
+  printRow("HashIndex afterAppend (1000)", n, "random", elapsedMs(t));
+  a.insert(extra, n / 2);
+  t = Clock::now();
+  h.afterInsert(a, n / 2);
+  printRow("HashIndex afterInsert (1000)", n, "random", elapsedMs(t));
+  t = Clock::now();
+  h.build(a);
+  printRow("HashIndex rebuild", n, "random", elapsedMs(t));
+  (void) checksum;
+}
+
+int main () {
+  cout<<"Running all benchmarks..."<<endl;
+  cout<<left<<setw(32)<<"case"<<setw(12)<<"size"<<setw(14)<<"distribution"<<right<<setw(15)<<"time"<<endl;
+  benchSort<int>("int");
+  benchSort<double>("double");
+  benchSortParallel<int>("int");
+  benchSortParallel<double>("double");
+  benchReductions();
+  benchKernels<int32_t>("int32");
+  benchKernels<int64_t>("int64");
+  benchKernels<float>("float");
+  benchKernels<double>("double");
+  benchExpressions();
+  benchAllocators();
+  benchMapFile();
+  benchSerialization();
+  benchMasks();
+  benchCompress<int32_t>("int32");
+  benchCompress<double>("double");
+  benchSearch();
+  benchMultiSearch();
+  benchUnique();
+  benchCallables();
+  benchParallelCallables();
+  benchDescribe();
+  benchRunningStats();
+  benchMoving();
+  benchCumulative<int32_t>("int32");
+  benchCumulative<double>("double");
+  benchRangeQuery();
+  benchSortedSearch();
+  benchSetOperations();
+  benchHashIndex();
+  return 0;
+}
@@ -14,916 +14,7517 @@
 #define DINGO_ARRAY_H
 
 #include <math.h>
+#include <iostream>
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+#include <stdexcept>
 #include <vector>
 #include <list>
 #include <set>
+#include <stdint.h>
+#include <type_traits>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <exception>
+#include <map>
+#include <utility>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARRAY_SIMD_X86 1
+#include <immintrin.h>
+#define ARRAY_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ARRAY_SIMD_X86 0
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#define ARRAY_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#define ARRAY_MMAP 0
+#endif
 #pragma GCC optimize("O3")
 #define MAX_S(a, b) a > b ? a : b
 #define ARRAY_BEGIN 0                // Min index available
 #define ARRAY_END 2147483647         // Max index available
+#ifndef ARRAY_MIN_CAPACITY
+#define ARRAY_MIN_CAPACITY 8  // Smallest capacity allocated when an Array starts growing
+#endif
+#ifndef ARRAY_INSERTION_SORT_MAX
+#define ARRAY_INSERTION_SORT_MAX 16  // Ranges up to this length are finished with insertion sort
+#endif
+#ifndef ARRAY_RADIX_SORT_MIN
+#define ARRAY_RADIX_SORT_MIN 256  // Ranges shorter than this never use radix sort
+#endif
+#ifndef ARRAY_PARALLEL_GRAIN
+#define ARRAY_PARALLEL_GRAIN 32768  // Default minimal amount of elements processed by one parallel task
+#endif
+#ifndef ARRAY_POOL_MAX_BLOCK
+#define ARRAY_POOL_MAX_BLOCK 65536  // Largest block (bytes) cached by `ArrayPoolAllocator`
+#endif
+#ifndef ARRAY_POOL_CACHE
+#define ARRAY_POOL_CACHE 64  // Max free blocks `ArrayPoolAllocator` keeps per size class and thread
+#endif
+#ifndef ARRAY_ARENA_BLOCK
+#define ARRAY_ARENA_BLOCK 1048576  // Default size (bytes) of blocks reserved by `ArrayArena`
+#endif
 
-template <class T>
-class Array {
+/**
+ * @brief Thread pool shared by parallel `Array` operations. The thread calling `run` takes part in the work,
+ * so nested `run` calls never deadlock and a pool with `0` workers simply runs everything serially
+ */
+class ArrayThreadPool {
   private:
-    T* A;
-    int S;
-    int idx (int index) const {
-      if (index < -this->S || index >= this->S) throw std::invalid_argument("Invalid Array Index!");
-      if (index >= 0) return index;
-      return index + this->S;
-    }
-    void checkRange (int From, int To) const {
-      int width = idx(To) - idx(From) + 1;
-      if (width < 1 || width > this->S) throw std::invalid_argument("Invalid From-To Range");
-      return;
+    struct Job {
+      std::function<void(int)> fn;
+      int chunks;
+      std::atomic<int> next;
+      std::atomic<int> done;
+      std::exception_ptr error;
+      std::mutex errorMutex;
+      Job (const std::function<void(int)> &f, int c) : fn(f), chunks(c), next(0), done(0) {}
+    };
+    std::vector<std::thread> workers;
+    std::deque<std::shared_ptr<Job>> jobs;
+    std::mutex m;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    bool stopping;
+
+    // Execute chunks of `job` until none are left. Returns after the last claimed chunk is done
+    void work (Job &job) {
+      while (true) {
+        int c = job.next++;
+        if (c >= job.chunks) return;
+        try {
+          job.fn(c);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(job.errorMutex);
+          if (!job.error) job.error = std::current_exception();
+        }
+        if (++job.done == job.chunks) {
+          std::lock_guard<std::mutex> lock(this->m);
+          this->finished.notify_all();
+        }
+      }
     }
-    static void checkSize (int size) {
-      if (size < ARRAY_BEGIN || size > ARRAY_END) throw std::invalid_argument("Invalid Array Size provided");
-      return;
+    void retire (const std::shared_ptr<Job> &job) {
+      for (auto it = this->jobs.begin(); it != this->jobs.end(); it++) {
+        if (*it == job) {
+          this->jobs.erase(it);
+          return;
+        }
+      }
     }
-    void sizeAlloc (int size) {
-      checkSize(size);
-      this->S = size;
-      if (size > 0) this->A = (T*) calloc(size, sizeof(T));
-      else this->A = nullptr;
+    void loop () {
+      while (true) {
+        std::shared_ptr<Job> job;
+        {
+          std::unique_lock<std::mutex> lock(this->m);
+          this->wake.wait(lock, [this] { return this->stopping || !this->jobs.empty(); });
+          if (this->stopping) return;
+          job = this->jobs.front();
+          if (job->next >= job->chunks) {
+            this->retire(job);
+            continue;
+          }
+        }
+        this->work(*job);
+      }
     }
   public:
-    /* STATIC METHODS FOR CONVERSIONS */
-    static Array fromVector (const std::vector < T > &STL_Vector) {
-      Array a;
-      a.sizeAlloc(STL_Vector.size());
-      for (int i = 0; i < a.size(); i++) a[i] = STL_Vector[i];
-      return a;
+    // Create pool with `threads` worker threads (besides the calling thread)
+    explicit ArrayThreadPool (int threads) : stopping(false) {
+      for (int i = 0; i < threads; i++) this->workers.push_back(std::thread(&ArrayThreadPool::loop, this));
     }
-    static Array fromList (const std::list < T > &STL_List) {
-      Array a;
-      a.sizeAlloc(STL_List.size());
-      int i = 0;
-      for (auto it = STL_List.cbegin(); it != STL_List.cend(); it++) {
-        if (i >= a.size()) break;
-        a[i] = *it;
-        i++;
+    ArrayThreadPool (const ArrayThreadPool&) = delete;
+    ArrayThreadPool& operator= (const ArrayThreadPool&) = delete;
+    ~ArrayThreadPool () {
+      {
+        std::lock_guard<std::mutex> lock(this->m);
+        this->stopping = true;
       }
-      return a;
+      this->wake.notify_all();
+      for (size_t i = 0; i < this->workers.size(); i++) this->workers[i].join();
     }
-    static Array fromSet (const std::set < T > &STL_Set) {
-      Array a;
-      a.sizeAlloc(STL_Set.size());
-      int i = 0;
-      for (auto it = STL_Set.cbegin(); it != STL_Set.cend(); it++) {
-        if (i >= a.size()) break;
-        a[i] = *it;
-        i++;
+    // Pool used by all parallel `Array` operations, one thread per hardware thread (calling thread included)
+    static ArrayThreadPool& shared () {
+      static ArrayThreadPool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+      return pool;
+    }
+    // Number of threads that can work on a job at once (workers + calling thread)
+    int concurrency () const noexcept { return (int) this->workers.size() + 1; }
+    /**
+     * @brief Call `fn(chunk)` for every `chunk` in `[0,chunks)` and wait until all calls are done.
+     * First exception thrown by `fn` is rethrown in the calling thread
+     */
+    void run (int chunks, const std::function<void(int)> &fn) {
+      if (chunks <= 0) return;
+      if (chunks == 1 || this->workers.empty()) {
+        for (int c = 0; c < chunks; c++) fn(c);
+        return;
       }
-      return a;
+      std::shared_ptr<Job> job = std::make_shared<Job>(fn, chunks);
+      {
+        std::lock_guard<std::mutex> lock(this->m);
+        this->jobs.push_back(job);
+      }
+      this->wake.notify_all();
+      this->work(*job);
+      {
+        std::unique_lock<std::mutex> lock(this->m);
+        this->finished.wait(lock, [&job] { return job->done == job->chunks; });
+        this->retire(job);
+      }
+      if (job->error) std::rethrow_exception(job->error);
     }
-    static Array fromInitList (std::initializer_list<T> InitValues) {
-      Array a;
-      a.sizeAlloc(InitValues.size());
-      int i = 0;
-      for (auto it = InitValues.begin(); it != InitValues.end(); it++) {
-        if (i >= a.size()) break;
-        a[i] = *it;
-        i++;
+};
+
+/**
+ * @brief Execution policy for parallel `Array` operations
+ */
+struct ArrayPolicy {
+  int threads;  // Max number of threads, `0` = every thread of `ArrayThreadPool::shared()`
+  int grain;    // Min number of elements per task. Inputs shorter than `2 * grain` run serially
+  explicit ArrayPolicy (int threads = 0, int grain = ARRAY_PARALLEL_GRAIN) : threads(threads), grain(grain > 0 ? grain : 1) {}
+  // Number of tasks `n` elements should be split into (`1` = run serially)
+  int tasks (int n) const {
+    int t = this->threads > 0 ? this->threads : ArrayThreadPool::shared().concurrency();
+    int byGrain = n / this->grain;
+    if (byGrain < t) t = byGrain;
+    return t < 1 ? 1 : t;
+  }
+};
+
+/*
+ * Allocators for `Array<T, Alloc>` storage. An allocator is a class with static methods
+ *   `void* allocate(size_t bytes)` - returns `nullptr` on failure,
+ *   `void* reallocate(void* ptr, size_t oldBytes, size_t newBytes)` - keeps first `min(oldBytes, newBytes)` bytes, returns `nullptr` on failure,
+ *   `void deallocate(void* ptr, size_t bytes)` - `ptr` may be `nullptr`.
+ * `bytes` passed to `reallocate` and `deallocate` is always the size the block was allocated with
+ */
+
+/**
+ * @brief Default `Array` allocator using `malloc`, `realloc` and `free`
+ */
+struct ArrayMallocAllocator {
+  static void* allocate (size_t bytes) { return malloc(bytes); }
+  static void* reallocate (void* ptr, size_t oldBytes, size_t newBytes) {
+    (void) oldBytes;
+    return realloc(ptr, newBytes);
+  }
+  static void deallocate (void* ptr, size_t bytes) {
+    (void) bytes;
+    free(ptr);
+  }
+};
+
+/**
+ * @brief Allocator returning blocks aligned to `Align` bytes (default 64 = cache line / AVX-512 register),
+ * so SIMD kernels can use aligned loads on `Array` storage
+ */
+template <size_t Align = 64>
+struct ArrayAlignedAllocator {
+  static_assert(Align >= sizeof(void*) && (Align & (Align - 1)) == 0, "Alignment should be a power of 2 not less than pointer size");
+  static void* allocate (size_t bytes) {
+    // Original `malloc` pointer is kept just below the aligned block
+    char* raw = (char*) malloc(bytes + Align + sizeof(void*));
+    if (raw == NULL) return nullptr;
+    uintptr_t aligned = ((uintptr_t) (raw + sizeof(void*)) + Align - 1) & ~((uintptr_t) Align - 1);
+    ((void**) aligned)[-1] = raw;
+    return (void*) aligned;
+  }
+  static void* reallocate (void* ptr, size_t oldBytes, size_t newBytes) {
+    void* newPtr = allocate(newBytes);
+    if (newPtr == nullptr) return nullptr;
+    if (ptr != nullptr) {
+      memcpy(newPtr, ptr, oldBytes < newBytes ? oldBytes : newBytes);
+      deallocate(ptr, oldBytes);
+    }
+    return newPtr;
+  }
+  static void deallocate (void* ptr, size_t bytes) {
+    (void) bytes;
+    if (ptr != nullptr) free(((void**) ptr)[-1]);
+  }
+};
+
+/**
+ * @brief Size-class pool allocator. Blocks up to `ARRAY_POOL_MAX_BLOCK` bytes are rounded up to a power of 2
+ * and recycled through per-thread free lists, so creating and destroying many small Arrays
+ * (e.g. results of `findAll`, `slice` or comparisons) rarely reaches `malloc`. Larger blocks use `malloc` directly
+ */
+struct ArrayPoolAllocator {
+  private:
+    static const int MIN_SHIFT = 4;
+    struct Cache {
+      std::vector<void*> lists[32];
+      ~Cache () {
+        for (int c = 0; c < 32; c++) {
+          for (size_t i = 0; i < lists[c].size(); i++) free(lists[c][i]);
+        }
       }
-      return a;
+    };
+    static Cache& cache () {
+      static thread_local Cache c;
+      return c;
     }
-    static Array fromPointer (T* ptr, int size) {
-      Array a;
-      a.sizeAlloc(size);
-      for (int i = 0; i < a.size(); i++) a[i] = ptr[i];
-      return a;
+    // Size class of `bytes` (block size `1 << sizeClass`), `-1` for blocks not pooled
+    static int sizeClass (size_t bytes) {
+      if (bytes > ARRAY_POOL_MAX_BLOCK) return -1;
+      int c = MIN_SHIFT;
+      while (((size_t) 1 << c) < bytes) c++;
+      return c;
     }
-    /* CONSTRUCTORS */
-    // Empty Array Constructor -> Size = 0
-    Array () {
-      this->S = 0;
-      this->A = nullptr;
+  public:
+    static void* allocate (size_t bytes) {
+      int c = sizeClass(bytes);
+      if (c < 0) return malloc(bytes);
+      std::vector<void*> &list = cache().lists[c];
+      if (list.empty()) return malloc((size_t) 1 << c);
+      void* ptr = list.back();
+      list.pop_back();
+      return ptr;
     }
-    // Array Constructor with initial size
-    explicit Array (int s) { this->sizeAlloc(s); }
-    // Array Constructor using STL Vector
-    explicit Array (const std::vector < T > &STL_Vector) {
-      this->sizeAlloc(STL_Vector.size());
-      for (int i = 0; i < this->S; i++) this->A[i] = STL_Vector[i];
+    static void* reallocate (void* ptr, size_t oldBytes, size_t newBytes) {
+      int oldC = ptr == nullptr ? -2 : sizeClass(oldBytes), newC = sizeClass(newBytes);
+      if (oldC >= 0 && oldC == newC) return ptr;
+      if (oldC == -1 && newC == -1) return realloc(ptr, newBytes);
+      void* newPtr = allocate(newBytes);
+      if (newPtr == nullptr) return nullptr;
+      if (ptr != nullptr) {
+        memcpy(newPtr, ptr, oldBytes < newBytes ? oldBytes : newBytes);
+        deallocate(ptr, oldBytes);
+      }
+      return newPtr;
     }
-    // Array Constructor using STL List
-    explicit Array (const std::list < T > &STL_List) {
-      this->sizeAlloc(STL_List.size());
-      int i = 0;
-      for (auto it = STL_List.cbegin(); it != STL_List.cend(); it++) {
-        if (i >= this->S) break;
-        this->A[i] = *it;
-        i++;
+    static void deallocate (void* ptr, size_t bytes) {
+      if (ptr == nullptr) return;
+      int c = sizeClass(bytes);
+      if (c < 0) {
+        free(ptr);
+        return;
       }
+      std::vector<void*> &list = cache().lists[c];
+      if ((int) list.size() >= ARRAY_POOL_CACHE) free(ptr);
+      else list.push_back(ptr);
     }
-    // Array Constructor using STL Set
-    explicit Array (const std::set < T > &STL_Set) {
-      this->sizeAlloc(STL_Set.size());
-      int i = 0;
-      for (auto it = STL_Set.cbegin(); it != STL_Set.cend(); it++) {
-        if (i >= this->S) break;
-        this->A[i] = *it;
-        i++;
+};
+
+/**
+ * @brief Bump (arena) memory for `ArrayArenaAllocator`. Allocation moves a pointer forward inside large blocks,
+ * freeing is a no-op (except for the most recent block, which can be rewound or grown in place)
+ * and `reset()` releases everything at once.
+ * Arrays using `ArrayArenaAllocator` allocate from the arena made active on the current thread with `ArrayArena::Scope`
+ * @warning Arrays allocated from an arena must be destroyed before the arena is `reset()` or destroyed.
+ * An Array stays in the arena it was created in when it grows, even if another arena is active by then
+ */
+class ArrayArena {
+  private:
+    struct Block {
+      char* data;
+      size_t size;
+    };
+    std::vector<Block> blocks;
+    size_t blockSize;
+    size_t offset;  // First free byte of the last block
+    char* last;     // Most recent allocation
+    size_t total;   // Bytes handed out since last reset
+    static size_t round (size_t bytes) { return (bytes + 15) & ~(size_t) 15; }
+    static ArrayArena*& activeSlot () {
+      static thread_local ArrayArena* arena = nullptr;
+      return arena;
+    }
+  public:
+    /**
+     * @brief Make `arena` active on the current thread for the lifetime of this object (previous one is restored after)
+     */
+    class Scope {
+      private:
+        ArrayArena* previous;
+      public:
+        explicit Scope (ArrayArena &arena) : previous(ArrayArena::activeSlot()) { ArrayArena::activeSlot() = &arena; }
+        Scope (const Scope&) = delete;
+        Scope& operator= (const Scope&) = delete;
+        ~Scope () { ArrayArena::activeSlot() = this->previous; }
+    };
+    explicit ArrayArena (size_t blockSize = ARRAY_ARENA_BLOCK) : blockSize(blockSize > 0 ? blockSize : ARRAY_ARENA_BLOCK), offset(0), last(nullptr), total(0) {}
+    ArrayArena (const ArrayArena&) = delete;
+    ArrayArena& operator= (const ArrayArena&) = delete;
+    ~ArrayArena () {
+      for (size_t i = 0; i < this->blocks.size(); i++) free(this->blocks[i].data);
+    }
+    // Arena active on the current thread (`nullptr` if none)
+    static ArrayArena* active () noexcept { return activeSlot(); }
+    // Bytes handed out since construction or last `reset()`
+    size_t used () const noexcept { return this->total; }
+    // Bytes reserved from the system
+    size_t reserved () const noexcept {
+      size_t r = 0;
+      for (size_t i = 0; i < this->blocks.size(); i++) r += this->blocks[i].size;
+      return r;
+    }
+    void* allocate (size_t bytes) {
+      bytes = round(bytes);
+      if (this->blocks.empty() || this->offset + bytes > this->blocks.back().size) {
+        size_t size = bytes > this->blockSize ? bytes : this->blockSize;
+        char* data = (char*) malloc(size);
+        if (data == NULL) return nullptr;
+        this->blocks.push_back(Block{data, size});
+        this->offset = 0;
       }
+      this->last = this->blocks.back().data + this->offset;
+      this->offset += bytes;
+      this->total += bytes;
+      return this->last;
     }
-    // Array Constructor using STL Initializer List
-    explicit Array (std::initializer_list<T> InitValues) {
-      this->sizeAlloc(InitValues.size());
-      int i = 0;
-      for (auto it = InitValues.begin(); it != InitValues.end(); ++it) {
-        if (i >= this->S) break;
-        this->A[i] = *it;
-        i++;
+    void* reallocate (void* ptr, size_t oldBytes, size_t newBytes) {
+      if (ptr != nullptr && ptr == this->last) {
+        size_t start = this->last - this->blocks.back().data;
+        if (start + round(newBytes) <= this->blocks.back().size) {
+          this->total += round(newBytes) - (this->offset - start);
+          this->offset = start + round(newBytes);
+          return ptr;
+        }
       }
+      void* newPtr = this->allocate(newBytes);
+      if (newPtr == nullptr) return nullptr;
+      if (ptr != nullptr) memcpy(newPtr, ptr, oldBytes < newBytes ? oldBytes : newBytes);
+      return newPtr;
     }
-    // Array Constructor using pointer
-    Array (const T* dynamicArray, int arraySize) {
-      this->sizeAlloc(arraySize);
-      for (int i = 0; i < this->S; i++) this->A[i] = dynamicArray[i];
+    void deallocate (void* ptr) {
+      if (ptr == nullptr || ptr != this->last) return;
+      size_t start = this->last - this->blocks.back().data;
+      this->total -= this->offset - start;
+      this->offset = start;
+      this->last = nullptr;
     }
-    // Copy constructor
-    Array(const Array& other) : S(other.S) {
-      if (this->S > 0) {
-        this->A = (T*) malloc(this->S * sizeof(T));
-        for (int i = 0; i < this->S; i++) this->A[i] = other.A[i];
-      } else this->A = nullptr;
+    // Release all allocations at once. The largest block is kept for reuse
+    void reset () {
+      if (this->blocks.empty()) return;
+      size_t keep = 0;
+      for (size_t i = 1; i < this->blocks.size(); i++) {
+        if (this->blocks[i].size > this->blocks[keep].size) keep = i;
+      }
+      for (size_t i = 0; i < this->blocks.size(); i++) {
+        if (i != keep) free(this->blocks[i].data);
+      }
+      Block b = this->blocks[keep];
+      this->blocks.clear();
+      this->blocks.push_back(b);
+      this->offset = 0;
+      this->last = nullptr;
+      this->total = 0;
     }
-    // Move constructor
-    Array(Array&& other) noexcept : S(other.S), A(other.A) {
-      other.S = 0;
-      other.A = nullptr;
+};
+
+/**
+ * @brief Allocator taking memory from the `ArrayArena` active on the current thread (see `ArrayArena::Scope`).
+ * Allocating without an active arena throws `std::invalid_argument`.
+ * Each block starts with a 16-byte header naming its arena, so an Array grows and is freed in the arena it was
+ * created in, whichever arena is active at that time
+ */
+struct ArrayArenaAllocator {
+  private:
+    static const size_t header = 16;  // Keeps the 16-byte alignment of arena allocations
+    static ArrayArena*& owner (void* ptr) { return *(ArrayArena**) ((char*) ptr - header); }
+  public:
+    static void* allocate (size_t bytes) {
+      ArrayArena* arena = ArrayArena::active();
+      if (arena == nullptr) throw std::invalid_argument("No ArrayArena is active on this thread");
+      char* block = (char*) arena->allocate(bytes + header);
+      if (block == nullptr) return nullptr;
+      owner(block + header) = arena;
+      return block + header;
     }
-    // Default Destructor
-    ~Array () {
-      if (this->A != nullptr) free(this->A);
+    static void* reallocate (void* ptr, size_t oldBytes, size_t newBytes) {
+      if (ptr == nullptr) return allocate(newBytes);
+      ArrayArena* arena = owner(ptr);
+      char* block = (char*) arena->reallocate((char*) ptr - header, oldBytes + header, newBytes + header);
+      if (block == nullptr) return nullptr;
+      owner(block + header) = arena;
+      return block + header;
+    }
+    static void deallocate (void* ptr, size_t bytes) {
+      (void) bytes;
+      if (ptr != nullptr) owner(ptr)->deallocate((char*) ptr - header);
+    }
+};
+
+#if ARRAY_MMAP
+/**
+ * @brief Allocator of file-backed Arrays created with `Array::mapFile`. Behaves like `ArrayMallocAllocator`,
+ * except for blocks created by `map`, which are `munmap`-ed when released.
+ * Growing a mapped Array (`append`, `insert`, `reserve`, ...) copies it to heap memory, detaching it from the file
+ */
+struct ArrayMapAllocator {
+  private:
+    static std::mutex& registryMutex () {
+      static std::mutex m;
+      return m;
+    }
+    // Live mappings: address -> mapped length
+    static std::map<void*, size_t>& registry () {
+      static std::map<void*, size_t> r;
+      return r;
+    }
+    // Mapped length of `ptr`, `0` if `ptr` is not a mapping
+    static size_t mappedLength (void* ptr) {
+      if (ptr == nullptr) return 0;
+      std::lock_guard<std::mutex> lock(registryMutex());
+      std::map<void*, size_t>::const_iterator it = registry().find(ptr);
+      return it == registry().end() ? 0 : it->second;
+    }
+    static void unmap (void* ptr, size_t length) {
+      {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        registry().erase(ptr);
+      }
+      munmap(ptr, length);
+    }
+  public:
+    static void* allocate (size_t bytes) { return malloc(bytes); }
+    static void* reallocate (void* ptr, size_t oldBytes, size_t newBytes) {
+      size_t length = mappedLength(ptr);
+      if (length == 0) return realloc(ptr, newBytes);
+      void* newPtr = malloc(newBytes);
+      if (newPtr == NULL) return nullptr;
+      memcpy(newPtr, ptr, oldBytes < newBytes ? oldBytes : newBytes);
+      unmap(ptr, length);
+      return newPtr;
+    }
+    static void deallocate (void* ptr, size_t bytes) {
+      (void) bytes;
+      size_t length = mappedLength(ptr);
+      if (length == 0) free(ptr);
+      else unmap(ptr, length);
     }
-    // Getting array size
-    int size () noexcept {return this->S;}
-    int size () const noexcept {return S;}
-    // Same as `size()`
-    int length () noexcept {return this->S;}
-    int length () const noexcept {return S;}
     /**
-     * @brief Print Array to stdout
-     * @param showType View `Array` type. Default `false`
-     * @param showBrackets View Brakcets. Default `true`
-     * @param endNewLine Print `\n` after viewing the array. Default `true`
-     * @param elemNewLine Print `\n` after each element. Default `false`
-     * @param bracketOpenChar Opening bracket character. Default `'['`
-     * @param bracketCloseChar Closing bracket character. Default `']'`
-     * @param sep Separator string. Default `", "`
+     * @brief Map whole file at `path` into memory
+     * @param path File path
+     * @param readOnly `true` - private copy-on-write mapping, the file is never modified.
+     * `false` - shared mapping, changes are written back to the file
+     * @param elemSize File size should be a multiple of it
+     * @param bytes Set to the file size
+     * @return void* - Mapping address (`nullptr` for empty file)
      */
-    void show (
-      bool showType = false, bool showBrackets = true, bool endNewLine = true, bool elemNewLine = false,
-      char bracketOpenChar = '[', char bracketCloseChar = ']', const std::string &sep = ", "
-    ) const noexcept {
-      if (showType) std::cout<<"`Array` ";
-      if (showBrackets) std::cout<<bracketOpenChar;
-      for (int i = 0; i < this->S; i++) {
-        std::cout<<this->A[i];
-        if (i < this->S - 1) std::cout<<sep;
-        if (elemNewLine) std::cout<<std::endl;
+    static void* map (const std::string &path, bool readOnly, size_t elemSize, size_t &bytes) {
+      int fd = open(path.c_str(), readOnly ? O_RDONLY : O_RDWR);
+      if (fd < 0) throw std::invalid_argument("Failed to open file: " + path);
+      struct stat st;
+      if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::invalid_argument("Failed to read file size: " + path);
       }
-      if (showBrackets) std::cout<<bracketCloseChar;
-      if (endNewLine) std::cout<<std::endl;
+      bytes = (size_t) st.st_size;
+      if (bytes % elemSize != 0 || bytes / elemSize > (size_t) ARRAY_END) {
+        close(fd);
+        throw std::invalid_argument("File size is not a valid Array size: " + path);
+      }
+      if (bytes == 0) {
+        close(fd);
+        return nullptr;
+      }
+      void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, readOnly ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+      close(fd);
+      if (ptr == MAP_FAILED) throw std::invalid_argument("Failed to map file: " + path);
+      std::lock_guard<std::mutex> lock(registryMutex());
+      registry()[ptr] = bytes;
+      return ptr;
     }
-    // Non-accessible and accessible subscripts (Negative indexing supported)
-    T& operator[] (int index) {return A[idx(index)];}
-    T operator[] (int index) const {return A[idx(index)];}
-    // Multi-index subscript operator (read-only)
-    Array<T> operator[] (Array<int> index) const {
-      Array<T> X;
-      for (int i = 0; i < index.size(); i++) {
-        X.append(this->A[idx(index[i])]);
+    // Write changes of mapping `ptr` back to its file (no-op for memory not mapped)
+    static void flush (void* ptr) {
+      size_t length = mappedLength(ptr);
+      if (length == 0) return;
+      if (msync(ptr, length, MS_SYNC) != 0) throw std::invalid_argument("Failed to flush mapped file");
+    }
+    // Pass access pattern hint for mapping `ptr` to the kernel (no-op for memory not mapped). See `Array::advise`
+    static void advise (void* ptr, char mode) {
+      int advice;
+      switch (mode) {
+        case 'n': advice = MADV_NORMAL; break;
+        case 's': advice = MADV_SEQUENTIAL; break;
+        case 'r': advice = MADV_RANDOM; break;
+        case 'w': advice = MADV_WILLNEED; break;
+        default: throw std::invalid_argument("Mode should be n - normal, s - sequential, r - random or w - will need");
+      }
+      size_t length = mappedLength(ptr);
+      if (length == 0) return;
+      madvise(ptr, length, advice);
+    }
+};
+#endif
+
+namespace array_detail {
+  // `true` if allocator `A` supports file-backed Arrays: has `flush` and `advise` (see `ArrayMapAllocator`)
+  template <class A, class = void>
+  struct IsMapAllocator : std::false_type {};
+  template <class A>
+  struct IsMapAllocator<A, decltype((void) A::flush((void*) nullptr), (void) A::advise((void*) nullptr, 'n'))> : std::true_type {};
+  // `Array::flush` / `Array::advise` calls, empty for other allocators (rejected by `static_assert` there)
+  template <class A> void flushMapped (void* ptr, std::true_type) { A::flush(ptr); }
+  template <class A> void flushMapped (void*, std::false_type) {}
+  template <class A> void adviseMapped (void* ptr, char mode, std::true_type) { A::advise(ptr, mode); }
+  template <class A> void adviseMapped (void*, char, std::false_type) {}
+}
+
+/*
+ * Sorting engines used by `Array::sort` and `Array::toSorted`
+ */
+namespace array_detail {
+  template <class T>
+  struct Ascending {
+    bool operator() (const T& a, const T& b) const { return a < b; }
+  };
+  template <class T>
+  struct Descending {
+    bool operator() (const T& a, const T& b) const { return b < a; }
+  };
+
+  // First index in `[lo,hi)` of `a` (sorted by `cmp`) whose item is not ordered before `x`
+  template <class T, class Cmp>
+  int lowerBound (const T* a, int lo, int hi, const T& x, Cmp cmp) {
+    while (lo < hi) {
+      int mid = lo + (hi - lo) / 2;
+      if (cmp(a[mid], x)) lo = mid + 1;
+      else hi = mid;
+    }
+    return lo;
+  }
+  // First index in `[lo,hi)` of `a` (sorted by `cmp`) whose item is ordered after `x`
+  template <class T, class Cmp>
+  int upperBound (const T* a, int lo, int hi, const T& x, Cmp cmp) {
+    while (lo < hi) {
+      int mid = lo + (hi - lo) / 2;
+      if (cmp(x, a[mid])) hi = mid;
+      else lo = mid + 1;
+    }
+    return lo;
+  }
+
+  template <class T, class Cmp>
+  void insertionSort (T* a, int n, Cmp cmp) {
+    for (int i = 1; i < n; i++) {
+      T v = a[i];
+      int j = i - 1;
+      while (j >= 0 && cmp(v, a[j])) {
+        a[j + 1] = a[j];
+        j--;
+      }
+      a[j + 1] = v;
+    }
+  }
+
+  template <class T, class Cmp>
+  void siftDown (T* a, int root, int n, Cmp cmp) {
+    T v = a[root];
+    while (true) {
+      int child = 2 * root + 1;
+      if (child >= n) break;
+      if (child + 1 < n && cmp(a[child], a[child + 1])) child++;
+      if (!cmp(v, a[child])) break;
+      a[root] = a[child];
+      root = child;
+    }
+    a[root] = v;
+  }
+
+  template <class T, class Cmp>
+  void heapSort (T* a, int n, Cmp cmp) {
+    for (int i = n / 2 - 1; i >= 0; i--) siftDown(a, i, n, cmp);
+    for (int i = n - 1; i > 0; i--) {
+      T temp = a[0];
+      a[0] = a[i];
+      a[i] = temp;
+      siftDown(a, 0, i, cmp);
+    }
+  }
+
+  template <class T, class Cmp>
+  void sortThree (T& x, T& y, T& z, Cmp cmp) {
+    T temp;
+    if (cmp(y, x)) { temp = x; x = y; y = temp; }
+    if (cmp(z, y)) { temp = y; y = z; z = temp; }
+    if (cmp(y, x)) { temp = x; x = y; y = temp; }
+  }
+
+  // Hoare partition of [lo, hi) around the median of three. Returns first index of the right part
+  template <class T, class Cmp>
+  int partition (T* a, int lo, int hi, Cmp cmp) {
+    int mid = lo + (hi - lo) / 2;
+    sortThree(a[lo], a[mid], a[hi - 1], cmp);
+    T pivot = a[mid];
+    int i = lo - 1, j = hi;
+    while (true) {
+      do i++; while (cmp(a[i], pivot));
+      do j--; while (cmp(pivot, a[j]));
+      if (i >= j) return j + 1;
+      T temp = a[i];
+      a[i] = a[j];
+      a[j] = temp;
+    }
+  }
+
+  template <class T, class Cmp>
+  void introSortLoop (T* a, int lo, int hi, int depth, Cmp cmp) {
+    while (hi - lo > ARRAY_INSERTION_SORT_MAX) {
+      if (depth == 0) {
+        heapSort(a + lo, hi - lo, cmp);
+        return;
+      }
+      depth--;
+      int p = partition(a, lo, hi, cmp);
+      // Recurse into the smaller part, loop on the larger one to bound stack depth
+      if (p - lo < hi - p) {
+        introSortLoop(a, lo, p, depth, cmp);
+        lo = p;
+      } else {
+        introSortLoop(a, p, hi, depth, cmp);
+        hi = p;
+      }
+    }
+    insertionSort(a + lo, hi - lo, cmp);
+  }
+
+  /**
+   * @brief Introsort: quicksort with median-of-three pivots, heapsort fallback after `2*log2(n)` levels
+   * and insertion sort for short ranges
+   */
+  template <class T, class Cmp>
+  void introSort (T* a, int n, Cmp cmp) {
+    if (n <= 1) return;
+    int depth = 0;
+    for (int m = n; m > 1; m >>= 1) depth += 2;
+    introSortLoop(a, 0, n, depth, cmp);
+  }
+  template <class T>
+  void introSort (T* a, int n, bool ascending) {
+    if (ascending) introSort(a, n, Ascending<T>());
+    else introSort(a, n, Descending<T>());
+  }
+
+  // Order-preserving unsigned keys for radix sort. `enabled` is false for unsupported types
+  template <class T, class Enable = void>
+  struct RadixKey {
+    static const bool enabled = false;
+    typedef uint32_t Key;
+    static Key get (const T&) { return 0; }
+  };
+  template <class T>
+  struct RadixKey<T, typename std::enable_if<
+    std::is_integral<T>::value && !std::is_same<T, bool>::value && (sizeof(T) == 4 || sizeof(T) == 8)
+  >::type> {
+    static const bool enabled = true;
+    typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type Key;
+    static Key get (const T& v) {
+      Key k = (Key) v;
+      if (std::is_signed<T>::value) k ^= (Key) 1 << (sizeof(Key) * 8 - 1);
+      return k;
+    }
+  };
+  template <class T>
+  struct RadixKey<T, typename std::enable_if<
+    std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)
+  >::type> {
+    static const bool enabled = true;
+    typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type Key;
+    static Key get (const T& v) {
+      Key k;
+      memcpy(&k, &v, sizeof(Key));
+      const Key sign = (Key) 1 << (sizeof(Key) * 8 - 1);
+      return (k & sign) ? ~k : (k | sign);
+    }
+  };
+
+  /**
+   * @brief LSD radix sort with 8-bit digits. Passes where every key shares the same digit are skipped
+   * @return false if the scratch buffer could not be allocated (nothing is modified then)
+   */
+  template <class T>
+  bool radixSort (T* a, int n, bool ascending) {
+    typedef RadixKey<T> RK;
+    typedef typename RK::Key Key;
+    if (n <= 1) return true;
+    T* buf = (T*) malloc(n * sizeof(T));
+    if (buf == NULL) return false;
+    const int passes = (int) sizeof(Key);
+    int* counts = (int*) calloc(passes * 256, sizeof(int));
+    if (counts == NULL) {
+      free(buf);
+      return false;
+    }
+    for (int i = 0; i < n; i++) {
+      Key k = RK::get(a[i]);
+      for (int p = 0; p < passes; p++) counts[p * 256 + ((k >> (p * 8)) & 0xFF)]++;
+    }
+    T* src = a;
+    T* dst = buf;
+    for (int p = 0; p < passes; p++) {
+      int* c = counts + p * 256;
+      bool trivial = false;
+      for (int d = 0; d < 256; d++) {
+        if (c[d] == n) trivial = true;
+        if (c[d] != 0) break;
+      }
+      if (trivial) continue;
+      int offset = 0;
+      for (int d = 0; d < 256; d++) {
+        int cnt = c[d];
+        c[d] = offset;
+        offset += cnt;
       }
+      for (int i = 0; i < n; i++) dst[c[(RK::get(src[i]) >> (p * 8)) & 0xFF]++] = src[i];
+      T* temp = src;
+      src = dst;
+      dst = temp;
+    }
+    if (src != a) memcpy((void*) a, (void*) src, n * sizeof(T));
+    free(counts);
+    free(buf);
+    if (!ascending) {
+      for (int i = 0; i < n / 2; i++) {
+        T temp = a[i];
+        a[i] = a[n - 1 - i];
+        a[n - 1 - i] = temp;
+      }
+    }
+    return true;
+  }
+
+  // Pick the engine for `n` elements: radix sort for supported numeric types, introsort otherwise
+  template <class T>
+  void sortRange (T* a, int n, bool ascending) {
+    if (RadixKey<T>::enabled && n >= ARRAY_RADIX_SORT_MIN && radixSort(a, n, ascending)) return;
+    introSort(a, n, ascending);
+  }
+
+  // Number of elements of `a` among the first `d` elements of the stable merge of `a` and `b`
+  template <class T, class Cmp>
+  int mergeSplit (const T* a, int na, const T* b, int nb, int d, Cmp cmp) {
+    int lo = d - nb > 0 ? d - nb : 0, hi = d < na ? d : na;
+    while (lo < hi) {
+      int i = lo + (hi - lo) / 2;
+      if (!cmp(b[d - i - 1], a[i])) lo = i + 1;
+      else hi = i;
+    }
+    return lo;
+  }
+
+  // Merge output elements `[d0,d1)` of the stable merge of `a` and `b` into `out + d0`
+  template <class T, class Cmp>
+  void mergePart (const T* a, int na, const T* b, int nb, T* out, int d0, int d1, Cmp cmp) {
+    int i = mergeSplit(a, na, b, nb, d0, cmp), j = d0 - i;
+    for (int k = d0; k < d1; k++) {
+      if (j >= nb || (i < na && !cmp(b[j], a[i]))) out[k] = a[i++];
+      else out[k] = b[j++];
+    }
+  }
+
+  template <class T, class Cmp>
+  void parallelMergeSort (T* a, int n, bool ascending, int tasks, Cmp cmp) {
+    T* buf = (T*) malloc(n * sizeof(T));
+    if (buf == NULL) {
+      sortRange(a, n, ascending);
+      return;
+    }
+    ArrayThreadPool &pool = ArrayThreadPool::shared();
+    // Runs are described by their boundaries: run r = [bounds[r], bounds[r + 1])
+    std::vector<int> bounds(tasks + 1);
+    for (int r = 0; r <= tasks; r++) bounds[r] = (int) ((long long) n * r / tasks);
+    pool.run(tasks, [&] (int r) { sortRange(a + bounds[r], bounds[r + 1] - bounds[r], ascending); });
+    T* src = a;
+    T* dst = buf;
+    while (bounds.size() > 2) {
+      int runs = (int) bounds.size() - 1, pairs = runs / 2;
+      int pieces = tasks / pairs > 1 ? tasks / pairs : 1;
+      pool.run(pairs * pieces + (runs % 2), [&] (int t) {
+        if (t == pairs * pieces) {
+          // Odd run without a partner is copied as-is
+          memcpy((void*) (dst + bounds[runs - 1]), (void*) (src + bounds[runs - 1]), (bounds[runs] - bounds[runs - 1]) * sizeof(T));
+          return;
+        }
+        int p = t / pieces, piece = t % pieces;
+        int lo = bounds[2 * p], mid = bounds[2 * p + 1], hi = bounds[2 * p + 2];
+        int len = hi - lo;
+        int d0 = (int) ((long long) len * piece / pieces), d1 = (int) ((long long) len * (piece + 1) / pieces);
+        mergePart(src + lo, mid - lo, src + mid, hi - mid, dst + lo, d0, d1, cmp);
+      });
+      std::vector<int> merged;
+      for (int r = 0; r < runs; r += 2) merged.push_back(bounds[r]);
+      merged.push_back(n);
+      bounds.swap(merged);
+      T* temp = src;
+      src = dst;
+      dst = temp;
+    }
+    if (src != a) memcpy((void*) a, (void*) src, n * sizeof(T));
+    free(buf);
+  }
+
+  /**
+   * @brief Parallel merge sort: chunks are sorted concurrently with `sortRange`, then merged pairwise.
+   * Every merge is split into independent pieces with a merge-path binary search, so all rounds stay parallel
+   */
+  template <class T>
+  void parallelSort (T* a, int n, bool ascending, const ArrayPolicy &policy) {
+    int tasks = policy.tasks(n);
+    if (tasks <= 1) {
+      sortRange(a, n, ascending);
+      return;
+    }
+    if (ascending) parallelMergeSort(a, n, ascending, tasks, Ascending<T>());
+    else parallelMergeSort(a, n, ascending, tasks, Descending<T>());
+  }
+
+  // Split `[b,e]` into `tasks` contiguous chunks and call `fn(chunk, lo, hi)` (inclusive bounds) for each one on the shared pool
+  template <class F>
+  void parallelChunks (int b, int e, int tasks, F fn) {
+    long long len = e - b + 1;
+    ArrayThreadPool::shared().run(tasks, [&] (int c) {
+      fn(c, b + (int) (len * c / tasks), b + (int) (len * (c + 1) / tasks) - 1);
+    });
+  }
+
+  // Welford running moments. Partial results from separate chunks are combined with `merge` (Chan et al.)
+  struct Moments {
+    long long n;
+    double mean;
+    double m2;
+    Moments () : n(0), mean(0.0), m2(0.0) {}
+    void add (double x) {
+      n++;
+      double delta = x - mean;
+      mean += delta / n;
+      m2 += delta * (x - mean);
+    }
+    void merge (const Moments &other) {
+      if (other.n == 0) return;
+      if (n == 0) {
+        *this = other;
+        return;
+      }
+      long long total = n + other.n;
+      double delta = other.mean - mean;
+      mean += delta * other.n / total;
+      m2 += other.m2 + delta * delta * ((double) n * other.n / total);
+      n = total;
+    }
+  };
+}
+
+/**
+ * @brief Summary statistics of `Array` items (see `Array::describe`). Statistics of separate ranges are combined with `merge`
+ */
+template <class T>
+struct ArrayStats {
+  long long count;
+  T min;
+  T max;
+  double sum;
+  double mean;
+  double m2;             // Sum of squared deviations from `mean`
+  double logSum;         // Sum of `log(x)`: `-inf` if any item is `0`, `NaN` if any item is negative
+  double reciprocalSum;  // Sum of `1 / x`
+  ArrayStats () : count(0), min(), max(), sum(0.0), mean(0.0), m2(0.0), logSum(0.0), reciprocalSum(0.0) {}
+  // Sample variance (`m2 / (count - 1)`), `0` for less than 2 items
+  double variance () const { return this->count > 1 ? this->m2 / (this->count - 1.0) : 0.0; }
+  double stdev () const { return sqrt(this->variance()); }
+  // Geometric mean computed from `logSum`, so it does not overflow like a product of the items
+  double meanG () const { return this->count > 0 ? exp(this->logSum / this->count) : 0.0; }
+  double meanH () const { return this->count > 0 ? this->count / this->reciprocalSum : 0.0; }
+  // Combine with statistics of another range (Chan et al. update for `mean` and `m2`)
+  void merge (const ArrayStats &other) {
+    if (other.count == 0) return;
+    if (this->count == 0) {
+      *this = other;
+      return;
+    }
+    long long total = this->count + other.count;
+    double delta = other.mean - this->mean;
+    this->mean += delta * other.count / total;
+    this->m2 += other.m2 + delta * delta * ((double) this->count * other.count / total);
+    if (other.min < this->min) this->min = other.min;
+    if (other.max > this->max) this->max = other.max;
+    this->sum += other.sum;
+    this->logSum += other.logSum;
+    this->reciprocalSum += other.reciprocalSum;
+    this->count = total;
+  }
+};
+
+#ifndef ARRAY_STATS_BLOCK
+#define ARRAY_STATS_BLOCK 1024  // Items summarized at once by `Array::describe` (kept in L1 for the deviation sweep)
+#endif
+
+namespace array_detail {
+  // Statistics of `a[0..n)`, `n > 0`. Each block is reduced with 4 independent accumulators, then swept again
+  // while still in cache for squared deviations from its own mean. Blocks are combined with `ArrayStats::merge`
+  template <class T>
+  ArrayStats<T> describe (const T* a, int n) {
+    ArrayStats<T> total;
+    for (int lo = 0; lo < n; lo += ARRAY_STATS_BLOCK) {
+      const T* p = a + lo;
+      int m = n - lo < ARRAY_STATS_BLOCK ? n - lo : ARRAY_STATS_BLOCK;
+      T mn[4] = { p[0], p[0], p[0], p[0] }, mx[4] = { p[0], p[0], p[0], p[0] };
+      double s[4] = { 0.0, 0.0, 0.0, 0.0 }, r[4] = { 0.0, 0.0, 0.0, 0.0 };
+      int i = 0;
+      for (; i + 4 <= m; i += 4) {
+        for (int k = 0; k < 4; k++) {
+          T x = p[i + k];
+          mn[k] = x < mn[k] ? x : mn[k];
+          mx[k] = x > mx[k] ? x : mx[k];
+          s[k] += (double) x;
+          r[k] += 1.0 / (double) x;
+        }
+      }
+      for (; i < m; i++) {
+        T x = p[i];
+        mn[0] = x < mn[0] ? x : mn[0];
+        mx[0] = x > mx[0] ? x : mx[0];
+        s[0] += (double) x;
+        r[0] += 1.0 / (double) x;
+      }
+      ArrayStats<T> st;
+      st.count = m;
+      st.min = mn[0];
+      st.max = mx[0];
+      for (int k = 1; k < 4; k++) {
+        if (mn[k] < st.min) st.min = mn[k];
+        if (mx[k] > st.max) st.max = mx[k];
+      }
+      st.sum = (s[0] + s[1]) + (s[2] + s[3]);
+      st.reciprocalSum = (r[0] + r[1]) + (r[2] + r[3]);
+      st.mean = st.sum / m;
+      double d[4] = { 0.0, 0.0, 0.0, 0.0 };
+      for (i = 0; i + 4 <= m; i += 4) {
+        for (int k = 0; k < 4; k++) {
+          double dev = (double) p[i + k] - st.mean;
+          d[k] += dev * dev;
+        }
+      }
+      for (; i < m; i++) {
+        double dev = (double) p[i] - st.mean;
+        d[0] += dev * dev;
+      }
+      st.m2 = (d[0] + d[1]) + (d[2] + d[3]);
+      // Log of the product. Items are multiplied directly and the products renormalized with `frexp` every `span` items,
+      // where `span` is small enough for the block's min and max not to leave the range of `double`
+      if (st.min > 0) {
+        int emin, emax;
+        frexp((double) st.min, &emin);
+        frexp((double) st.max, &emax);
+        int bits = (emax > -emin ? emax : -emin) + 1;
+        int span = 900 / bits;
+        double prod[4] = { 1.0, 1.0, 1.0, 1.0 };
+        long long exps = 0;
+        int e, full = span > 0 ? m & ~3 : 0;
+        for (i = 0; i < full; ) {
+          int end = full - i > 4 * span ? i + 4 * span : full;
+          for (; i < end; i += 4) {
+            for (int k = 0; k < 4; k++) prod[k] *= (double) p[i + k];
+          }
+          for (int k = 0; k < 4; k++) {
+            prod[k] = frexp(prod[k], &e);
+            exps += e;
+          }
+        }
+        // Remaining items (all of them for extreme exponents) are split into mantissa and exponent first
+        for (; i < m; i++) {
+          int f;
+          prod[0] *= frexp((double) p[i], &f);
+          prod[0] = frexp(prod[0], &e);
+          exps += e + f;
+        }
+        st.logSum = log((prod[0] * prod[1]) * (prod[2] * prod[3])) + exps * 0.69314718055994530942;
+      }
+      else st.logSum = st.min < 0 ? NAN : -INFINITY;
+      total.merge(st);
+    }
+    return total;
+  }
+}
+
+/*
+ * Element-wise arithmetic kernels used by `Array` arithmetic operators.
+ * Explicit SSE2 / AVX2 / AVX-512 versions exist for `int32`, `int64`, `float` and `double`,
+ * the best one supported by the CPU is picked at runtime. Other types and operations use the scalar kernels
+ */
+namespace array_detail {
+  enum SimdLevel { SIMD_SCALAR = 0, SIMD_SSE2 = 1, SIMD_AVX2 = 2, SIMD_AVX512 = 3 };
+  enum ArithOp { OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MOD, OP_OR, OP_AND, OP_XOR };
+
+  // Best instruction set supported by the CPU (and the OS, which has to save the wider registers)
+  inline int detectSimdLevel () {
+#if ARRAY_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse2")) return SIMD_SSE2;
+#endif
+    return SIMD_SCALAR;
+  }
+  inline int& simdLevelRef () {
+    static int level = detectSimdLevel();
+    return level;
+  }
+  // Instruction set used by the kernels
+  inline int simdLevel () { return simdLevelRef(); }
+  // Cap the instruction set used by the kernels (e.g. for benchmarking). Levels above `detectSimdLevel()` are ignored
+  inline void setSimdLevel (int level) {
+    int detected = detectSimdLevel();
+    simdLevelRef() = level < detected ? level : detected;
+  }
+
+  template <int Op, class T> struct Arith;
+  template <class T> struct Arith<OP_ADD, T> { static T apply (const T& a, const T& b) { return a + b; } };
+  template <class T> struct Arith<OP_SUB, T> { static T apply (const T& a, const T& b) { return a - b; } };
+  template <class T> struct Arith<OP_MUL, T> { static T apply (const T& a, const T& b) { return a * b; } };
+  template <class T> struct Arith<OP_DIV, T> { static T apply (const T& a, const T& b) { return a / b; } };
+  template <class T> struct Arith<OP_MOD, T> { static T apply (const T& a, const T& b) { return a % b; } };
+  template <class T> struct Arith<OP_OR, T> { static T apply (const T& a, const T& b) { return a | b; } };
+  template <class T> struct Arith<OP_AND, T> { static T apply (const T& a, const T& b) { return a & b; } };
+  template <class T> struct Arith<OP_XOR, T> { static T apply (const T& a, const T& b) { return a ^ b; } };
+  // `bool` operands promote to `int`, so `a * b` would be an integer product in boolean context
+  template <> struct Arith<OP_MUL, bool> { static bool apply (const bool& a, const bool& b) { return a && b; } };
+
+  // `Level` kernel for `Op` on `T`. Combinations without a specialization run the scalar loop
+  template <int Level, int Op, class T>
+  struct Kernel {
+    static void run (const T* a, const T* b, T* out, int n) {
+      for (int i = 0; i < n; i++) out[i] = Arith<Op, T>::apply(a[i], b[i]);
+    }
+    static void runScalar (const T* a, T b, T* out, int n) {
+      for (int i = 0; i < n; i++) out[i] = Arith<Op, T>::apply(a[i], b);
+    }
+  };
+
+#if ARRAY_SIMD_X86
+#define ARRAY_SIMD_KERNEL(LEVEL, ISA, T, OP, REG, W, LOAD, STORE, SET1, VOP) \
+  template <> struct Kernel<LEVEL, OP, T> { \
+    ARRAY_TARGET(ISA) static void run (const T* a, const T* b, T* out, int n) { \
+      int i = 0; \
+      for (; i + W <= n; i += W) STORE(out + i, VOP(LOAD(a + i), LOAD(b + i))); \
+      for (; i < n; i++) out[i] = Arith<OP, T>::apply(a[i], b[i]); \
+    } \
+    ARRAY_TARGET(ISA) static void runScalar (const T* a, T b, T* out, int n) { \
+      REG vb = SET1(b); \
+      int i = 0; \
+      for (; i + W <= n; i += W) STORE(out + i, VOP(LOAD(a + i), vb)); \
+      for (; i < n; i++) out[i] = Arith<OP, T>::apply(a[i], b); \
+    } \
+  };
+#define ARRAY_LOAD_SI128(p) _mm_loadu_si128((const __m128i*) (p))
+#define ARRAY_STORE_SI128(p, v) _mm_storeu_si128((__m128i*) (p), v)
+#define ARRAY_LOAD_SI256(p) _mm256_loadu_si256((const __m256i*) (p))
+#define ARRAY_STORE_SI256(p, v) _mm256_storeu_si256((__m256i*) (p), v)
+#define ARRAY_LOAD_SI512(p) _mm512_loadu_si512((const void*) (p))
+#define ARRAY_STORE_SI512(p, v) _mm512_storeu_si512((void*) (p), v)
+
+  // SSE2 (no 32-bit integer multiply before SSE4.1)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", float, OP_ADD, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_add_ps)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", float, OP_SUB, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_sub_ps)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", float, OP_MUL, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_mul_ps)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", float, OP_DIV, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_div_ps)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", double, OP_ADD, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_add_pd)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", double, OP_SUB, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_sub_pd)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", double, OP_MUL, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_mul_pd)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", double, OP_DIV, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_div_pd)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", int32_t, OP_ADD, __m128i, 4, ARRAY_LOAD_SI128, ARRAY_STORE_SI128, _mm_set1_epi32, _mm_add_epi32)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", int32_t, OP_SUB, __m128i, 4, ARRAY_LOAD_SI128, ARRAY_STORE_SI128, _mm_set1_epi32, _mm_sub_epi32)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", int64_t, OP_ADD, __m128i, 2, ARRAY_LOAD_SI128, ARRAY_STORE_SI128, _mm_set1_epi64x, _mm_add_epi64)
+  ARRAY_SIMD_KERNEL(SIMD_SSE2, "sse2", int64_t, OP_SUB, __m128i, 2, ARRAY_LOAD_SI128, ARRAY_STORE_SI128, _mm_set1_epi64x, _mm_sub_epi64)
+  // AVX2
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", float, OP_ADD, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_add_ps)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", float, OP_SUB, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_sub_ps)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", float, OP_MUL, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_mul_ps)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", float, OP_DIV, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_div_ps)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", double, OP_ADD, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_add_pd)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", double, OP_SUB, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_sub_pd)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", double, OP_MUL, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_mul_pd)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", double, OP_DIV, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_div_pd)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", int32_t, OP_ADD, __m256i, 8, ARRAY_LOAD_SI256, ARRAY_STORE_SI256, _mm256_set1_epi32, _mm256_add_epi32)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", int32_t, OP_SUB, __m256i, 8, ARRAY_LOAD_SI256, ARRAY_STORE_SI256, _mm256_set1_epi32, _mm256_sub_epi32)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", int32_t, OP_MUL, __m256i, 8, ARRAY_LOAD_SI256, ARRAY_STORE_SI256, _mm256_set1_epi32, _mm256_mullo_epi32)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", int64_t, OP_ADD, __m256i, 4, ARRAY_LOAD_SI256, ARRAY_STORE_SI256, _mm256_set1_epi64x, _mm256_add_epi64)
+  ARRAY_SIMD_KERNEL(SIMD_AVX2, "avx2", int64_t, OP_SUB, __m256i, 4, ARRAY_LOAD_SI256, ARRAY_STORE_SI256, _mm256_set1_epi64x, _mm256_sub_epi64)
+  // AVX-512 Foundation (64-bit integer multiply needs AVX-512DQ and stays scalar)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", float, OP_ADD, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_add_ps)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", float, OP_SUB, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_sub_ps)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", float, OP_MUL, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_mul_ps)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", float, OP_DIV, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_div_ps)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", double, OP_ADD, __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_add_pd)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", double, OP_SUB, __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_sub_pd)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", double, OP_MUL, __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_mul_pd)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", double, OP_DIV, __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_div_pd)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", int32_t, OP_ADD, __m512i, 16, ARRAY_LOAD_SI512, ARRAY_STORE_SI512, _mm512_set1_epi32, _mm512_add_epi32)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", int32_t, OP_SUB, __m512i, 16, ARRAY_LOAD_SI512, ARRAY_STORE_SI512, _mm512_set1_epi32, _mm512_sub_epi32)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", int32_t, OP_MUL, __m512i, 16, ARRAY_LOAD_SI512, ARRAY_STORE_SI512, _mm512_set1_epi32, _mm512_mullo_epi32)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", int64_t, OP_ADD, __m512i, 8, ARRAY_LOAD_SI512, ARRAY_STORE_SI512, _mm512_set1_epi64, _mm512_add_epi64)
+  ARRAY_SIMD_KERNEL(SIMD_AVX512, "avx512f", int64_t, OP_SUB, __m512i, 8, ARRAY_LOAD_SI512, ARRAY_STORE_SI512, _mm512_set1_epi64, _mm512_sub_epi64)
+#endif
+
+  // Kernel element type for `T`: signed 32/64-bit integers, `float` and `double`. `void` = scalar loop only
+  template <class T, class Enable = void>
+  struct SimdType { typedef void type; };
+  template <class T>
+  struct SimdType<T, typename std::enable_if<
+    std::is_integral<T>::value && std::is_signed<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)
+  >::type> {
+    typedef typename std::conditional<sizeof(T) == 4, int32_t, int64_t>::type type;
+  };
+  template <> struct SimdType<float> { typedef float type; };
+  template <> struct SimdType<double> { typedef double type; };
+
+  template <int Op, class T, class K>
+  struct Dispatch {
+    static void run (const T* a, const T* b, T* out, int n) {
+      const K* ka = (const K*) a;
+      const K* kb = (const K*) b;
+      K* kout = (K*) out;
+      switch (simdLevel()) {
+        case SIMD_AVX512: Kernel<SIMD_AVX512, Op, K>::run(ka, kb, kout, n); return;
+        case SIMD_AVX2: Kernel<SIMD_AVX2, Op, K>::run(ka, kb, kout, n); return;
+        case SIMD_SSE2: Kernel<SIMD_SSE2, Op, K>::run(ka, kb, kout, n); return;
+        default: Kernel<SIMD_SCALAR, Op, K>::run(ka, kb, kout, n);
+      }
+    }
+    static void runScalar (const T* a, const T& b, T* out, int n) {
+      const K* ka = (const K*) a;
+      K kb = (K) b;
+      K* kout = (K*) out;
+      switch (simdLevel()) {
+        case SIMD_AVX512: Kernel<SIMD_AVX512, Op, K>::runScalar(ka, kb, kout, n); return;
+        case SIMD_AVX2: Kernel<SIMD_AVX2, Op, K>::runScalar(ka, kb, kout, n); return;
+        case SIMD_SSE2: Kernel<SIMD_SSE2, Op, K>::runScalar(ka, kb, kout, n); return;
+        default: Kernel<SIMD_SCALAR, Op, K>::runScalar(ka, kb, kout, n);
+      }
+    }
+  };
+  template <int Op, class T>
+  struct Dispatch<Op, T, void> {
+    static void run (const T* a, const T* b, T* out, int n) { Kernel<SIMD_SCALAR, Op, T>::run(a, b, out, n); }
+    static void runScalar (const T* a, const T& b, T* out, int n) { Kernel<SIMD_SCALAR, Op, T>::runScalar(a, b, out, n); }
+  };
+
+  // `out[i] = a[i] Op b[i]` for `i` in `[0,n)`. `out` may alias `a` or `b`
+  template <int Op, class T>
+  void arith (const T* a, const T* b, T* out, int n) { Dispatch<Op, T, typename SimdType<T>::type>::run(a, b, out, n); }
+  // `out[i] = a[i] Op b` for `i` in `[0,n)`. `out` may alias `a`
+  template <int Op, class T>
+  void arith (const T* a, const T& b, T* out, int n) { Dispatch<Op, T, typename SimdType<T>::type>::runScalar(a, b, out, n); }
+}
+
+/*
+ * Inclusive scans used by `Array::cumsum`, `cumprod`, `cummin` and `cummax`.
+ * SIMD kernels scan a 128-bit register in place (log2(lanes) steps of shifting lanes up and combining),
+ * then combine it with the running carry. The carry is updated from the last lane of the register alone,
+ * so it is the only dependency between consecutive registers. `int32` min, max and product need SSE4.1,
+ * they are used from the AVX2 level up. Other types and operations use the scalar loop
+ */
+namespace array_detail {
+  enum ScanOp { SCAN_SUM, SCAN_PROD, SCAN_MIN, SCAN_MAX };
+
+  // `acc` combined with the next item `x`
+  template <int Op, class T> struct ScanApply;
+  template <class T> struct ScanApply<SCAN_SUM, T> { static T apply (const T& acc, const T& x) { return acc + x; } };
+  template <class T> struct ScanApply<SCAN_PROD, T> { static T apply (const T& acc, const T& x) { return acc * x; } };
+  template <class T> struct ScanApply<SCAN_MIN, T> { static T apply (const T& acc, const T& x) { return x < acc ? x : acc; } };
+  template <class T> struct ScanApply<SCAN_MAX, T> { static T apply (const T& acc, const T& x) { return acc < x ? x : acc; } };
+
+  // `Level` kernel: `out[i] = carry Op in[0] Op ... Op in[i]`, returns the last result. `out` may alias `in`.
+  // Levels without a specialization use the kernel of the level below
+  template <int Level, int Op, class T>
+  struct ScanKernel : ScanKernel<Level - 1, Op, T> {};
+  template <int Op, class T>
+  struct ScanKernel<SIMD_SCALAR, Op, T> {
+    static T run (const T* in, T* out, int n, T carry) {
+      for (int i = 0; i < n; i++) out[i] = carry = ScanApply<Op, T>::apply(carry, in[i]);
+      return carry;
+    }
+  };
+
+#if ARRAY_SIMD_X86
+// `APPLY(acc, x)` has to match `ScanApply`, `SHIFT1` / `SHIFT2` move lanes up by 1 / 2 and fill the lowest ones with
+// the identity (or with copies of lane 0 for min and max, which are idempotent). `LAST` broadcasts the highest lane
+#define ARRAY_SCAN_KERNEL(LEVEL, ISA, T, OP, REG, W, LOAD, STORE, SET1, APPLY, SHIFT1, SHIFT2, LAST) \
+  template <> struct ScanKernel<LEVEL, OP, T> { \
+    ARRAY_TARGET(ISA) static T run (const T* in, T* out, int n, T carry) { \
+      REG c = SET1(carry); \
+      int i = 0; \
+      for (; i + W <= n; i += W) { \
+        REG x = LOAD(in + i); \
+        x = APPLY(SHIFT1(x), x); \
+        x = APPLY(SHIFT2(x), x); \
+        STORE(out + i, APPLY(c, x)); \
+        c = APPLY(c, LAST(x)); \
+      } \
+      T lanes[W]; \
+      STORE(lanes, c); \
+      carry = lanes[0]; \
+      for (; i < n; i++) out[i] = carry = ScanApply<OP, T>::apply(carry, in[i]); \
+      return carry; \
+    } \
+  };
+#define ARRAY_SCAN_PS_SHL1(x) _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4))
+#define ARRAY_SCAN_PS_SHL2(x) _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8))
+#define ARRAY_SCAN_PS_ONE1(x) _mm_move_ss(_mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 1, 0, 0)), _mm_set1_ps(1.0f))
+#define ARRAY_SCAN_PS_ONE2(x) _mm_movelh_ps(_mm_set1_ps(1.0f), x)
+#define ARRAY_SCAN_PS_DUP1(x) _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 1, 0, 0))
+#define ARRAY_SCAN_PS_DUP2(x) _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 1, 0))
+#define ARRAY_SCAN_PS_LAST(x) _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3))
+#define ARRAY_SCAN_PS_MIN(acc, x) _mm_min_ps(x, acc)
+#define ARRAY_SCAN_PS_MAX(acc, x) _mm_max_ps(x, acc)
+#define ARRAY_SCAN_PD_SHL1(x) _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8))
+#define ARRAY_SCAN_PD_ZERO(x) _mm_setzero_pd()
+#define ARRAY_SCAN_PD_ONE1(x) _mm_unpacklo_pd(_mm_set1_pd(1.0), x)
+#define ARRAY_SCAN_PD_ONE(x) _mm_set1_pd(1.0)
+#define ARRAY_SCAN_PD_DUP1(x) _mm_unpacklo_pd(x, x)
+#define ARRAY_SCAN_SAME(x) (x)
+#define ARRAY_SCAN_PD_LAST(x) _mm_unpackhi_pd(x, x)
+#define ARRAY_SCAN_PD_MIN(acc, x) _mm_min_pd(x, acc)
+#define ARRAY_SCAN_PD_MAX(acc, x) _mm_max_pd(x, acc)
+#define ARRAY_SCAN_EPI32_SHL1(x) _mm_slli_si128(x, 4)
+#define ARRAY_SCAN_EPI32_SHL2(x) _mm_slli_si128(x, 8)
+#define ARRAY_SCAN_EPI32_ONE1(x) _mm_or_si128(_mm_slli_si128(x, 4), _mm_setr_epi32(1, 0, 0, 0))
+#define ARRAY_SCAN_EPI32_ONE2(x) _mm_or_si128(_mm_slli_si128(x, 8), _mm_setr_epi32(1, 1, 0, 0))
+#define ARRAY_SCAN_EPI32_DUP1(x) _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 1, 0, 0))
+#define ARRAY_SCAN_EPI32_DUP2(x) _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 1, 0))
+#define ARRAY_SCAN_EPI32_LAST(x) _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3))
+#define ARRAY_SCAN_EPI64_SHL1(x) _mm_slli_si128(x, 8)
+#define ARRAY_SCAN_EPI64_ZERO(x) _mm_setzero_si128()
+#define ARRAY_SCAN_EPI64_LAST(x) _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2))
+
+  ARRAY_SCAN_KERNEL(SIMD_SSE2, "sse2", float, SCAN_SUM, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_add_ps, ARRAY_SCAN_PS_SHL1, ARRAY_SCAN_PS_SHL2, ARRAY_SCAN_PS_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_SSE2, "sse2", float, SCAN_PROD, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_mul_ps, ARRAY_SCAN_PS_ONE1, ARRAY_SCAN_PS_ONE2, ARRAY_SCAN_PS_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_SSE2, "sse2", float, SCAN_MIN, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, ARRAY_SCAN_PS_MIN, ARRAY_SCAN_PS_DUP1, ARRAY_SCAN_PS_DUP2, ARRAY_SCAN_PS_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_SSE2, "sse2", float, SCAN_MAX, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, ARRAY_SCAN_PS_MAX, ARRAY_SCAN_PS_DUP1, ARRAY_SCAN_PS_DUP2, ARRAY_SCAN_PS_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_SSE2, "sse2", double, SCAN_SUM, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_add_pd, ARRAY_SCAN_PD_SHL1, ARRAY_SCAN_PD_ZERO, ARRAY_SCAN_PD_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_SSE2, "sse2", double, SCAN_PROD, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_mul_pd, ARRAY_SCAN_PD_ONE1, ARRAY_SCAN_PD_ONE, ARRAY_SCAN_PD_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_SSE2, "sse2", double, SCAN_MIN, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, ARRAY_SCAN_PD_MIN, ARRAY_SCAN_PD_DUP1, ARRAY_SCAN_SAME, ARRAY_SCAN_PD_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_SSE2, "sse2", double, SCAN_MAX, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, ARRAY_SCAN_PD_MAX, ARRAY_SCAN_PD_DUP1, ARRAY_SCAN_SAME, ARRAY_SCAN_PD_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_SSE2, "sse2", int32_t, SCAN_SUM, __m128i, 4, ARRAY_LOAD_SI128, ARRAY_STORE_SI128, _mm_set1_epi32, _mm_add_epi32, ARRAY_SCAN_EPI32_SHL1, ARRAY_SCAN_EPI32_SHL2, ARRAY_SCAN_EPI32_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_SSE2, "sse2", int64_t, SCAN_SUM, __m128i, 2, ARRAY_LOAD_SI128, ARRAY_STORE_SI128, _mm_set1_epi64x, _mm_add_epi64, ARRAY_SCAN_EPI64_SHL1, ARRAY_SCAN_EPI64_ZERO, ARRAY_SCAN_EPI64_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_AVX2, "sse4.1", int32_t, SCAN_PROD, __m128i, 4, ARRAY_LOAD_SI128, ARRAY_STORE_SI128, _mm_set1_epi32, _mm_mullo_epi32, ARRAY_SCAN_EPI32_ONE1, ARRAY_SCAN_EPI32_ONE2, ARRAY_SCAN_EPI32_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_AVX2, "sse4.1", int32_t, SCAN_MIN, __m128i, 4, ARRAY_LOAD_SI128, ARRAY_STORE_SI128, _mm_set1_epi32, _mm_min_epi32, ARRAY_SCAN_EPI32_DUP1, ARRAY_SCAN_EPI32_DUP2, ARRAY_SCAN_EPI32_LAST)
+  ARRAY_SCAN_KERNEL(SIMD_AVX2, "sse4.1", int32_t, SCAN_MAX, __m128i, 4, ARRAY_LOAD_SI128, ARRAY_STORE_SI128, _mm_set1_epi32, _mm_max_epi32, ARRAY_SCAN_EPI32_DUP1, ARRAY_SCAN_EPI32_DUP2, ARRAY_SCAN_EPI32_LAST)
+#endif
+
+  template <int Op, class T, class K>
+  struct ScanDispatch {
+    static T run (const T* in, T* out, int n, T carry) {
+      const K* kin = (const K*) in;
+      K* kout = (K*) out;
+      switch (simdLevel()) {
+        case SIMD_AVX512: return (T) ScanKernel<SIMD_AVX512, Op, K>::run(kin, kout, n, (K) carry);
+        case SIMD_AVX2: return (T) ScanKernel<SIMD_AVX2, Op, K>::run(kin, kout, n, (K) carry);
+        case SIMD_SSE2: return (T) ScanKernel<SIMD_SSE2, Op, K>::run(kin, kout, n, (K) carry);
+        default: return (T) ScanKernel<SIMD_SCALAR, Op, K>::run(kin, kout, n, (K) carry);
+      }
+    }
+  };
+  template <int Op, class T>
+  struct ScanDispatch<Op, T, void> {
+    static T run (const T* in, T* out, int n, T carry) { return ScanKernel<SIMD_SCALAR, Op, T>::run(in, out, n, carry); }
+  };
+
+  // Inclusive `Op` scan of `in[0,n)` into `out` continuing from `carry`. Returns the last result. `out` may alias `in`
+  template <int Op, class T>
+  T scan (const T* in, T* out, int n, const T& carry) { return ScanDispatch<Op, T, typename SimdType<T>::type>::run(in, out, n, carry); }
+  // Inclusive `Op` scan of `in[0,n)` into `out` (`n > 0`). Returns the last result. `out` may alias `in`
+  template <int Op, class T>
+  T scan (const T* in, T* out, int n) {
+    out[0] = in[0];
+    return scan<Op>(in + 1, out + 1, n - 1, out[0]);
+  }
+  // `in[0] Op ... Op in[n-1]` (`n > 0`) with 4 independent accumulators
+  template <int Op, class T>
+  T scanReduce (const T* in, int n) {
+    if (n < 4) {
+      T acc = in[0];
+      for (int i = 1; i < n; i++) acc = ScanApply<Op, T>::apply(acc, in[i]);
+      return acc;
+    }
+    T acc[4] = { in[0], in[1], in[2], in[3] };
+    int i = 4;
+    for (; i + 4 <= n; i += 4) {
+      for (int k = 0; k < 4; k++) acc[k] = ScanApply<Op, T>::apply(acc[k], in[i + k]);
+    }
+    for (; i < n; i++) acc[0] = ScanApply<Op, T>::apply(acc[0], in[i]);
+    return ScanApply<Op, T>::apply(ScanApply<Op, T>::apply(acc[0], acc[1]), ScanApply<Op, T>::apply(acc[2], acc[3]));
+  }
+}
+
+/*
+ * Binary format used by `Array::save`, `Array::load`, `ArrayWriter` and `ArrayReader`.
+ * 32-byte header (little endian fields) followed by `count` raw elements:
+ *   0: magic "DNGA", 4: version (u16), 6: element kind (u8), 7: payload byte order (u8, 0 - little, 1 - big),
+ *   8: element size (u32), 12: flags (u32, reserved), 16: element count (u64), 24: payload checksum (u64)
+ */
+namespace array_detail {
+  const uint16_t FORMAT_VERSION = 1;
+  const int FORMAT_HEADER_SIZE = 32;
+  enum TypeKindTag { KIND_RAW = 0, KIND_BOOL = 1, KIND_CHAR = 2, KIND_SIGNED = 3, KIND_UNSIGNED = 4, KIND_FLOAT = 5 };
+  // Element kind stored in the header. Files are compatible between types of the same kind and size
+  template <class T>
+  struct TypeKind {
+    static const uint8_t value =
+      std::is_same<T, bool>::value ? KIND_BOOL :
+      std::is_same<T, char>::value ? KIND_CHAR :
+      std::is_floating_point<T>::value ? KIND_FLOAT :
+      std::is_integral<T>::value ? (std::is_signed<T>::value ? KIND_SIGNED : KIND_UNSIGNED) : KIND_RAW;
+  };
+  inline bool bigEndianHost () {
+    uint16_t x = 1;
+    unsigned char b;
+    memcpy(&b, &x, 1);
+    return b == 0;
+  }
+  inline uint64_t byteSwap64 (uint64_t x) {
+    x = ((x & 0x00FF00FF00FF00FFULL) << 8) | ((x >> 8) & 0x00FF00FF00FF00FFULL);
+    x = ((x & 0x0000FFFF0000FFFFULL) << 16) | ((x >> 16) & 0x0000FFFF0000FFFFULL);
+    return (x << 32) | (x >> 32);
+  }
+  // Reverse byte order of `n` elements of `size` bytes in place
+  inline void byteSwap (void* data, size_t n, size_t size) {
+    unsigned char* p = (unsigned char*) data;
+    for (size_t i = 0; i < n; i++, p += size) {
+      for (size_t l = 0, r = size - 1; l < r; l++, r--) {
+        unsigned char t = p[l];
+        p[l] = p[r];
+        p[r] = t;
+      }
+    }
+  }
+  inline void putLE (unsigned char* p, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) p[i] = (unsigned char) (v >> (8 * i));
+  }
+  inline uint64_t getLE (const unsigned char* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v |= (uint64_t) p[i] << (8 * i);
+    return v;
+  }
+  // Streaming 64-bit checksum of a byte sequence. Four independent multiply-xor lanes over little endian 8-byte words,
+  // so the result only depends on the bytes, not on how they were split into `update` calls
+  class Checksum {
+    private:
+      static const uint64_t P1 = 0x9E3779B185EBCA87ULL;
+      static const uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+      uint64_t lanes[4];
+      unsigned char tail[32];
+      size_t tailLen;
+      uint64_t total;
+      static uint64_t word (const unsigned char* p) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        return bigEndianHost() ? byteSwap64(w) : w;
+      }
+      void block (const unsigned char* p) {
+        for (int k = 0; k < 4; k++) {
+          uint64_t h = (this->lanes[k] ^ word(p + 8 * k)) * P1;
+          this->lanes[k] = (h << 31) | (h >> 33);
+        }
+      }
+    public:
+      Checksum () : tailLen(0), total(0) {
+        for (int k = 0; k < 4; k++) this->lanes[k] = P2 + k;
+      }
+      void update (const void* data, size_t bytes) {
+        const unsigned char* p = (const unsigned char*) data;
+        this->total += bytes;
+        if (this->tailLen > 0) {
+          size_t take = 32 - this->tailLen < bytes ? 32 - this->tailLen : bytes;
+          memcpy(this->tail + this->tailLen, p, take);
+          this->tailLen += take;
+          p += take;
+          bytes -= take;
+          if (this->tailLen < 32) return;
+          this->block(this->tail);
+          this->tailLen = 0;
+        }
+        for (; bytes >= 32; p += 32, bytes -= 32) this->block(p);
+        memcpy(this->tail, p, bytes);
+        this->tailLen = bytes;
+      }
+      uint64_t digest () const {
+        Checksum c = *this;
+        if (c.tailLen > 0) {
+          memset(c.tail + c.tailLen, 0, 32 - c.tailLen);
+          c.block(c.tail);
+        }
+        uint64_t h = c.total * P2;
+        for (int k = 0; k < 4; k++) {
+          h = (h ^ c.lanes[k]) * P1;
+          h ^= h >> 29;
+        }
+        return h;
+      }
+  };
+}
+
+/*
+ * Bit helpers used by packed `Array<bool>`
+ */
+namespace array_detail {
+  // Number of set bits
+  inline int popcount64 (uint64_t w) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(w);
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int) ((w * 0x0101010101010101ULL) >> 56);
+#endif
+  }
+  // Index of the lowest set bit (`w` must not be `0`)
+  inline int ctz64 (uint64_t w) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(w);
+#else
+    int n = 0;
+    while ((w & 1) == 0) {
+      w >>= 1;
+      n++;
+    }
+    return n;
+#endif
+  }
+}
+
+/*
+ * Stream compaction used by `Array::compress` and `Array::where`. The packed mask is read 64 elements at a time:
+ * all-`true` words are copied as a block, all-`false` words skipped, mixed words go through AVX-512 compress stores
+ * or AVX2 permutation tables (4 and 8-byte elements) or a bit-scan loop. Output is written into a single pre-sized buffer
+ */
+namespace array_detail {
+  // Compaction kernel element type for `T`: raw 32/64-bit words for trivially copyable `T`. `void` = bit-scan loop only
+  template <class T, class Enable = void>
+  struct CompressType { typedef void type; };
+  template <class T>
+  struct CompressType<T, typename std::enable_if<std::is_trivially_copyable<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)>::type> {
+    typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type type;
+  };
+
+  // Copy `a[i]` for every set bit `i` of `w` to `out`. Returns number of copied elements
+  template <class T>
+  int compressScan (const T* a, uint64_t w, T* out) {
+    int k = 0;
+    while (w != 0) {
+      out[k++] = a[ctz64(w)];
+      w &= w - 1;
+    }
+    return k;
+  }
+
+  // `Level` kernel compacting 64 elements of `a` selected by mixed mask word `w` into `out`, which has room for `room` elements
+  template <int Level, class K>
+  struct CompressKernel {
+    static int block (const K* a, uint64_t w, K* out, int room) {
+      (void) room;
+      return compressScan(a, w, out);
+    }
+  };
+
+#if ARRAY_SIMD_X86
+  // AVX2 permutation tables. Entry `m` lists source 32-bit lanes of the set bits of `m` (4 bits per lane index)
+  struct CompressTables {
+    uint32_t lanes32[256];  // 8 x 32-bit elements
+    uint32_t lanes64[16];   // 4 x 64-bit elements (each one is a pair of 32-bit lanes)
+    CompressTables () {
+      for (int m = 0; m < 256; m++) {
+        uint32_t p = 0;
+        for (int i = 0, k = 0; i < 8; i++) if ((m >> i) & 1) p |= (uint32_t) i << (4 * k++);
+        lanes32[m] = p;
+      }
+      for (int m = 0; m < 16; m++) {
+        uint32_t p = 0;
+        for (int i = 0, k = 0; i < 4; i++) {
+          if (((m >> i) & 1) == 0) continue;
+          p |= (uint32_t) (2 * i) << (4 * k++);
+          p |= (uint32_t) (2 * i + 1) << (4 * k++);
+        }
+        lanes64[m] = p;
+      }
+    }
+  };
+  inline const CompressTables& compressTables () {
+    static const CompressTables tables;
+    return tables;
+  }
+
+  // AVX2: full 8-lane store of the permuted vector, so it needs 8 free elements in `out` (bit-scan otherwise)
+  template <> struct CompressKernel<SIMD_AVX2, uint32_t> {
+    ARRAY_TARGET("avx2,popcnt") static int block (const uint32_t* a, uint64_t w, uint32_t* out, int room) {
+      const CompressTables &t = compressTables();
+      const __m256i shifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+      const __m256i nibble = _mm256_set1_epi32(15);
+      int k = 0;
+      for (int i = 0; i < 64; i += 8) {
+        unsigned m = (unsigned) (w >> i) & 0xFF;
+        if (m == 0) continue;
+        if (room - k < 8) {
+          k += compressScan(a + i, (uint64_t) m, out + k);
+          continue;
+        }
+        __m256i lanes = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32((int) t.lanes32[m]), shifts), nibble);
+        ARRAY_STORE_SI256(out + k, _mm256_permutevar8x32_epi32(ARRAY_LOAD_SI256(a + i), lanes));
+        k += popcount64(m);
+      }
+      return k;
+    }
+  };
+  template <> struct CompressKernel<SIMD_AVX2, uint64_t> {
+    ARRAY_TARGET("avx2,popcnt") static int block (const uint64_t* a, uint64_t w, uint64_t* out, int room) {
+      const CompressTables &t = compressTables();
+      const __m256i shifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+      const __m256i nibble = _mm256_set1_epi32(15);
+      int k = 0;
+      for (int i = 0; i < 64; i += 4) {
+        unsigned m = (unsigned) (w >> i) & 0xF;
+        if (m == 0) continue;
+        if (room - k < 4) {
+          k += compressScan(a + i, (uint64_t) m, out + k);
+          continue;
+        }
+        __m256i lanes = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32((int) t.lanes64[m]), shifts), nibble);
+        ARRAY_STORE_SI256(out + k, _mm256_permutevar8x32_epi32(ARRAY_LOAD_SI256(a + i), lanes));
+        k += popcount64(m);
+      }
+      return k;
+    }
+  };
+  // AVX-512 Foundation: masked compress stores never write past the selected elements
+  template <> struct CompressKernel<SIMD_AVX512, uint32_t> {
+    ARRAY_TARGET("avx512f,popcnt") static int block (const uint32_t* a, uint64_t w, uint32_t* out, int room) {
+      (void) room;
+      int k = 0;
+      for (int i = 0; i < 64; i += 16) {
+        __mmask16 m = (__mmask16) (w >> i);
+        if (m == 0) continue;
+        _mm512_mask_compressstoreu_epi32(out + k, m, ARRAY_LOAD_SI512(a + i));
+        k += popcount64(m);
+      }
+      return k;
+    }
+  };
+  template <> struct CompressKernel<SIMD_AVX512, uint64_t> {
+    ARRAY_TARGET("avx512f,popcnt") static int block (const uint64_t* a, uint64_t w, uint64_t* out, int room) {
+      (void) room;
+      int k = 0;
+      for (int i = 0; i < 64; i += 8) {
+        __mmask8 m = (__mmask8) (w >> i);
+        if (m == 0) continue;
+        _mm512_mask_compressstoreu_epi64(out + k, m, ARRAY_LOAD_SI512(a + i));
+        k += popcount64(m);
+      }
+      return k;
+    }
+  };
+#endif
+
+  // Compact `a[0..n)` by packed `mask` into `out`, which holds exactly `total` (number of set mask bits) elements
+  template <int Level, class K>
+  int compressRun (const K* a, const uint64_t* mask, int n, K* out, int total) {
+    int k = 0, full = n >> 6;
+    for (int j = 0; j < full; j++) {
+      uint64_t w = mask[j];
+      const K* src = a + ((long long) j << 6);
+      if (w == 0) continue;
+      if (w == ~(uint64_t) 0) {
+        for (int i = 0; i < 64; i++) out[k + i] = src[i];
+        k += 64;
+        continue;
+      }
+      k += CompressKernel<Level, K>::block(src, w, out + k, total - k);
+    }
+    if (n & 63) k += compressScan(a + ((long long) full << 6), mask[full] & (((uint64_t) 1 << (n & 63)) - 1), out + k);
+    return k;
+  }
+  template <class T, class K>
+  struct CompressDispatch {
+    static int run (const T* a, const uint64_t* mask, int n, T* out, int total) {
+      const K* ka = (const K*) a;
+      K* kout = (K*) out;
+      switch (simdLevel()) {
+        case SIMD_AVX512: return compressRun<SIMD_AVX512, K>(ka, mask, n, kout, total);
+        case SIMD_AVX2: return compressRun<SIMD_AVX2, K>(ka, mask, n, kout, total);
+        default: return compressRun<SIMD_SCALAR, K>(ka, mask, n, kout, total);
+      }
+    }
+  };
+  template <class T>
+  struct CompressDispatch<T, void> {
+    static int run (const T* a, const uint64_t* mask, int n, T* out, int total) { return compressRun<SIMD_SCALAR, T>(a, mask, n, out, total); }
+  };
+
+  // `out` = `a[i]` for set bits `i` of packed `mask` (`n` elements), `total` = number of set bits. Returns `total`
+  template <class T>
+  int compress (const T* a, const uint64_t* mask, int n, T* out, int total) {
+    return CompressDispatch<T, typename CompressType<T>::type>::run(a, mask, n, out, total);
+  }
+  // `out` = indices of set bits of packed `mask` (`n` elements)
+  inline int maskIndices (const uint64_t* mask, int n, int* out) {
+    int k = 0;
+    for (int j = 0; j < ((n + 63) >> 6); j++) {
+      uint64_t w = mask[j];
+      if ((j << 6) + 64 > n) w &= ((uint64_t) 1 << (n & 63)) - 1;
+      while (w != 0) {
+        out[k++] = (j << 6) + ctz64(w);
+        w &= w - 1;
+      }
+    }
+    return k;
+  }
+}
+
+/*
+ * Subsequence search used by `Array::find`, `count`, `findAll` and `contains` with a pattern. Linear in the worst case:
+ *   - integer / floating point elements: SIMD scan for positions matching the first and the last pattern element,
+ *     candidates verified element by element. Patterns longer than `ARRAY_SEARCH_SHORT` switch to Knuth-Morris-Pratt
+ *     when verification stops paying off (periodic data)
+ *   - long patterns (`ARRAY_SEARCH_LONG`) with many distinct elements over ranges that fit in cache: Boyer-Moore-Horspool
+ *     (bad element shifts over 256 hashed buckets), with the same fallback. On larger ranges its skips are bound by memory
+ *     latency and the streaming scan is faster
+ *   - other element types: Knuth-Morris-Pratt
+ */
+#ifndef ARRAY_SEARCH_SHORT
+#define ARRAY_SEARCH_SHORT 16
+#endif
+#ifndef ARRAY_SEARCH_LONG
+#define ARRAY_SEARCH_LONG 64
+#endif
+#ifndef ARRAY_SEARCH_CACHE
+#define ARRAY_SEARCH_CACHE (1024 * 1024)
+#endif
+namespace array_detail {
+  // Equality scan element type for `T`: same-size integers, `float` and `double`. `void` = no SIMD scan
+  template <class T, class Enable = void>
+  struct EqualType { typedef void type; };
+  template <class T>
+  struct EqualType<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+    typedef typename std::conditional<sizeof(T) == 1, int8_t,
+      typename std::conditional<sizeof(T) == 2, int16_t,
+      typename std::conditional<sizeof(T) == 4, int32_t, int64_t>::type>::type>::type type;
+  };
+  template <> struct EqualType<float> { typedef float type; };
+  template <> struct EqualType<double> { typedef double type; };
+
+  // `Level` kernel: first `i` in `[0,n)` with `a[i] == first` and `a[i + lastOffset] == last`, `-1` if none
+  template <int Level, class K>
+  struct EqualScan {
+    static int run (const K* a, int n, K first, K last, int lastOffset) {
+      for (int i = 0; i < n; i++) if (a[i] == first && a[i + lastOffset] == last) return i;
+      return -1;
+    }
+  };
+#if ARRAY_SIMD_X86
+  // `BITS` = movemask bits per lane
+#define ARRAY_EQUAL_SCAN(LEVEL, ISA, K, W, REG, LOAD, SET1, CMPEQ, AND, MOVEMASK, BITS) \
+  template <> struct EqualScan<LEVEL, K> { \
+    ARRAY_TARGET(ISA) static int run (const K* a, int n, K first, K last, int lastOffset) { \
+      REG vf = SET1(first), vl = SET1(last); \
+      int i = 0; \
+      for (; i + W <= n; i += W) { \
+        unsigned bits = (unsigned) MOVEMASK(AND(CMPEQ(LOAD(a + i), vf), CMPEQ(LOAD(a + i + lastOffset), vl))); \
+        if (bits != 0) return i + __builtin_ctz(bits) / BITS; \
+      } \
+      for (; i < n; i++) if (a[i] == first && a[i + lastOffset] == last) return i; \
+      return -1; \
+    } \
+  };
+#define ARRAY_CMPEQ_PS256(a, b) _mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+#define ARRAY_CMPEQ_PD256(a, b) _mm256_cmp_pd(a, b, _CMP_EQ_OQ)
+
+  // SSE2 (no 64-bit integer compare before SSE4.1)
+  ARRAY_EQUAL_SCAN(SIMD_SSE2, "sse2", int8_t, 16, __m128i, ARRAY_LOAD_SI128, _mm_set1_epi8, _mm_cmpeq_epi8, _mm_and_si128, _mm_movemask_epi8, 1)
+  ARRAY_EQUAL_SCAN(SIMD_SSE2, "sse2", int16_t, 8, __m128i, ARRAY_LOAD_SI128, _mm_set1_epi16, _mm_cmpeq_epi16, _mm_and_si128, _mm_movemask_epi8, 2)
+  ARRAY_EQUAL_SCAN(SIMD_SSE2, "sse2", int32_t, 4, __m128i, ARRAY_LOAD_SI128, _mm_set1_epi32, _mm_cmpeq_epi32, _mm_and_si128, _mm_movemask_epi8, 4)
+  ARRAY_EQUAL_SCAN(SIMD_SSE2, "sse2", float, 4, __m128, _mm_loadu_ps, _mm_set1_ps, _mm_cmpeq_ps, _mm_and_ps, _mm_movemask_ps, 1)
+  ARRAY_EQUAL_SCAN(SIMD_SSE2, "sse2", double, 2, __m128d, _mm_loadu_pd, _mm_set1_pd, _mm_cmpeq_pd, _mm_and_pd, _mm_movemask_pd, 1)
+  // AVX2 (also used at AVX-512 level, the scan is bound by memory bandwidth)
+  ARRAY_EQUAL_SCAN(SIMD_AVX2, "avx2", int8_t, 32, __m256i, ARRAY_LOAD_SI256, _mm256_set1_epi8, _mm256_cmpeq_epi8, _mm256_and_si256, _mm256_movemask_epi8, 1)
+  ARRAY_EQUAL_SCAN(SIMD_AVX2, "avx2", int16_t, 16, __m256i, ARRAY_LOAD_SI256, _mm256_set1_epi16, _mm256_cmpeq_epi16, _mm256_and_si256, _mm256_movemask_epi8, 2)
+  ARRAY_EQUAL_SCAN(SIMD_AVX2, "avx2", int32_t, 8, __m256i, ARRAY_LOAD_SI256, _mm256_set1_epi32, _mm256_cmpeq_epi32, _mm256_and_si256, _mm256_movemask_epi8, 4)
+  ARRAY_EQUAL_SCAN(SIMD_AVX2, "avx2", int64_t, 4, __m256i, ARRAY_LOAD_SI256, _mm256_set1_epi64x, _mm256_cmpeq_epi64, _mm256_and_si256, _mm256_movemask_epi8, 8)
+  ARRAY_EQUAL_SCAN(SIMD_AVX2, "avx2", float, 8, __m256, _mm256_loadu_ps, _mm256_set1_ps, ARRAY_CMPEQ_PS256, _mm256_and_ps, _mm256_movemask_ps, 1)
+  ARRAY_EQUAL_SCAN(SIMD_AVX2, "avx2", double, 4, __m256d, _mm256_loadu_pd, _mm256_set1_pd, ARRAY_CMPEQ_PD256, _mm256_and_pd, _mm256_movemask_pd, 1)
+#endif
+
+  // First `i` in `[0,n)` with `a[i] == first` and `a[i + lastOffset] == last`, `-1` if none (`K` = `EqualType<T>::type`)
+  template <class T, class K>
+  int equalScan (const T* a, int n, const T& first, const T& last, int lastOffset) {
+    const K* ka = (const K*) a;
+    K kf, kl;
+    memcpy(&kf, &first, sizeof(K));
+    memcpy(&kl, &last, sizeof(K));
+    switch (simdLevel()) {
+      case SIMD_AVX512:
+      case SIMD_AVX2: return EqualScan<SIMD_AVX2, K>::run(ka, n, kf, kl, lastOffset);
+      case SIMD_SSE2: return EqualScan<SIMD_SSE2, K>::run(ka, n, kf, kl, lastOffset);
+      default: return EqualScan<SIMD_SCALAR, K>::run(ka, n, kf, kl, lastOffset);
+    }
+  }
+
+  // Horspool bucket of `x`. Equal elements share a bucket (`+0.0` and `-0.0` included)
+  template <class T>
+  unsigned searchBucket (const T& x, std::true_type) { return (unsigned) (((uint64_t) x * 0x9E3779B97F4A7C15ULL) >> 56); }
+  template <class T>
+  unsigned searchBucket (const T& x, std::false_type) {
+    uint64_t h = 0;
+    if (x != 0) memcpy(&h, &x, sizeof(T));
+    return (unsigned) ((h * 0x9E3779B97F4A7C15ULL) >> 56);
+  }
+
+  // Search engine for single pattern `p` of `m` (> 0) elements. Pattern must outlive the engine
+  template <class T>
+  class PatternSearch {
+    private:
+      typedef typename EqualType<T>::type K;
+      const T* p;
+      int m;
+      std::vector<int> fail;  // KMP failure function (built on first use)
+      int shift[256];         // Horspool shifts per bucket (built with the engine for long patterns)
+      bool horspool;
+      void buildFail () {
+        this->fail.assign(this->m, 0);
+        for (int q = 1, k = 0; q < this->m; q++) {
+          while (k > 0 && !(this->p[q] == this->p[k])) k = this->fail[k - 1];
+          if (this->p[q] == this->p[k]) k++;
+          this->fail[q] = k;
+        }
+      }
+      int kmp (const T* a, int from, int end) {
+        if ((int) this->fail.size() != this->m) this->buildFail();
+        int q = 0;
+        for (int i = from; i < end; i++) {
+          while (q > 0 && !(a[i] == this->p[q])) q = this->fail[q - 1];
+          if (a[i] == this->p[q]) q++;
+          if (q == this->m) return i - this->m + 1;
+        }
+        return -1;
+      }
+      // First + last element SIMD scan. Verification work above a linear budget hands over to KMP
+      int scan (const T* a, int from, int end, std::true_type) {
+        int last = end - this->m;
+        long long work = 0;
+        for (int i = from; i <= last; i++) {
+          int c = equalScan<T, K>(a + i, last - i + 1, this->p[0], this->p[this->m - 1], this->m - 1);
+          if (c < 0) return -1;
+          i += c;
+          int j = 1;
+          while (j < this->m - 1 && a[i + j] == this->p[j]) j++;
+          if (j >= this->m - 1) return i;
+          work += j;
+          if (this->m > ARRAY_SEARCH_SHORT && work > 4LL * (i - from) + 4LL * this->m) return this->kmp(a, i + 1, end);
+        }
+        return -1;
+      }
+      int scan (const T* a, int from, int end, std::false_type) { return this->kmp(a, from, end); }
+      int horspoolScan (const T* a, int from, int end, std::true_type) {
+        std::integral_constant<bool, std::is_integral<T>::value> integral;
+        const T& tail = this->p[this->m - 1];
+        long long work = 0;
+        int i = from;
+        while (i <= end - this->m) {
+          const T& x = a[i + this->m - 1];
+          if (x == tail) {
+            int j = this->m - 2;
+            while (j >= 0 && a[i + j] == this->p[j]) j--;
+            if (j < 0) return i;
+            work += this->m - 1 - j;
+          }
+          i += this->shift[searchBucket(x, integral)];
+          if (++work > 4LL * (i - from) + 4LL * this->m) return this->kmp(a, i, end);
+        }
+        return -1;
+      }
+      int horspoolScan (const T* a, int from, int end, std::false_type) { return this->kmp(a, from, end); }
+      void buildShift (std::true_type) {
+        std::integral_constant<bool, std::is_integral<T>::value> integral;
+        for (int b = 0; b < 256; b++) this->shift[b] = this->m;
+        int distinct = 0;
+        for (int j = 0; j < this->m - 1; j++) {
+          unsigned b = searchBucket(this->p[j], integral);
+          if (this->shift[b] == this->m) distinct++;
+          this->shift[b] = this->m - 1 - j;
+        }
+        // Few distinct elements mean short skips, the scan is faster then
+        this->horspool = distinct >= 32;
+      }
+      void buildShift (std::false_type) {}
+    public:
+      PatternSearch (const T* p, int m) : p(p), m(m), horspool(false) {
+        if (m >= ARRAY_SEARCH_LONG) this->buildShift(std::integral_constant<bool, !std::is_void<K>::value>());
+      }
+      // Start of the first occurrence of the pattern inside `a[from..end)`, `-1` if none
+      int next (const T* a, int from, int end) {
+        std::integral_constant<bool, !std::is_void<K>::value> scannable;
+        if (end - from < this->m) return -1;
+        if (this->horspool && (long long) (end - from) * sizeof(T) <= ARRAY_SEARCH_CACHE) return this->horspoolScan(a, from, end, scannable);
+        return this->scan(a, from, end, scannable);
+      }
+  };
+}
+
+/*
+ * Hashing used by `Array::unique`, `Array::uniqueCounts` and `Array::uniqueInverse`
+ */
+namespace array_detail {
+  // MurmurHash3 finalizer, spreads weak hashes (`std::hash` of integers is the identity) over all bits
+  inline uint64_t mixHash (uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+  template <class T>
+  inline uint64_t hashOf (const T& x) { return mixHash((uint64_t) std::hash<T>()(x)); }
+
+  // Slot of the `groupEqual` hash table, `group < 0` marks an empty slot
+  struct GroupSlot {
+    uint32_t tag;  // Low half of the element hash, enough to place the slot again when the table grows
+    int group;
+  };
+
+  /**
+   * @brief Group equal elements of `a[0..n)` using an open-addressing hash table (linear probing, load factor up to 1/2).
+   * Groups are numbered in order of their first occurrence
+   * @param first Set to index of the first element of each group
+   * @param inverse Optional, set to group of each element
+   * @param counts Optional, set to number of elements in each group
+   * @return int - Number of groups
+   */
+  template <class T>
+  int groupEqual (const T* a, int n, std::vector<int> &first, int* inverse, std::vector<int>* counts) {
+    first.clear();
+    if (counts != nullptr) counts->clear();
+    GroupSlot empty = { 0, -1 };
+    size_t mask = 15;
+    std::vector<GroupSlot> slots(mask + 1, empty);
+    for (int i = 0; i < n; i++) {
+      uint64_t h = hashOf(a[i]);
+      uint32_t tag = (uint32_t) h;
+      size_t s = (size_t) tag & mask;
+      int g;
+      while ((g = slots[s].group) >= 0 && !(slots[s].tag == tag && a[first[g]] == a[i])) s = (s + 1) & mask;
+      if (g < 0) {
+        g = (int) first.size();
+        first.push_back(i);
+        if (counts != nullptr) counts->push_back(0);
+        slots[s].tag = tag;
+        slots[s].group = g;
+        if (first.size() * 2 > mask + 1) {
+          std::vector<GroupSlot> old(mask * 2 + 2, empty);
+          old.swap(slots);
+          mask = mask * 2 + 1;
+          for (size_t k = 0; k < old.size(); k++) {
+            if (old[k].group < 0) continue;
+            size_t t = (size_t) old[k].tag & mask;
+            while (slots[t].group >= 0) t = (t + 1) & mask;
+            slots[t] = old[k];
+          }
+        }
+      }
+      if (inverse != nullptr) inverse[i] = g;
+      if (counts != nullptr) (*counts)[g]++;
+    }
+    return (int) first.size();
+  }
+
+  // Group of `groupEqual` with its value, ordered by value
+  template <class T>
+  struct GroupEntry {
+    T value;
+    int group;
+    bool operator< (const GroupEntry &other) const { return this->value < other.value; }
+  };
+
+  // Rank of each group of `groupEqual` in ascending order of values
+  template <class T>
+  std::vector<int> groupRanks (const T* a, const std::vector<int> &first) {
+    int groups = (int) first.size();
+    std::vector<GroupEntry<T>> order(groups);
+    std::vector<int> rank(groups);
+    for (int g = 0; g < groups; g++) {
+      order[g].value = a[first[g]];
+      order[g].group = g;
+    }
+    if (groups > 0) introSort(&order[0], groups, Ascending<GroupEntry<T>>());
+    for (int r = 0; r < groups; r++) rank[order[r].group] = r;
+    return rank;
+  }
+}
+
+/*
+ * Set operations used by `Array::setUnion`, `setIntersection`, `setDifference` and `setSymmetricDifference`.
+ * Results hold distinct items. Sorted inputs (ascending, duplicates allowed) are combined in one merge walk:
+ *   - intersection and difference of sizes more than `ARRAY_SET_GALLOP` times apart look the items of the smaller
+ *     input up in the larger one by galloping (exponential) search, O(n log(m / n)) instead of O(n + m)
+ *   - intersection of 32-bit integers compares blocks of 4 (SSE2) or 8 (AVX2) items of each input against each other
+ *     and advances the block with the smaller last item, without a branch per item
+ * Unsorted inputs can use an open-addressing hash set instead of sorting (`HashedSet`)
+ */
+#ifndef ARRAY_SET_GALLOP
+#define ARRAY_SET_GALLOP 32
+#endif
+namespace array_detail {
+  enum SetOp { SET_UNION, SET_INTERSECTION, SET_DIFFERENCE, SET_SYMMETRIC };
+
+  // First index in `[lo,n)` of ascending `a` whose item is not less than `x`: steps of doubling length from `lo`,
+  // then binary search inside the last step
+  template <class T>
+  int gallop (const T* a, int lo, int n, const T& x) {
+    int hi = lo;
+    for (int step = 1; hi < n && a[hi] < x; step <<= 1) {
+      lo = hi + 1;
+      hi = (n - hi > step ? hi + step : n);
+    }
+    return lowerBound(a, lo, hi, x, Ascending<T>());
+  }
+
+  // Distinct items of small ascending `a` found (`keepFound`) or not found in large ascending `b`
+  template <class T>
+  int gallopFilter (const T* a, int n, const T* b, int m, T* out, bool keepFound) {
+    int j = 0, k = 0;
+    for (int i = 0; i < n;) {
+      const T x = a[i];
+      j = gallop(b, j, m, x);
+      if ((j < m && b[j] == x) == keepFound) out[k++] = x;
+      do i++; while (i < n && a[i] == x);
+    }
+    return k;
+  }
+
+  // Merge walk intersection of ascending `a[i..n)` and `b[j..m)`, appended to `out[0..k)` unless equal to its last item
+  template <class T>
+  int intersectMerge (const T* a, int i, int n, const T* b, int j, int m, T* out, int k) {
+    while (i < n && j < m) {
+      if (a[i] < b[j]) i++;
+      else if (b[j] < a[i]) j++;
+      else {
+        if (k == 0 || !(out[k - 1] == a[i])) out[k++] = a[i];
+        i++;
+        j++;
+      }
+    }
+    return k;
+  }
+
+  // `Level` kernel: distinct items of ascending 32-bit integers `a` and `b` present in both
+  template <int Level>
+  struct IntersectKernel {
+    template <class K>
+    static int run (const K* a, int n, const K* b, int m, K* out) { return intersectMerge(a, 0, n, b, 0, m, out, 0); }
+  };
+#if ARRAY_SIMD_X86
+  // Matched lanes of a block of `a` are written in order, skipping repeats of the last written item. Blocks of `a`
+  // meet blocks of `b` in ascending order of their last items, so the output stays ascending and distinct
+  template <> struct IntersectKernel<SIMD_SSE2> {
+    template <class K>
+    ARRAY_TARGET("sse2") static int run (const K* a, int n, const K* b, int m, K* out) {
+      int i = 0, j = 0, k = 0;
+      while (i + 4 <= n && j + 4 <= m) {
+        __m128i va = ARRAY_LOAD_SI128(a + i), vb = ARRAY_LOAD_SI128(b + j);
+        __m128i eq = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+          _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                       _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        for (unsigned bits = (unsigned) _mm_movemask_ps(_mm_castsi128_ps(eq)); bits != 0; bits &= bits - 1) {
+          K x = a[i + __builtin_ctz(bits)];
+          if (k == 0 || out[k - 1] != x) out[k++] = x;
+        }
+        K lastA = a[i + 3], lastB = b[j + 3];
+        if (lastA <= lastB) i += 4;
+        if (lastB <= lastA) j += 4;
+      }
+      return intersectMerge(a, i, n, b, j, m, out, k);
+    }
+  };
+  // AVX2 (also used at AVX-512 level): 8 x 8 items, `b` rotated inside 128-bit lanes and with its lanes swapped
+  template <> struct IntersectKernel<SIMD_AVX2> {
+    template <class K>
+    ARRAY_TARGET("avx2") static int run (const K* a, int n, const K* b, int m, K* out) {
+      int i = 0, j = 0, k = 0;
+      while (i + 8 <= n && j + 8 <= m) {
+        __m256i va = ARRAY_LOAD_SI256(a + i), vb = ARRAY_LOAD_SI256(b + j);
+        __m256i vs = _mm256_permute2x128_si256(vb, vb, 1);
+        __m256i eq = _mm256_or_si256(
+          _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi32(va, vb), _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                            _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))))),
+          _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi32(va, vs), _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, _MM_SHUFFLE(1, 0, 3, 2))),
+                            _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, _MM_SHUFFLE(2, 1, 0, 3))))));
+        for (unsigned bits = (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(eq)); bits != 0; bits &= bits - 1) {
+          K x = a[i + __builtin_ctz(bits)];
+          if (k == 0 || out[k - 1] != x) out[k++] = x;
+        }
+        K lastA = a[i + 7], lastB = b[j + 7];
+        if (lastA <= lastB) i += 8;
+        if (lastB <= lastA) j += 8;
+      }
+      return intersectMerge(a, i, n, b, j, m, out, k);
+    }
+  };
+#endif
+
+  // Intersection of ascending `a` and `b`, block kernels for 32-bit integers
+  template <class T>
+  int intersectSorted (const T* a, int n, const T* b, int m, T* out, std::false_type) {
+    return intersectMerge(a, 0, n, b, 0, m, out, 0);
+  }
+  template <class T>
+  int intersectSorted (const T* a, int n, const T* b, int m, T* out, std::true_type) {
+    switch (simdLevel()) {
+      case SIMD_AVX512:
+      case SIMD_AVX2: return IntersectKernel<SIMD_AVX2>::run(a, n, b, m, out);
+      case SIMD_SSE2: return IntersectKernel<SIMD_SSE2>::run(a, n, b, m, out);
+      default: return IntersectKernel<SIMD_SCALAR>::run(a, n, b, m, out);
+    }
+  }
+
+  /**
+   * @brief Set operation `op` of ascending `a[0..n)` and `b[0..m)` (duplicates allowed)
+   * @param out Room for `n + m` (union, symmetric difference), `min(n, m)` (intersection) or `n` (difference) items
+   * @return int - Number of distinct, ascending items written to `out`
+   */
+  template <class T>
+  int setMerge (const T* a, int n, const T* b, int m, T* out, SetOp op) {
+    if (op == SET_INTERSECTION) {
+      if (n > m) {
+        std::swap(a, b);
+        std::swap(n, m);
+      }
+      if ((long long) n * ARRAY_SET_GALLOP < m) return gallopFilter(a, n, b, m, out, true);
+      return intersectSorted(a, n, b, m, out, std::integral_constant<bool,
+        std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) == 4>());
+    }
+    if (op == SET_DIFFERENCE && (long long) n * ARRAY_SET_GALLOP < m) return gallopFilter(a, n, b, m, out, false);
+    bool keepB = (op != SET_DIFFERENCE), keepBoth = (op == SET_UNION);
+    int i = 0, j = 0, k = 0;
+    while (i < n && j < m) {
+      if (a[i] < b[j]) {
+        const T x = a[i];
+        out[k++] = x;
+        do i++; while (i < n && a[i] == x);
+      } else if (b[j] < a[i]) {
+        const T x = b[j];
+        if (keepB) out[k++] = x;
+        do j++; while (j < m && b[j] == x);
+      } else {
+        const T x = a[i];
+        if (keepBoth) out[k++] = x;
+        do i++; while (i < n && a[i] == x);
+        do j++; while (j < m && b[j] == x);
+      }
+    }
+    for (; i < n; i++) if (k == 0 || !(out[k - 1] == a[i])) out[k++] = a[i];
+    if (keepB) for (; j < m; j++) if (k == 0 || !(out[k - 1] == b[j])) out[k++] = b[j];
+    return k;
+  }
+
+  /**
+   * @brief Distinct items stored in order of insertion, with an open-addressing index (linear probing, load factor
+   * up to 1/2 of the capacity given up front). Slots reuse `GroupSlot`, with `group` = position of the item
+   */
+  template <class T>
+  struct HashedSet {
+    T* items;
+    int count;
+    size_t mask;
+    std::vector<GroupSlot> slots;
+    HashedSet (T* items, int capacity) : items(items), count(0), mask(15) {
+      while (mask + 1 < (size_t) capacity * 2) mask = mask * 2 + 1;
+      GroupSlot empty = { 0, -1 };
+      this->slots.assign(mask + 1, empty);
+    }
+    // Slot holding `x`, or the empty slot where it belongs
+    size_t slotOf (const T& x, uint32_t tag) const {
+      size_t s = (size_t) tag & this->mask;
+      int g;
+      while ((g = this->slots[s].group) >= 0 && !(this->slots[s].tag == tag && this->items[g] == x)) s = (s + 1) & this->mask;
+      return s;
+    }
+    // Position of `x`, `-1` if absent
+    int find (const T& x) const { return this->slots[this->slotOf(x, (uint32_t) hashOf(x))].group; }
+    // Store `x` unless present, `true` if it was added
+    bool add (const T& x) {
+      uint32_t tag = (uint32_t) hashOf(x);
+      size_t s = this->slotOf(x, tag);
+      if (this->slots[s].group >= 0) return false;
+      this->slots[s].tag = tag;
+      this->slots[s].group = this->count;
+      this->items[this->count++] = x;
+      return true;
+    }
+  };
+
+  /**
+   * @brief Set operation `op` of unsorted `a[0..n)` and `b[0..m)` using hash sets
+   * @param out Room as in `setMerge`
+   * @return int - Number of distinct items written to `out`, in order of their first occurrence in `a`, then `b`
+   */
+  template <class T>
+  int setHash (const T* a, int n, const T* b, int m, T* out, SetOp op) {
+    if (op == SET_UNION) {
+      HashedSet<T> result(out, n + m);
+      for (int i = 0; i < n; i++) result.add(a[i]);
+      for (int j = 0; j < m; j++) result.add(b[j]);
+      return result.count;
+    }
+    std::vector<T> distinctB(m);
+    HashedSet<T> setB(m > 0 ? &distinctB[0] : nullptr, m);
+    for (int j = 0; j < m; j++) setB.add(b[j]);
+    if (op == SET_INTERSECTION) {
+      // Each item of `b` is written once, at its first match in `a`
+      std::vector<char> written(setB.count, 0);
+      int k = 0;
+      for (int i = 0; i < n; i++) {
+        int g = setB.find(a[i]);
+        if (g >= 0 && !written[g]) {
+          written[g] = 1;
+          out[k++] = a[i];
+        }
+      }
+      return k;
+    }
+    HashedSet<T> result(out, op == SET_DIFFERENCE ? n : n + m);
+    for (int i = 0; i < n; i++) if (setB.find(a[i]) < 0) result.add(a[i]);
+    if (op == SET_DIFFERENCE) return result.count;
+    std::vector<T> distinctA(n);
+    HashedSet<T> setA(n > 0 ? &distinctA[0] : nullptr, n);
+    for (int i = 0; i < n; i++) setA.add(a[i]);
+    for (int g = 0; g < setB.count; g++) if (setA.find(distinctB[g]) < 0) out[result.count++] = distinctB[g];
+    return result.count;
+  }
+}
+
+/*
+ * Sliding window accumulators used by `Array::movingSum`, `movingMean`, `movingMin`, `movingMax` and `movingVariance`.
+ * Window `[j+1, i]` is updated with `add(i)` and `remove(j)` in O(1) amortized time, `get()` gives its result.
+ * Floating point accumulators recompute their window from scratch once every `window` removals, which bounds
+ * the rounding error of adding and removing at O(n) total cost
+ */
+namespace array_detail {
+  template <class T>
+  struct MovingSum {
+    const T* a;
+    int window;
+    int count;
+    int removed;
+    T s;
+    MovingSum (const T* a, int window) : a(a), window(window), count(0), removed(0), s(0) {}
+    void add (int i) {
+      this->s += this->a[i];
+      this->count++;
+    }
+    void remove (int j) {
+      this->s -= this->a[j];
+      this->count--;
+      if (std::is_floating_point<T>::value && ++this->removed == this->window) {
+        this->removed = 0;
+        this->s = 0;
+        for (int i = j + 1; i <= j + this->count; i++) this->s += this->a[i];
+      }
+    }
+    T get () const { return this->s; }
+  };
+
+  template <class T>
+  struct MovingMean : MovingSum<T> {
+    MovingMean (const T* a, int window) : MovingSum<T>(a, window) {}
+    double get () const { return (this->s * 1.0) / (this->count * 1.0); }
+  };
+
+  // Min (`Cmp` = `Ascending`) or max (`Cmp` = `Descending`) of the window (van Herk / Gil-Werman): the Array is split
+  // into blocks of `window` items, a window is covered by a suffix of the previous block and a prefix of the current one.
+  // `suffix` holds the suffix bests of the previous block, `prefix` the running best of the current block
+  template <class T, class Cmp>
+  struct MovingExtreme {
+    const T* a;
+    int window;
+    int r;
+    std::vector<T> suffix;
+    T prefix;
+    Cmp cmp;
+    MovingExtreme (const T* a, int window) : a(a), window(window), r(window), suffix(window + 1), prefix() {}
+    void add (int i) {
+      if (this->r == this->window) {
+        // Start of a block. Inside the first one all windows start at 0 and `a[0]` never changes the result
+        if (i == 0) {
+          for (int j = 0; j <= this->window; j++) this->suffix[j] = this->a[0];
+        }
+        else {
+          this->suffix[this->window - 1] = this->a[i - 1];
+          for (int j = this->window - 2; j >= 0; j--) {
+            const T &x = this->a[i - this->window + j];
+            this->suffix[j] = this->cmp(x, this->suffix[j + 1]) ? x : this->suffix[j + 1];
+          }
+          // Window ending at the last item of the block is the whole block
+          this->suffix[this->window] = this->a[i];
+        }
+        this->prefix = this->a[i];
+        this->r = 0;
+      }
+      else if (this->cmp(this->a[i], this->prefix)) this->prefix = this->a[i];
+      this->r++;
+    }
+    void remove (int) {}
+    T get () const { return this->cmp(this->suffix[this->r], this->prefix) ? this->suffix[this->r] : this->prefix; }
+  };
+
+  // Welford update for added and removed items. Result is the sample variance of the window
+  template <class T>
+  struct MovingVariance {
+    const T* a;
+    int window;
+    int removed;
+    long long n;
+    double mean;
+    double m2;
+    MovingVariance (const T* a, int window) : a(a), window(window), removed(0), n(0), mean(0.0), m2(0.0) {}
+    void add (int i) {
+      double x = (double) this->a[i];
+      this->n++;
+      double delta = x - this->mean;
+      this->mean += delta / this->n;
+      this->m2 += delta * (x - this->mean);
+    }
+    void remove (int j) {
+      double y = (double) this->a[j];
+      this->n--;
+      if (++this->removed == this->window) {
+        this->removed = 0;
+        this->mean = 0.0;
+        this->m2 = 0.0;
+        for (int i = j + 1; i <= j + this->n; i++) this->mean += (double) this->a[i];
+        this->mean /= this->n;
+        for (int i = j + 1; i <= j + this->n; i++) this->m2 += ((double) this->a[i] - this->mean) * ((double) this->a[i] - this->mean);
+        return;
+      }
+      double delta = y - this->mean;
+      this->mean -= delta / this->n;
+      this->m2 -= delta * (y - this->mean);
+    }
+    double get () const { return this->n > 1 && this->m2 > 0 ? this->m2 / (this->n - 1.0) : 0.0; }
+  };
+}
+
+/*
+ * Callables of `Array::forEach`, `Array::filter` and `Array::map`. A callable may take the element, the element and its index,
+ * or the element, its index and the Array. The longest form it supports is used
+ */
+namespace array_detail {
+  struct ArgsOne {};
+  struct ArgsTwo : ArgsOne {};
+  struct ArgsThree : ArgsTwo {};
+  template <class F, class T, class A>
+  inline auto callElement (F &func, const T& elem, int index, const A& array, ArgsThree) -> decltype(func(elem, index, array)) { return func(elem, index, array); }
+  template <class F, class T, class A>
+  inline auto callElement (F &func, const T& elem, int index, const A&, ArgsTwo) -> decltype(func(elem, index)) { return func(elem, index); }
+  template <class F, class T, class A>
+  inline auto callElement (F &func, const T& elem, int, const A&, ArgsOne) -> decltype(func(elem)) { return func(elem); }
+  // Result type of `func` called by `callElement`
+  template <class F, class T, class A>
+  struct CallResult {
+    typedef typename std::decay<decltype(callElement(std::declval<F&>(), std::declval<const T&>(), 0, std::declval<const A&>(), ArgsThree()))>::type type;
+  };
+  // Element type produced by `Array::map`: `U`, or result type of the callable when `U` is `void`
+  template <class U, class F, class T, class A>
+  struct MapType { typedef U type; };
+  template <class F, class T, class A>
+  struct MapType<void, F, T, A> { typedef typename CallResult<F, T, A>::type type; };
+}
+
+template <class T, class Alloc = ArrayMallocAllocator> class Array;
+template <class T> class ArrayView;
+template <class T> class ArrayWriter;
+template <class T> class ArrayReader;
+template <class T> class PatternSet;
+template <class T> class RangeQueryIndex;
+template <class T> class RangeQueryTree;
+template <class T> class HashIndex;
+
+#ifndef ARRAY_PATTERN_DIRECT
+#define ARRAY_PATTERN_DIRECT 4096
+#endif
+#ifndef ARRAY_PATTERN_TABLE
+#define ARRAY_PATTERN_TABLE (1 << 22)
+#endif
+// Single match reported by `Array::findAllMulti` / `PatternSet`
+struct PatternMatch {
+  int pattern;  // Pattern id (see `PatternSet::add`)
+  int index;    // Start index of the match
+};
+inline std::ostream& operator<< (std::ostream &os, const PatternMatch &match) {
+  return os<<"("<<match.pattern<<", "<<match.index<<")";
+}
+
+/*
+ * Expression templates. Arithmetic and comparison operators of `Array` return lightweight expression nodes,
+ * which are evaluated in one fused loop when assigned to an `Array` or reduced with `sum()`, `mean()`, `min()` or `max()`.
+ * Every node has `size()`, `at(i)` (any `i < size()`) and `fast(i)` (only for `i < minSize()`, no size checks)
+ */
+namespace array_detail {
+  enum CompareOp { CMP_EQ, CMP_NE, CMP_LT, CMP_LE, CMP_GT, CMP_GE };
+  template <int Cmp> struct Compare;
+  template <> struct Compare<CMP_EQ> { template <class A, class B> static bool apply (const A& a, const B& b) { return a == b; } };
+  template <> struct Compare<CMP_NE> { template <class A, class B> static bool apply (const A& a, const B& b) { return a != b; } };
+  template <> struct Compare<CMP_LT> { template <class A, class B> static bool apply (const A& a, const B& b) { return a < b; } };
+  template <> struct Compare<CMP_LE> { template <class A, class B> static bool apply (const A& a, const B& b) { return a <= b; } };
+  template <> struct Compare<CMP_GT> { template <class A, class B> static bool apply (const A& a, const B& b) { return a > b; } };
+  template <> struct Compare<CMP_GE> { template <class A, class B> static bool apply (const A& a, const B& b) { return a >= b; } };
+
+  // Reads elements of an `Array`
+  template <class T>
+  struct LeafNode {
+    typedef T value_type;
+    const T* data;
+    int n;
+    template <class Alloc>
+    explicit LeafNode (const Array<T, Alloc> &array) : data(array.A), n(array.S) {}
+    int size () const { return n; }
+    int minSize () const { return n; }
+    T at (int i) const { return data[i]; }
+    T fast (int i) const { return data[i]; }
+  };
+  // Reads elements of packed `Array<bool>`
+  template <>
+  struct LeafNode<bool> {
+    typedef bool value_type;
+    const uint64_t* words;
+    int n;
+    template <class Alloc>
+    explicit LeafNode (const Array<bool, Alloc> &array) : words(array.W), n(array.S) {}
+    int size () const { return n; }
+    int minSize () const { return n; }
+    bool at (int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+    bool fast (int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+  };
+
+  // Reads elements of an `ArrayView` (strided)
+  template <class T>
+  struct ViewNode {
+    typedef T value_type;
+    const T* data;
+    int n;
+    int stride;
+    ViewNode (const T* data, int n, int stride) : data(data), n(n), stride(stride) {}
+    int size () const { return n; }
+    int minSize () const { return n; }
+    T at (int i) const { return data[(long long) i * stride]; }
+    T fast (int i) const { return data[(long long) i * stride]; }
+  };
+
+  // `l[i] Op s`
+  template <int Op, class L>
+  struct ScalarNode {
+    typedef typename L::value_type value_type;
+    L l;
+    value_type s;
+    ScalarNode (const L &l, const value_type &s) : l(l), s(s) {}
+    int size () const { return l.size(); }
+    int minSize () const { return l.minSize(); }
+    value_type at (int i) const { return Arith<Op, value_type>::apply(l.at(i), s); }
+    value_type fast (int i) const { return Arith<Op, value_type>::apply(l.fast(i), s); }
+  };
+
+  // `l[i] Op r[i]`. Same size rules as eager `Array` arithmetic: elements only `l` has are passed through,
+  // elements only `r` has are combined with `0`
+  template <int Op, class L, class R>
+  struct BinaryNode {
+    typedef typename L::value_type value_type;
+    L l;
+    R r;
+    BinaryNode (const L &l, const R &r) : l(l), r(r) {}
+    int size () const { return l.size() > r.size() ? l.size() : r.size(); }
+    int minSize () const { return l.minSize() < r.minSize() ? l.minSize() : r.minSize(); }
+    value_type at (int i) const {
+      if (i >= r.size()) return l.at(i);
+      if (i >= l.size()) return Arith<Op, value_type>::apply((value_type) 0, (value_type) r.at(i));
+      return Arith<Op, value_type>::apply(l.at(i), (value_type) r.at(i));
+    }
+    value_type fast (int i) const { return Arith<Op, value_type>::apply(l.fast(i), (value_type) r.fast(i)); }
+  };
+
+  // `l[i] Cmp s`
+  template <int Cmp, class L>
+  struct CompareScalarNode {
+    typedef bool value_type;
+    typedef typename L::value_type operand_type;
+    L l;
+    operand_type s;
+    CompareScalarNode (const L &l, const operand_type &s) : l(l), s(s) {}
+    int size () const { return l.size(); }
+    int minSize () const { return l.minSize(); }
+    bool at (int i) const { return Compare<Cmp>::apply(l.at(i), s); }
+    bool fast (int i) const { return Compare<Cmp>::apply(l.fast(i), s); }
+  };
+
+  // `l[i] Cmp r[i]`. Elements outside the shorter operand are `false`
+  template <int Cmp, class L, class R>
+  struct CompareNode {
+    typedef bool value_type;
+    L l;
+    R r;
+    CompareNode (const L &l, const R &r) : l(l), r(r) {}
+    int size () const { return l.size() > r.size() ? l.size() : r.size(); }
+    int minSize () const { return l.minSize() < r.minSize() ? l.minSize() : r.minSize(); }
+    bool at (int i) const { return (i >= l.size() || i >= r.size()) ? false : Compare<Cmp>::apply(l.at(i), r.at(i)); }
+    bool fast (int i) const { return Compare<Cmp>::apply(l.fast(i), r.fast(i)); }
+  };
+
+  // `!l[i]`
+  template <class L>
+  struct NotNode {
+    typedef bool value_type;
+    L l;
+    explicit NotNode (const L &l) : l(l) {}
+    int size () const { return l.size(); }
+    int minSize () const { return l.minSize(); }
+    bool at (int i) const { return !l.at(i); }
+    bool fast (int i) const { return !l.fast(i); }
+  };
+
+  // Evaluate `e` into `out[0..n)`, `n = e.size()`. `out` may be one of the leaves of `e`
+  template <class E, class U>
+  void evalInto (const E &e, U* out, int n) {
+    int m = e.minSize();
+    for (int i = 0; i < m; i++) out[i] = (U) e.fast(i);
+    for (int i = m; i < n; i++) out[i] = (U) e.at(i);
+  }
+  // Single operations on `Array` leaves go through the SIMD kernels
+  template <int Op, class T>
+  void evalInto (const BinaryNode<Op, LeafNode<T>, LeafNode<T>> &e, T* out, int n) {
+    int m = e.minSize();
+    arith<Op>(e.l.data, e.r.data, out, m);
+    for (int i = m; i < n; i++) out[i] = e.at(i);
+  }
+  template <int Op, class T>
+  void evalInto (const ScalarNode<Op, LeafNode<T>> &e, T* out, int n) {
+    arith<Op>(e.l.data, e.s, out, n);
+  }
+}
+
+namespace array_detail {
+  // `T`, as a type that depends on `Args` (defers member lookup in `decltype` to the call)
+  template <class T, class... Args>
+  struct Dependent { typedef T type; };
+}
+
+// `ArrayExpr` member `NAME(args...)` = `eval().NAME(args...)`, for the `Array` overloads that accept `args`
+#define ARRAY_EXPR_FORWARD(NAME) \
+  template <class... Args> \
+  auto NAME (Args&&... args) const \
+    -> decltype(std::declval<typename array_detail::Dependent<Array<value_type>, Args...>::type&>().NAME(std::forward<Args>(args)...)) { \
+    return this->eval().NAME(std::forward<Args>(args)...); \
+  }
+// Same for names that also have a lazy no-argument version in `ArrayExpr`
+#define ARRAY_EXPR_FORWARD_ARGS(NAME) \
+  template <class Arg, class... Args> \
+  auto NAME (Arg&& arg, Args&&... args) const \
+    -> decltype(std::declval<typename array_detail::Dependent<Array<value_type>, Arg>::type&>().NAME(std::forward<Arg>(arg), std::forward<Args>(args)...)) { \
+    return this->eval().NAME(std::forward<Arg>(arg), std::forward<Args>(args)...); \
+  }
+
+/**
+ * @brief Lazy element-wise expression over `Array` operands, returned by `Array` arithmetic and comparison operators.
+ * Evaluated when assigned to an `Array`, or reduced directly without creating any `Array`.
+ * Other read-only `Array` methods (`variance`, `find`, `slice`, `toVector`, `astype`, ...) evaluate the expression once
+ * into a temporary `Array` and call the method on it. Braced lists (`{...}`) can not be forwarded, pass an `Array` instead
+ * @warning Expression keeps references to its `Array` operands. Do not store it (e.g. in `auto`) beyond their lifetime,
+ * assign it to an `Array` instead
+ */
+template <class E>
+class ArrayExpr {
+  private:
+    E e;
+  public:
+    typedef typename E::value_type value_type;
+    explicit ArrayExpr (const E &e) : e(e) {}
+    const E& node () const noexcept { return e; }
+    // Size of the evaluated `Array`
+    int size () const { return e.size(); }
+    int length () const { return e.size(); }
+    // Evaluate single element (Negative indexing supported)
+    value_type operator[] (int index) const {
+      int n = e.size();
+      if (index < -n || index >= n) throw std::invalid_argument("Invalid Array Index!");
+      return e.at(index >= 0 ? index : index + n);
+    }
+    // Evaluate the expression into new `Array`
+    Array<value_type> eval () const { return Array<value_type>(*this); }
+    // Print evaluated expression to stdout (see `Array::show`)
+    void show (
+      bool showType = false, bool showBrackets = true, bool endNewLine = true, bool elemNewLine = false,
+      char bracketOpenChar = '[', char bracketCloseChar = ']', const std::string &sep = ", "
+    ) const {
+      this->eval().show(showType, showBrackets, endNewLine, elemNewLine, bracketOpenChar, bracketCloseChar, sep);
+    }
+    // Sum of all elements, computed in one pass without temporaries
+    value_type sum () const {
+      int n = e.size(), m = e.minSize();
+      value_type s = 0;
+      for (int i = 0; i < m; i++) s += e.fast(i);
+      for (int i = m; i < n; i++) s += e.at(i);
+      return s;
+    }
+    // Arithmetic mean of all elements, computed in one pass without temporaries
+    double mean () const {
+      int n = e.size();
+      if (n == 0) return 0;
+      return (this->sum() * 1.0) / (n * 1.0);
+    }
+    // Min of all elements, computed in one pass without temporaries
+    value_type min () const {
+      int n = e.size();
+      if (n == 0) return 0;
+      value_type minV = e.at(0);
+      for (int i = 1; i < n; i++) {
+        value_type v = e.at(i);
+        if (v < minV) minV = v;
+      }
+      return minV;
+    }
+    // Max of all elements, computed in one pass without temporaries
+    value_type max () const {
+      int n = e.size();
+      if (n == 0) return 0;
+      value_type maxV = e.at(0);
+      for (int i = 1; i < n; i++) {
+        value_type v = e.at(i);
+        if (v > maxV) maxV = v;
+      }
+      return maxV;
+    }
+
+    // Index Array or mask selection of the evaluated expression (see `Array::operator[]`)
+    template <class I, class = typename std::enable_if<std::is_class<I>::value>::type>
+    auto operator[] (const I& index) const -> decltype(std::declval<const Array<value_type>&>()[index]) {
+      const Array<value_type> X = this->eval();
+      return X[index];
+    }
+    // Evaluated expression converted to `Array<U>` (see `Array::astype`)
+    template <class U>
+    Array<U> astype () const { return this->eval().template astype<U>(); }
+    // Evaluated expression mapped by `func` (see `Array::map`)
+    template <class U = void, class... Args>
+    auto map (Args&&... args) const
+      -> decltype(std::declval<typename array_detail::Dependent<Array<value_type>, U>::type&>().template map<U>(std::forward<Args>(args)...)) {
+      return this->eval().template map<U>(std::forward<Args>(args)...);
+    }
+    ARRAY_EXPR_FORWARD_ARGS(sum)
+    ARRAY_EXPR_FORWARD_ARGS(mean)
+    ARRAY_EXPR_FORWARD_ARGS(min)
+    ARRAY_EXPR_FORWARD_ARGS(max)
+    ARRAY_EXPR_FORWARD(product)
+    ARRAY_EXPR_FORWARD(meanG)
+    ARRAY_EXPR_FORWARD(meanH)
+    ARRAY_EXPR_FORWARD(weightedMean)
+    ARRAY_EXPR_FORWARD(variance)
+    ARRAY_EXPR_FORWARD(stdev)
+    ARRAY_EXPR_FORWARD(describe)
+    ARRAY_EXPR_FORWARD(argmin)
+    ARRAY_EXPR_FORWARD(argmax)
+    ARRAY_EXPR_FORWARD(contains)
+    ARRAY_EXPR_FORWARD(count)
+    ARRAY_EXPR_FORWARD(find)
+    ARRAY_EXPR_FORWARD(findAll)
+    ARRAY_EXPR_FORWARD(findAllMulti)
+    ARRAY_EXPR_FORWARD(isSorted)
+    ARRAY_EXPR_FORWARD(searchsorted)
+    ARRAY_EXPR_FORWARD(slice)
+    ARRAY_EXPR_FORWARD(compress)
+    ARRAY_EXPR_FORWARD(where)
+    ARRAY_EXPR_FORWARD(filter)
+    ARRAY_EXPR_FORWARD(forEach)
+    ARRAY_EXPR_FORWARD(unique)
+    ARRAY_EXPR_FORWARD(sortedUnique)
+    ARRAY_EXPR_FORWARD(uniqueCounts)
+    ARRAY_EXPR_FORWARD(uniqueInverse)
+    ARRAY_EXPR_FORWARD(toSorted)
+    ARRAY_EXPR_FORWARD(cumsum)
+    ARRAY_EXPR_FORWARD(cumprod)
+    ARRAY_EXPR_FORWARD(cummin)
+    ARRAY_EXPR_FORWARD(cummax)
+    ARRAY_EXPR_FORWARD(movingSum)
+    ARRAY_EXPR_FORWARD(movingMean)
+    ARRAY_EXPR_FORWARD(movingMin)
+    ARRAY_EXPR_FORWARD(movingMax)
+    ARRAY_EXPR_FORWARD(movingVariance)
+    ARRAY_EXPR_FORWARD(movingStdev)
+    ARRAY_EXPR_FORWARD(setUnion)
+    ARRAY_EXPR_FORWARD(setIntersection)
+    ARRAY_EXPR_FORWARD(setDifference)
+    ARRAY_EXPR_FORWARD(setSymmetricDifference)
+    ARRAY_EXPR_FORWARD(toVector)
+    ARRAY_EXPR_FORWARD(toList)
+    ARRAY_EXPR_FORWARD(toSet)
+    ARRAY_EXPR_FORWARD(save)
+};
+#undef ARRAY_EXPR_FORWARD
+#undef ARRAY_EXPR_FORWARD_ARGS
+
+template <class T, class Alloc>
+class Array {
+  template <class U, class A> friend class Array;
+  template <class U> friend struct array_detail::LeafNode;
+  template <class U> friend class ArrayWriter;
+  template <class U> friend class RangeQueryIndex;
+  template <class U> friend class RangeQueryTree;
+  template <class U> friend class HashIndex;
+  private:
+    T* A;
+    int S;
+    int C;
+    // `'a'` - items are known to be sorted ascending, `'d'` - descending, `0` - unknown. Set by `sort` of the whole Array,
+    // cleared by every method that can change the items (including non-const `operator[]`)
+    char order = 0;
+    // Order flag for items just sorted by `sortRange`. Unknown if they contain NaN, which breaks binary search
+    char sortedOrder (bool ascending) const {
+      if (std::is_floating_point<T>::value) {
+        for (int i = 0; i < this->S; i++) if (this->A[i] != this->A[i]) return 0;
+      }
+      return ascending ? 'a' : 'd';
+    }
+    // Range `[lo,hi)` of items equal to `elem` in `[b,e]` found by binary search. `false` if the order is not known
+    bool equalRange (const T& elem, int b, int e, int &lo, int &hi) const {
+      if (this->order == 0) return false;
+      if (!(elem == elem)) lo = hi = b;
+      else if (this->order == 'a') {
+        lo = array_detail::lowerBound(this->A, b, e + 1, elem, array_detail::Ascending<T>());
+        hi = array_detail::upperBound(this->A, lo, e + 1, elem, array_detail::Ascending<T>());
+      } else {
+        lo = array_detail::lowerBound(this->A, b, e + 1, elem, array_detail::Descending<T>());
+        hi = array_detail::upperBound(this->A, lo, e + 1, elem, array_detail::Descending<T>());
+      }
+      return true;
+    }
+    // Insertion index of each of `m` values `v` into the Array sorted by `cmp`. Values sorted by `cmp` themselves are
+    // located by galloping forward from the previous result (merge walk), others by binary search over the whole Array
+    template <class Cmp>
+    void searchSortedInto (const T* v, int m, bool right, int* out, Cmp cmp) const {
+      bool batchSorted = true;
+      for (int i = 1; i < m && batchSorted; i++) batchSorted = !cmp(v[i], v[i - 1]);
+      int pos = 0;
+      for (int i = 0; i < m; i++) {
+        int lo = 0, hi = this->S;
+        if (batchSorted) {
+          // Items before `lo` go before `v[i]`, item `hi` (if any) does not
+          lo = hi = pos;
+          for (int step = 1; hi < this->S && (right ? !cmp(v[i], this->A[hi]) : cmp(this->A[hi], v[i])); step <<= 1) {
+            lo = hi + 1;
+            hi += step;
+          }
+          if (hi > this->S) hi = this->S;
+        }
+        pos = right ? array_detail::upperBound(this->A, lo, hi, v[i], cmp) : array_detail::lowerBound(this->A, lo, hi, v[i], cmp);
+        out[i] = pos;
+      }
+    }
+    // Items in ascending order: the Array itself if it is known or checked to be sorted, a sorted copy in `buffer` otherwise
+    const T* ascendingItems (Array &buffer) const {
+      if (this->order == 'a' || this->isSorted()) return this->A;
+      buffer = *this;
+      array_detail::sortRange(buffer.A, buffer.S, true);
+      return buffer.A;
+    }
+    // Set operation `op` with `other` by `method`: `s` - merge of ascending items, `h` - hash sets
+    template <class OtherAlloc>
+    Array setOperation (const Array<T, OtherAlloc> &other, array_detail::SetOp op, char method) const {
+      if (method != 's' && method != 'h') throw std::invalid_argument("Method should be s - sorted or h - hash");
+      int n = this->S, m = other.S;
+      long long room = (op == array_detail::SET_INTERSECTION ? (n < m ? n : m) : op == array_detail::SET_DIFFERENCE ? n : (long long) n + m);
+      if (room > ARRAY_END) room = ARRAY_END;
+      Array X;
+      X.sizeAlloc((int) room);
+      if (method == 'h') {
+        X.S = array_detail::setHash(this->A, n, other.A, m, X.A, op);
+        return X;
+      }
+      Array bufferA;
+      Array<T, OtherAlloc> bufferB;
+      X.S = array_detail::setMerge(this->ascendingItems(bufferA), n, other.ascendingItems(bufferB), m, X.A, op);
+      X.order = X.sortedOrder(true);
+      return X;
+    }
+    int idx (int index) const {
+      if (index < -this->S || index >= this->S) throw std::invalid_argument("Invalid Array Index!");
+      if (index >= 0) return index;
+      return index + this->S;
+    }
+    void checkRange (int From, int To) const {
+      int width = idx(To) - idx(From) + 1;
+      if (width < 1 || width > this->S) throw std::invalid_argument("Invalid From-To Range");
+      return;
+    }
+    static void checkSize (int size) {
+      if (size < ARRAY_BEGIN || size > ARRAY_END) throw std::invalid_argument("Invalid Array Size provided");
+      return;
+    }
+    // Store `value` at valid index `i` (packed `Array<bool>` has its own version)
+    void put (int i, const T& value) { this->A[i] = value; }
+    // Elements for which `func` returns `true`. Output is allocated once for the whole Array and shrunk afterwards
+    template <class F>
+    Array filterElements (F &func) const {
+      Array X;
+      if (this->S == 0) return X;
+      int k = 0;
+      if (std::is_trivially_copyable<T>::value) {
+        X.reallocate(this->S);
+        // Branchless: every element is stored, only kept ones advance the output
+        for (int i = 0; i < this->S; i++) {
+          X.A[k] = this->A[i];
+          k += array_detail::callElement(func, this->A[i], i, *this, array_detail::ArgsThree()) ? 1 : 0;
+        }
+      } else {
+        X.sizeAlloc(this->S);
+        for (int i = 0; i < this->S; i++) {
+          if (array_detail::callElement(func, this->A[i], i, *this, array_detail::ArgsThree())) X.A[k++] = this->A[i];
+        }
+      }
+      X.S = k;
+      if (k < X.C / 2) X.reallocate(k);
+      return X;
+    }
+    // Inclusive `Op` scan of `[b,e]` into `out` (may alias `this->A + b`). With more than 1 task, the first pass reduces
+    // every chunk, the second one scans every chunk starting from the combined result of the chunks before it
+    template <int Op>
+    void scanRange (T* out, int b, int e, const ArrayPolicy &policy) const {
+      int tasks = policy.tasks(e - b + 1);
+      if (tasks <= 1) {
+        array_detail::scan<Op>(this->A + b, out, e - b + 1);
+        return;
+      }
+      std::vector<T> carry(tasks);
+      array_detail::parallelChunks(b, e, tasks, [&] (int c, int lo, int hi) {
+        if (c + 1 < tasks) carry[c] = array_detail::scanReduce<Op>(this->A + lo, hi - lo + 1);
+      });
+      for (int c = 1; c < tasks; c++) carry[c] = array_detail::ScanApply<Op, T>::apply(carry[c - 1], carry[c]);
+      array_detail::parallelChunks(b, e, tasks, [&] (int c, int lo, int hi) {
+        if (c == 0) array_detail::scan<Op>(this->A + lo, out + (lo - b), hi - lo + 1);
+        else array_detail::scan<Op>(this->A + lo, out + (lo - b), hi - lo + 1, carry[c - 1]);
+      });
+    }
+    template <int Op>
+    Array scanned (const ArrayPolicy &policy, int from, int to) const {
+      Array X;
+      if (this->S == 0) return X;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      X.sizeAlloc(e - b + 1);
+      this->scanRange<Op>(X.A, b, e, policy);
+      return X;
+    }
+    template <int Op>
+    void scanInPlace (const ArrayPolicy &policy, int from, int to) {
+      this->order = 0;
+      if (this->S == 0) return;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      this->scanRange<Op>(this->A + b, b, e, policy);
+    }
+    // Result of `acc` for every window selected by `window`, `step` and `edge` (see `movingSum`)
+    template <class R, class Acc>
+    Array<R, Alloc> slide (int window, int step, char edge, Acc &acc) const {
+      if (window < 1) throw std::invalid_argument("Window should be positive");
+      if (step < 1) throw std::invalid_argument("Step should be positive");
+      if (edge != 'v' && edge != 'p') throw std::invalid_argument("Edge should be v - valid or p - partial");
+      Array<R, Alloc> X;
+      // Last index of the first window
+      int next = edge == 'v' ? window - 1 : 0;
+      if (next >= this->S) return X;
+      X.sizeAlloc((this->S - 1 - next) / step + 1);
+      for (int i = 0, k = 0; k < X.S; i++) {
+        acc.add(i);
+        if (i >= window) acc.remove(i - window);
+        if (i == next) {
+          X.put(k++, acc.get());
+          next += step;
+        }
+      }
+      return X;
+    }
+    // Results of `func` for every element, written into a single allocation
+    template <typename U, class F>
+    Array<U, Alloc> mapElements (F &func) const {
+      Array<U, Alloc> X;
+      X.sizeAlloc(this->S);
+      for (int i = 0; i < this->S; i++) X.put(i, array_detail::callElement(func, this->A[i], i, *this, array_detail::ArgsThree()));
+      return X;
+    }
+    void sizeAlloc (int size) {
+      checkSize(size);
+      this->S = size;
+      this->C = size;
+      if (size > 0) {
+        this->A = (T*) Alloc::allocate(size * sizeof(T));
+        if (this->A == NULL) throw std::invalid_argument("Failed to Allocate Memory");
+        memset((void*) this->A, 0, size * sizeof(T));
+      }
+      else this->A = nullptr;
+    }
+    // Reallocate storage to hold exactly `capacity` elements (must be >= current size)
+    void reallocate (int capacity) {
+      if (capacity == 0) {
+        Alloc::deallocate(this->A, this->C * sizeof(T));
+        this->A = nullptr;
+        this->C = 0;
+        return;
+      }
+      T* newA = (T*) Alloc::reallocate(this->A, this->C * sizeof(T), capacity * sizeof(T));
+      if (newA == NULL) throw std::invalid_argument("Failed to Allocate Memory");
+      this->A = newA;
+      this->C = capacity;
+    }
+    // Make room for at least `minCapacity` elements using geometric (1.5x) growth
+    void grow (int minCapacity) {
+      if (minCapacity <= this->C) return;
+      long long newCap = this->C + this->C / 2;
+      if (newCap < ARRAY_MIN_CAPACITY) newCap = ARRAY_MIN_CAPACITY;
+      if (newCap < minCapacity) newCap = minCapacity;
+      if (newCap > ARRAY_END) newCap = ARRAY_END;
+      this->reallocate((int) newCap);
+    }
+    typedef array_detail::LeafNode<T> Leaf;
+    template <int Op> using ScalarExpr = ArrayExpr<array_detail::ScalarNode<Op, Leaf>>;
+    template <int Op> using BinaryExpr = ArrayExpr<array_detail::BinaryNode<Op, Leaf, Leaf>>;
+    template <int Cmp> using CompareScalarExpr = ArrayExpr<array_detail::CompareScalarNode<Cmp, Leaf>>;
+    template <int Cmp> using CompareExpr = ArrayExpr<array_detail::CompareNode<Cmp, Leaf, Leaf>>;
+    template <int Op>
+    ScalarExpr<Op> scalarExpr (const T& number) const { return ScalarExpr<Op>(array_detail::ScalarNode<Op, Leaf>(Leaf(*this), number)); }
+    template <int Op>
+    BinaryExpr<Op> binaryExpr (const Array& array) const { return BinaryExpr<Op>(array_detail::BinaryNode<Op, Leaf, Leaf>(Leaf(*this), Leaf(array))); }
+    template <int Cmp>
+    CompareScalarExpr<Cmp> compareScalarExpr (const T& val) const { return CompareScalarExpr<Cmp>(array_detail::CompareScalarNode<Cmp, Leaf>(Leaf(*this), val)); }
+    template <int Cmp>
+    CompareExpr<Cmp> compareExpr (const Array& array) const { return CompareExpr<Cmp>(array_detail::CompareNode<Cmp, Leaf, Leaf>(Leaf(*this), Leaf(array))); }
+    // Evaluate `expr` into this Array. Storage is reused when the result fits in the current capacity
+    template <class E>
+    void assignExpr (const ArrayExpr<E> &expr) {
+      this->order = 0;
+      int n = expr.size();
+      checkSize(n);
+      if (n > this->C) {
+        Array X;
+        X.reserve(n);
+        array_detail::evalInto(expr.node(), X.A, n);
+        X.S = n;
+        *this = std::move(X);
+        return;
+      }
+      array_detail::evalInto(expr.node(), this->A, n);
+      this->S = n;
+    }
+    // `A[i] = A[i] Op array[i]`. Array is first extended with `0` to the size of `array`
+    template <int Op>
+    Array& arithAssign (const Array& array) {
+      this->order = 0;
+      if (array.S > this->S) this->resize(array.S);
+      array_detail::arith<Op>(this->A, array.A, this->A, array.S);
+      return *this;
+    }
+    // `A[i] = A[i] Op expr[i]` in one fused loop (same size rules as `arithAssign`)
+    template <int Op, class E>
+    Array& arithAssignExpr (const ArrayExpr<E> &expr) {
+      this->order = 0;
+      if (expr.size() > this->S) return this->arithAssign<Op>(Array(expr));
+      const E &e = expr.node();
+      int n = e.size(), m = e.minSize();
+      for (int i = 0; i < m; i++) this->A[i] = array_detail::Arith<Op, T>::apply(this->A[i], (T) e.fast(i));
+      for (int i = m; i < n; i++) this->A[i] = array_detail::Arith<Op, T>::apply(this->A[i], (T) e.at(i));
+      return *this;
+    }
+    // Append indices of min values in `[b,e]` (valid, non-empty range) to `X`
+    template <class Out>
+    void argminInto (Out &X, int b, int e) const {
+      T minV = this->A[b];
+      X.append(b);
+      for (int i = b + 1; i <= e; i++) {
+        if (this->A[i] < minV) {
+          minV = this->A[i];
+          X.clear();
+          X.append(i);
+        } else if (this->A[i] == minV) X.append(i);
+      }
+    }
+    // Append indices of max values in `[b,e]` (valid, non-empty range) to `X`
+    template <class Out>
+    void argmaxInto (Out &X, int b, int e) const {
+      T maxV = this->A[b];
+      X.append(b);
+      for (int i = b + 1; i <= e; i++) {
+        if (this->A[i] > maxV) {
+          maxV = this->A[i];
+          X.clear();
+          X.append(i);
+        } else if (this->A[i] == maxV) X.append(i);
+      }
+    }
+  public:
+    /* STATIC METHODS FOR CONVERSIONS */
+    static Array fromVector (const std::vector < T > &STL_Vector) {
+      Array a;
+      a.sizeAlloc(STL_Vector.size());
+      for (int i = 0; i < a.size(); i++) a[i] = STL_Vector[i];
+      return a;
+    }
+    static Array fromList (const std::list < T > &STL_List) {
+      Array a;
+      a.sizeAlloc(STL_List.size());
+      int i = 0;
+      for (auto it = STL_List.cbegin(); it != STL_List.cend(); it++) {
+        if (i >= a.size()) break;
+        a[i] = *it;
+        i++;
+      }
+      return a;
+    }
+    static Array fromSet (const std::set < T > &STL_Set) {
+      Array a;
+      a.sizeAlloc(STL_Set.size());
+      int i = 0;
+      for (auto it = STL_Set.cbegin(); it != STL_Set.cend(); it++) {
+        if (i >= a.size()) break;
+        a[i] = *it;
+        i++;
+      }
+      return a;
+    }
+    static Array fromInitList (std::initializer_list<T> InitValues) {
+      Array a;
+      a.sizeAlloc(InitValues.size());
+      int i = 0;
+      for (auto it = InitValues.begin(); it != InitValues.end(); it++) {
+        if (i >= a.size()) break;
+        a[i] = *it;
+        i++;
+      }
+      return a;
+    }
+    static Array fromPointer (T* ptr, int size) {
+      Array a;
+      a.sizeAlloc(size);
+      for (int i = 0; i < a.size(); i++) a[i] = ptr[i];
+      return a;
+    }
+#if ARRAY_MMAP
+    /**
+     * @brief Create Array over raw binary file contents (`T` values in native byte order) without reading or copying it.
+     * Pages are loaded on first access, so opening is instant regardless of file size
+     * @param path File path. File size should be a multiple of `sizeof(T)`
+     * @param readOnly `true` (default) - the file is never modified, written elements get private copies.
+     * `false` - changes are written back to the file (see `flush`)
+     * @return Array<T, ArrayMapAllocator> - Mapped Array. Mapping is released when the Array is destroyed or grows
+     */
+    static Array<T, ArrayMapAllocator> mapFile (const std::string &path, bool readOnly = true) {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be mapped from a file");
+      size_t bytes = 0;
+      T* data = (T*) ArrayMapAllocator::map(path, readOnly, sizeof(T), bytes);
+      Array<T, ArrayMapAllocator> X;
+      X.A = data;
+      X.S = (int) (bytes / sizeof(T));
+      X.C = X.S;
+      return X;
+    }
+#endif
+    /**
+     * @brief Read Array saved with `save` or `ArrayWriter`. Checksum is verified, byte order converted if needed
+     * @param path File path
+     * @return Array
+     */
+    static Array load (const std::string &path) {
+      ArrayReader<T> reader(path);
+      if (reader.size() > (long long) ARRAY_END) throw std::invalid_argument("File holds too many elements for an Array: " + path);
+      Array X;
+      int n = (int) reader.size();
+      if (n > 0) X.reallocate(n);
+      reader.read(X.A, n);
+      X.S = n;
+      reader.close();
+      return X;
+    }
+    /* CONSTRUCTORS */
+    // Empty Array Constructor -> Size = 0
+    Array () {
+      this->S = 0;
+      this->C = 0;
+      this->A = nullptr;
+    }
+    // Array Constructor with initial size
+    explicit Array (int s) { this->sizeAlloc(s); }
+    // Array Constructor using STL Vector
+    explicit Array (const std::vector < T > &STL_Vector) {
+      this->sizeAlloc(STL_Vector.size());
+      for (int i = 0; i < this->S; i++) this->A[i] = STL_Vector[i];
+    }
+    // Array Constructor using STL List
+    explicit Array (const std::list < T > &STL_List) {
+      this->sizeAlloc(STL_List.size());
+      int i = 0;
+      for (auto it = STL_List.cbegin(); it != STL_List.cend(); it++) {
+        if (i >= this->S) break;
+        this->A[i] = *it;
+        i++;
+      }
+    }
+    // Array Constructor using STL Set
+    explicit Array (const std::set < T > &STL_Set) {
+      this->sizeAlloc(STL_Set.size());
+      int i = 0;
+      for (auto it = STL_Set.cbegin(); it != STL_Set.cend(); it++) {
+        if (i >= this->S) break;
+        this->A[i] = *it;
+        i++;
+      }
+    }
+    // Array Constructor using STL Initializer List
+    explicit Array (std::initializer_list<T> InitValues) {
+      this->sizeAlloc(InitValues.size());
+      int i = 0;
+      for (auto it = InitValues.begin(); it != InitValues.end(); ++it) {
+        if (i >= this->S) break;
+        this->A[i] = *it;
+        i++;
+      }
+    }
+    // Array Constructor using pointer
+    Array (const T* dynamicArray, int arraySize) {
+      this->sizeAlloc(arraySize);
+      for (int i = 0; i < this->S; i++) this->A[i] = dynamicArray[i];
+    }
+    // Copy constructor
+    Array(const Array& other) : S(other.S), C(other.S), order(other.order) {
+      if (this->S > 0) {
+        this->A = (T*) Alloc::allocate(this->S * sizeof(T));
+        if (this->A == NULL) throw std::invalid_argument("Failed to Allocate Memory");
+        for (int i = 0; i < this->S; i++) this->A[i] = other.A[i];
+      } else this->A = nullptr;
+    }
+    // Copy constructor from Array using another allocator
+    template <class OtherAlloc>
+    explicit Array(const Array<T, OtherAlloc>& other) : A(nullptr), S(0), C(0), order(other.order) {
+      this->sizeAlloc(other.S);
+      for (int i = 0; i < this->S; i++) this->A[i] = other.A[i];
+    }
+    // Array Constructor evaluating an expression (e.g. `Array<int> c = a * 2 + b;`) in a single pass
+    template <class E>
+    Array (const ArrayExpr<E> &expr) : A(nullptr), S(0), C(0) { this->assignExpr(expr); }
+    // Move constructor
+    Array(Array&& other) noexcept : A(other.A), S(other.S), C(other.C), order(other.order) {
+      other.S = 0;
+      other.C = 0;
+      other.A = nullptr;
+    }
+    // Default Destructor
+    ~Array () {
+      if (this->A != nullptr) Alloc::deallocate(this->A, this->C * sizeof(T));
+    }
+    // Getting array size
+    int size () noexcept {return this->S;}
+    int size () const noexcept {return S;}
+    // Same as `size()`
+    int length () noexcept {return this->S;}
+    int length () const noexcept {return S;}
+    // Getting number of elements the Array can hold without reallocating
+    int capacity () const noexcept {return C;}
+    /**
+     * @brief Write changes of a file-backed Array (`mapFile(path, false)`) back to the file.
+     * Available for Arrays using `ArrayMapAllocator` (compile error otherwise), no-op when the Array is not mapped
+     */
+    void flush () const {
+      static_assert(array_detail::IsMapAllocator<Alloc>::value, "flush() needs an Array with ArrayMapAllocator (see mapFile)");
+      array_detail::flushMapped<Alloc>(this->A, array_detail::IsMapAllocator<Alloc>());
+    }
+    /**
+     * @brief Hint expected access pattern of a file-backed Array (see `mapFile`) to the kernel.
+     * Available for Arrays using `ArrayMapAllocator` (compile error otherwise), no-op when the Array is not mapped
+     * @param mode `'s'` - Sequential (read-ahead aggressively), `'r'` - Random (no read-ahead),
+     * `'w'` - Will need (prefetch now), `'n'` - Normal (default behaviour)
+     */
+    void advise (char mode) const {
+      static_assert(array_detail::IsMapAllocator<Alloc>::value, "advise() needs an Array with ArrayMapAllocator (see mapFile)");
+      array_detail::adviseMapped<Alloc>(this->A, mode, array_detail::IsMapAllocator<Alloc>());
+    }
+
+    /**
+     * @brief Reserve storage for at least `capacity` elements. Never shrinks the Array
+     * @param capacity Requested capacity
+     */
+    void reserve (int capacity) {
+      checkSize(capacity);
+      if (capacity > this->C) this->reallocate(capacity);
+    }
+
+    /**
+     * @brief Release unused capacity so that `capacity() == size()`
+     */
+    void shrinkToFit () {
+      if (this->C > this->S) this->reallocate(this->S);
+    }
+    /**
+     * @brief Print Array to stdout
+     * @param showType View `Array` type. Default `false`
+     * @param showBrackets View Brakcets. Default `true`
+     * @param endNewLine Print `\n` after viewing the array. Default `true`
+     * @param elemNewLine Print `\n` after each element. Default `false`
+     * @param bracketOpenChar Opening bracket character. Default `'['`
+     * @param bracketCloseChar Closing bracket character. Default `']'`
+     * @param sep Separator string. Default `", "`
+     */
+    void show (
+      bool showType = false, bool showBrackets = true, bool endNewLine = true, bool elemNewLine = false,
+      char bracketOpenChar = '[', char bracketCloseChar = ']', const std::string &sep = ", "
+    ) const noexcept {
+      if (showType) std::cout<<"`Array` ";
+      if (showBrackets) std::cout<<bracketOpenChar;
+      for (int i = 0; i < this->S; i++) {
+        std::cout<<this->A[i];
+        if (i < this->S - 1) std::cout<<sep;
+        if (elemNewLine) std::cout<<std::endl;
+      }
+      if (showBrackets) std::cout<<bracketCloseChar;
+      if (endNewLine) std::cout<<std::endl;
+    }
+
+    /**
+     * @brief Write Array items in range `[from,to]` to binary file (see `ArrayWriter`)
+     * @param path File path (overwritten)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void save (const std::string &path, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      ArrayWriter<T> writer(path);
+      if (this->S > 0) {
+        int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+        this->checkRange(b, e);
+        writer.write(this->A + b, e - b + 1);
+      }
+      writer.close();
+    }
+    // Non-accessible and accessible subscripts (Negative indexing supported)
+    // Non-const subscript may be used for writing, so it forgets that the Array is sorted
+    T& operator[] (int index) {
+      this->order = 0;
+      return A[idx(index)];
+    }
+    T operator[] (int index) const {return A[idx(index)];}
+    // Multi-index subscript operator (read-only)
+    template <class IndexAlloc>
+    Array operator[] (const Array<int, IndexAlloc> &index) const {
+      Array X;
+      X.reserve(index.size());
+      for (int i = 0; i < index.size(); i++) {
+        X.append(this->A[idx(index[i])]);
+      }
+      return X;
+    }
+    Array operator[] (const std::vector <int> &index) const { return this->operator[](Array<int, Alloc>::fromVector(index)); }
+    Array operator[] (const std::list <int> &index) const { return this->operator[](Array<int, Alloc>::fromList(index)); }
+    Array operator[] (const std::set <int> &index) const { return this->operator[](Array<int, Alloc>::fromSet(index)); }
+    Array operator[] (const std::initializer_list <int> &index) const { return this->operator[](Array<int, Alloc>::fromInitList(index)); }
+    // Boolean mask subscript operator (read-only), same as `compress(mask)` (e.g. `a[a > 0]`)
+    template <class MaskAlloc>
+    Array operator[] (const Array<bool, MaskAlloc> &mask) const { return this->compress(mask); }
+    template <class E>
+    Array operator[] (const ArrayExpr<E> &mask) const { return this->compress(mask); }
+
+    /**
+     * @brief Append `elem` to the end of Array
+     * @param elem 
+     */
+    void append (const T& elem) {
+      int newSize = this->S + 1;
+      checkSize(newSize);
+      this->order = 0;
+      if (newSize > this->C) {
+        T copy = elem; // `elem` may live inside this Array
+        this->grow(newSize);
+        this->A[newSize - 1] = copy;
+      } else this->A[newSize - 1] = elem;
+      this->S++;
+    }
+    /**
+     * @brief Append `array` to the end of Array
+     * @param array 
+     */
+    void append (const Array& array) {
+      if (array.size() == 0) return;
+      int newSize = this->S + array.size();
+      checkSize(newSize);
+      if (&array == this) {
+        Array copy = array;
+        this->append(copy);
+        return;
+      }
+      this->grow(newSize);
+      this->order = 0;
+      for (int i = 0; i < array.size(); i++) this->A[this->S + i] = array.A[i];
+      this->S += array.size();
+    }
+    void append (const std::vector < T > &STL_Vector) { append(fromVector(STL_Vector)); }
+    void append (const std::list < T > &STL_List) { append(fromList(STL_List)); }
+    void append (const std::set < T > &STL_Set) { append(fromSet(STL_Set)); }
+    void append (std::initializer_list<T> InitValues) { append(fromInitList(InitValues)); }
+    void append (T* ptr, int size) { append(fromPointer(ptr, size)); }
+
+    /**
+     * @brief Insert `elem` into Array at specific `index`
+     * @param elem 
+     * @param index Default 0
+     */
+    void insert (const T& elem, int index = ARRAY_BEGIN) {
+      int newSize = this->S + 1;
+      checkSize(newSize);
+      int i_idx = idx(index);
+      T copy = elem; // `elem` may live inside this Array
+      this->grow(newSize);
+      this->order = 0;
+      for (int i = newSize - 1; i > i_idx; i--) this->A[i] = this->A[i - 1];
+      this->A[i_idx] = copy;
+      this->S++;
+    }
+    /**
+     * @brief Insert `array` into Array at specific `index`
+     * @param array 
+     * @param index Default 0
+     */
+    void insert (const Array& array, int index = ARRAY_BEGIN) {
+      if (array.size() == 0) return;
+      int newSize = this->S + array.size();
+      checkSize(newSize);
+      int i_idx = idx(index);
+      if (&array == this) {
+        Array copy = array;
+        this->insert(copy, index);
+        return;
+      }
+      this->grow(newSize);
+      this->order = 0;
+      for (int i = newSize - 1; i >= i_idx + array.size(); i--) this->A[i] = this->A[i - array.size()];
+      for (int i = 0; i < array.size(); i++) this->A[i_idx + i] = array.A[i];
+      this->S += array.size();
+    }
+    void insert (const std::vector < T > &STL_Vector, int index = ARRAY_BEGIN) { insert(fromVector(STL_Vector), index); }
+    void insert (const std::list < T > &STL_List, int index = ARRAY_BEGIN) { insert(fromList(STL_List), index); }
+    void insert (const std::set < T > &STL_Set, int index = ARRAY_BEGIN) { insert(fromSet(STL_Set), index); }
+    void insert (std::initializer_list<T> InitValues, int index = ARRAY_BEGIN) { insert(fromInitList(InitValues), index); }
+    void insert (T* ptr, int size, int index = ARRAY_BEGIN) { insert(fromPointer(ptr, size), index); }
+
+    /**
+     * @brief Delete n = `count` Array elements starting from `index` (fewer if the Array ends before)
+     * @param index Default 0
+     * @param count Default 1
+     */
+    void erase (int index = ARRAY_BEGIN, int count = 1) {
+      if (this->S == 0 || count <= 0) return;
+      int e_idx = idx(index);
+      int c_count = count > this->S - e_idx ? this->S - e_idx : count;
+      int newSize = this->S - c_count;
+      checkSize(newSize);
+      if (newSize == 0 || e_idx + c_count >= this->S) {
+        this->S = newSize;
+        return;
+      }
+      for (int i = e_idx + count; i < this->S; i++) this->A[i - count] = this->A[i];
+      this->S = newSize;
+    }
+
+    /**
+     * @brief Fill the Array with `elem` in range `[from,to]`
+     * @param elem 
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void fill (const T& elem, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S == 0) return;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      this->order = 0;
+      for (int i = b; i <= e; i++) this->A[i] = elem;
+    }
+
+    /**
+     * @brief Fill the Array with specific `pattern` in range `[from,to]`
+     * @param pattern Array Pattern
+     * @param mode `'r'` - Repeating (default) - repeats pattern values if pattern is smaller than fill range.
+     * `'s'` - Stretch - copies pattern values to match fill range length
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void fill (const Array& pattern, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S == 0 || pattern.size() == 0) return;
+      if (pattern.size() == 1) {
+        this->fill(pattern[0], from, to);
+        return;
+      }
+      if (mode != 'r' && mode != 's') throw std::invalid_argument("Mode should be s - stretch or r - repeat");
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      this->order = 0;
+      if (mode == 'r') {
+        for (int i = b; i <= e; i++) this->A[i] = pattern[(i - b) % pattern.size()];
+        return;
+      }
+      for (int i = b; i <= e; i++) {
+        int index = (int) floor((i - b) * pattern.size() / (e - b + 1.0));
+        this->A[i] = pattern[index];
+      }
+    }
+    void fill (const std::vector < T > &pattern, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) { fill(fromVector(pattern), mode, from, to); }
+    void fill (const std::list < T > &pattern, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) { fill(fromList(pattern), mode, from, to); }
+    void fill (const std::set < T > &pattern, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) { fill(fromSet(pattern), mode, from, to); }
+    void fill (std::initializer_list<T> pattern, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) { fill(fromInitList(pattern), mode, from, to); }
+    void fill (T* pattern, int size, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) { fill(fromPointer(pattern, size), mode, from, to); }
+
+    /**
+     * @brief Reverse `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void reverse (int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S == 0) return;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      // Reversing the whole Array swaps a known order
+      if (b == 0 && e == this->S - 1 && this->order != 0) this->order = this->order == 'a' ? 'd' : 'a';
+      else this->order = 0;
+      for (int i = b; i < (e + b + 1) / 2; i++) {
+        T temp = this->A[i];
+        this->A[i] = this->A[e - i + b];
+        this->A[e - i + b] = temp;
+      }
+    }
+
+    /**
+     * @brief Remove all elements of the `Array`. Allocated capacity is kept for reuse
+     */
+    void clear () {
+      this->S = 0;
+    }
+
+    /**
+     * @brief Resize the `Array` into specified size.
+     * @warning Resizing array into smaller size will remove the data which is out of bounds. Resizing to `0` removes data completely
+     * @param size New Size
+     */
+    void resize (int size) {
+      checkSize(size);
+      if (size > this->C) this->reallocate(size);
+      if (size > this->S) {
+        memset((void*) (this->A + this->S), 0, (size - this->S) * sizeof(T));
+        this->order = 0;
+      }
+      this->S = size;
+    }
+
+    /**
+     * @brief Shift `Array` items in range `[from,to]` by specified `amount`
+     * @param amount Shift amount. If negative, it shifts to the left
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void shift (int amount, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S == 0 || amount == 0) return;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (amount % len == 0 || len <= 1) return;
+      this->order = 0;
+      Array temp = *this;
+      for (int i = b; i <= e; i++) {
+        int destIndex = b + ((i + amount - b) % len);
+        if (destIndex < b) destIndex = len + ((i + amount) % len);
+        this->A[destIndex] = temp[i];
+      }
+    }
+
+    /**
+     * @brief Replace all `Array` items in range `[from,to]`, which are `searchElem` with value of `replaceWith`
+     * @param searchElem Search Element
+     * @param replaceWith Replace Value
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void replace (const T& searchElem, const T& replaceWith, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S == 0) return;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      this->order = 0;
+      for (int i = b; i <= e; i++) {
+        if (this->A[i] == searchElem) this->A[i] = replaceWith;
+      }
+    }
+
+    /**
+     * @brief Sort `Array` items in range `[from,to]`. Uses LSD radix sort for 32/64-bit integer and floating types,
+     * introsort (quicksort + heapsort fallback + insertion sort) otherwise
+     * 
+     * @param ascending Default `true`. `false` = descending order
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void sort (bool ascending = true, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S <= 1) { this->order = this->sortedOrder(ascending); return; }
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = (e - b + 1);
+      if (len <= 1) return;
+      array_detail::sortRange(this->A + b, len, ascending);
+      this->order = len == this->S ? this->sortedOrder(ascending) : 0;
+    }
+    /**
+     * @brief Sort `Array` items in range `[from,to]` on `ArrayThreadPool::shared()` (parallel merge sort).
+     * Ranges shorter than `2 * policy.grain` are sorted serially
+     * @param policy Execution policy
+     * @param ascending Default `true`. `false` = descending order
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void sort (const ArrayPolicy &policy, bool ascending = true, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S <= 1) { this->order = this->sortedOrder(ascending); return; }
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = (e - b + 1);
+      if (len <= 1) return;
+      array_detail::parallelSort(this->A + b, len, ascending, policy);
+      this->order = len == this->S ? this->sortedOrder(ascending) : 0;
+    }
+    /**
+     * @brief Same as `sort(ArrayPolicy(threads), ascending, from, to)`
+     * @param threads Max number of threads. Default `0` = all hardware threads
+     * @param ascending Default `true`. `false` = descending order
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void sortParallel (int threads = 0, bool ascending = true, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      this->sort(ArrayPolicy(threads), ascending, from, to);
+    }
+    /**
+     * @brief Returns `Array` with sorted items in range `[from,to]` (see `sort`). 
+     * Does not modify initial `Array`
+     * @param ascending Default `true`. `false` = descending order
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<T> 
+     */
+    Array toSorted (bool ascending = true, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      Array X = *this;
+      if (this->S <= 1) { X.order = X.sortedOrder(ascending); return X; }
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = (e - b + 1);
+      if (len <= 1) return X;
+      array_detail::sortRange(X.A + b, len, ascending);
+      X.order = len == X.S ? X.sortedOrder(ascending) : 0;
+      return X;
+    }
+    /**
+     * @brief Returns `Array` with items in range `[from,to]` sorted in parallel (see `sort(policy, ...)`).
+     * Does not modify initial `Array`
+     * @param policy Execution policy
+     * @param ascending Default `true`. `false` = descending order
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<T> 
+     */
+    Array toSorted (const ArrayPolicy &policy, bool ascending = true, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      Array X = *this;
+      X.sort(policy, ascending, from, to);
+      return X;
+    }
+
+    /**
+     * @brief Check if `Array` items in range `[from,to]` contain `elem`
+     * @param elem Search element
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return true - Element found,
+     * @return false - Element not found
+     */
+    bool contains (const T& elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return false;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int lo, hi;
+      if (this->equalRange(elem, b, e, lo, hi)) return lo < hi;
+      for (int i = b; i <= e; i++) {
+        if (this->A[i] == elem) return true;
+      }
+      return false;
+    }
+
+    /**
+     * @brief Check if `Array` items in range `[from,to]` contain a `pattern`
+     * @param pattern Search pattern
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return true - Pattern found,
+     * @return false - Pattern not found
+     */
+    bool contains (const Array& pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0 || pattern.size() > this->S) return false;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      if (pattern.size() == 0) throw std::invalid_argument("Empty search pattern");
+      array_detail::PatternSearch<T> search(pattern.A, pattern.S);
+      return search.next(this->A, b, e + 1) != -1;
+    }
+    bool contains (const std::vector < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return contains(fromVector(pattern), from, to); }
+    bool contains (const std::list < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return contains(fromList(pattern), from, to); }
+    bool contains (const std::set < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return contains(fromSet(pattern), from, to); }
+    bool contains (std::initializer_list<T> pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return contains(fromInitList(pattern), from, to); }
+    bool contains (T* pattern, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return contains(fromPointer(pattern, size), from, to); }
+
+    /**
+     * @brief Count how many `elems` exist in an `Array` in range `[from,to]`
+     * @param elem Search element
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return int - Successful search count
+     */
+    int count (const T& elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int lo, hi;
+      if (this->equalRange(elem, b, e, lo, hi)) return hi - lo;
+      int cnt = 0;
+      for (int i = b; i <= e; i++) {
+        if (this->A[i] == elem) cnt++;
+      }
+      return cnt;
+    }
+
+    /**
+     * @brief Count how many `patterns` exist in an `Array` in range `[from,to]` (non-overlapping, scanning left to right)
+     * @param pattern Search pattern (sub-array)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return int - Successful search count
+     */
+    int count (const Array& pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0 || pattern.size() > this->S) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      if (pattern.size() == 0) throw std::invalid_argument("Empty search pattern");
+      array_detail::PatternSearch<T> search(pattern.A, pattern.S);
+      int cnt = 0;
+      for (int i = search.next(this->A, b, e + 1); i != -1; i = search.next(this->A, i + pattern.S, e + 1)) cnt++;
+      return cnt;
+    }
+    int count (const std::vector < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return count(fromVector(pattern), from, to); }
+    int count (const std::list < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return count(fromList(pattern), from, to); }
+    int count (const std::set < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return count(fromSet(pattern), from, to); }
+    int count (std::initializer_list<T> pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return count(fromInitList(pattern), from, to); }
+    int count (T* pattern, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return count(fromPointer(pattern, size), from, to); }
+
+    /**
+     * @brief Find first index of search `elem` in range `[from,to]`. Returns `-1` if none found
+     * @param elem Search element
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return int - Found index or `-1`
+     */
+    int find (const T& elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return -1;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int lo, hi;
+      if (this->equalRange(elem, b, e, lo, hi)) return lo < hi ? lo : -1;
+      for (int i = b; i <= e; i++) {
+        if (this->A[i] == elem) return i;
+      }
+      return -1;
+    }
+
+    /**
+     * @brief Find first index of search `pattern` in range `[from,to]`. Returns `-1` if none found
+     * @param pattern Search pattern
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return int - Start index of found pattern or `-1`
+     */
+    int find (const Array& pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0 || pattern.size() > this->S) return -1;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      if (pattern.size() == 0) throw std::invalid_argument("Empty search pattern");
+      array_detail::PatternSearch<T> search(pattern.A, pattern.S);
+      return search.next(this->A, b, e + 1);
+    }
+    int find (const std::vector < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return find(fromVector(pattern), from, to); }
+    int find (const std::list < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return find(fromList(pattern), from, to); }
+    int find (const std::set < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return find(fromSet(pattern), from, to); }
+    int find (std::initializer_list<T> pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return find(fromInitList(pattern), from, to); }
+    int find (T* pattern, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return find(fromPointer(pattern, size), from, to); }
+
+    /**
+     * @brief Find all indices of search `elem` in range `[from,to]`. Returns empty Array if none found
+     * @param elem Search element
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<int> - Array of indices
+     */
+    Array<int, Alloc> findAll (const T& elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      Array<int, Alloc> X;
+      if (this->S == 0) return X;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int lo, hi;
+      if (this->equalRange(elem, b, e, lo, hi)) {
+        X.sizeAlloc(hi - lo);
+        for (int i = lo; i < hi; i++) X.A[i - lo] = i;
+        X.order = 'a';
+        return X;
+      }
+      for (int i = b; i <= e; i++) {
+        if (this->A[i] == elem) X.append(i);
+      }
+      return X;
+    }
+
+    /**
+     * @brief Check if `Array` items in range `[from,to]` are sorted. O(1) when the Array is known to be sorted
+     * (after `sort` of the whole Array and no changes since), linear scan otherwise.
+     * `find`, `contains`, `count` and `findAll` of an element use binary search on known sorted Arrays
+     * @param ascending Default `true`. `false` = descending order
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return true - Items are sorted,
+     * @return false - Items are not sorted
+     */
+    bool isSorted (bool ascending = true, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return true;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      if (this->order == (ascending ? 'a' : 'd')) return true;
+      for (int i = b; i < e; i++) {
+        if (ascending ? this->A[i + 1] < this->A[i] : this->A[i] < this->A[i + 1]) return false;
+      }
+      return true;
+    }
+
+    /**
+     * @brief Find indices where `values` should be inserted to keep the Array sorted (same as numpy `searchsorted`).
+     * The Array has to be sorted ascending, or descending if it is known to be (after `sort(false)`).
+     * A batch of sorted `values` is located in a single galloping merge walk, other batches by binary search
+     * @param values Searched values
+     * @param side `l` - first suitable index (Default), `r` - last suitable index
+     * @return Array<int> - insertion index of each value
+     */
+    template <class ValuesAlloc>
+    Array<int, Alloc> searchsorted (const Array<T, ValuesAlloc> &values, char side = 'l') const {
+      if (side != 'l' && side != 'r') throw std::invalid_argument("Side should be l - left or r - right");
+      Array<int, Alloc> X;
+      X.sizeAlloc(values.S);
+      if (this->order == 'd') this->searchSortedInto(values.A, values.S, side == 'r', X.A, array_detail::Descending<T>());
+      else this->searchSortedInto(values.A, values.S, side == 'r', X.A, array_detail::Ascending<T>());
+      return X;
+    }
+    Array<int, Alloc> searchsorted (const std::vector < T > &values, char side = 'l') const { return searchsorted(fromVector(values), side); }
+    Array<int, Alloc> searchsorted (const std::list < T > &values, char side = 'l') const { return searchsorted(fromList(values), side); }
+    Array<int, Alloc> searchsorted (const std::set < T > &values, char side = 'l') const { return searchsorted(fromSet(values), side); }
+    Array<int, Alloc> searchsorted (std::initializer_list<T> values, char side = 'l') const { return searchsorted(fromInitList(values), side); }
+    Array<int, Alloc> searchsorted (T* values, int size, char side = 'l') const { return searchsorted(fromPointer(values, size), side); }
+    /**
+     * @brief Find index where `value` should be inserted to keep the Array sorted (see `searchsorted(values, side)`)
+     * @param value Searched value
+     * @param side `l` - first suitable index (Default), `r` - last suitable index
+     * @return int - insertion index
+     */
+    int searchsorted (const T& value, char side = 'l') const {
+      if (side != 'l' && side != 'r') throw std::invalid_argument("Side should be l - left or r - right");
+      if (this->order == 'd') {
+        if (side == 'r') return array_detail::upperBound(this->A, 0, this->S, value, array_detail::Descending<T>());
+        return array_detail::lowerBound(this->A, 0, this->S, value, array_detail::Descending<T>());
+      }
+      if (side == 'r') return array_detail::upperBound(this->A, 0, this->S, value, array_detail::Ascending<T>());
+      return array_detail::lowerBound(this->A, 0, this->S, value, array_detail::Ascending<T>());
+    }
+
+    /**
+     * @brief Find all indices of search `pattern` in range `[from,to]` (non-overlapping, scanning left to right). Returns empty Array if none found
+     * @param pattern Search pattern
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<int> - Starting indices of each pattern found
+     */
+    Array<int, Alloc> findAll (const Array& pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      Array<int, Alloc> X;
+      if (this->S == 0 || pattern.size() > this->S) return X;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      if (pattern.size() == 0) throw std::invalid_argument("Empty search pattern");
+      array_detail::PatternSearch<T> search(pattern.A, pattern.S);
+      for (int i = search.next(this->A, b, e + 1); i != -1; i = search.next(this->A, i + pattern.S, e + 1)) X.append(i);
+      return X;
+    }
+    Array<int, Alloc> findAll (const std::vector < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return findAll(fromVector(pattern), from, to); }
+    Array<int, Alloc> findAll (const std::list < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return findAll(fromList(pattern), from, to); }
+    Array<int, Alloc> findAll (const std::set < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return findAll(fromSet(pattern), from, to); }
+    Array<int, Alloc> findAll (std::initializer_list<T> pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return findAll(fromInitList(pattern), from, to); }
+    Array<int, Alloc> findAll (T* pattern, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return findAll(fromPointer(pattern, size), from, to); }
+
+    /**
+     * @brief Find every match of every pattern in range `[from,to]` in a single pass (overlapping matches included). Returns empty Array if none found
+     * @param patterns Compiled pattern set (reusable between searches)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<PatternMatch> - `(pattern, index)` pairs in order of match end
+     */
+    Array<PatternMatch, Alloc> findAllMulti (const PatternSet<T> &patterns, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      Array<PatternMatch, Alloc> X;
+      if (this->S == 0) return X;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      patterns.scan(this->A + b, e - b + 1, b, [&X](int pattern, int index) {
+        PatternMatch match = { pattern, index };
+        X.append(match);
+      });
+      return X;
+    }
+    Array<PatternMatch, Alloc> findAllMulti (std::initializer_list<std::initializer_list<T>> patterns, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      return findAllMulti(PatternSet<T>(patterns), from, to);
+    }
+
+    /**
+     * @brief Get slice of the Array using `from` and `to` index
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return `Array<T>` Array Slice
+     */
+    Array slice(int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      Array X;
+      if (this->S == 0) return X;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int s_size = e - b + 1;
+      X.sizeAlloc(s_size);
+      for (int i = 0; i < s_size; i++) X[i] = this->A[b + i];
+      return X;
+    }
+
+    /**
+     * @brief Get zero-copy read-only view of the Array using `from` and `to` index and optional `step`
+     * @warning View is invalidated when this Array reallocates (`append`, `insert`, `reserve`, ...) or is destroyed
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @param step Distance between viewed elements. Default 1
+     * @return `ArrayView<T>` View of elements `from, from + step, ...` up to `to`
+     */
+    ArrayView<T> view (int from = ARRAY_BEGIN, int to = ARRAY_END, int step = 1) const {
+      if (step < 1) throw std::invalid_argument("View step should be positive");
+      if (this->S == 0) return ArrayView<T>();
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      return ArrayView<T>(this->A + b, (e - b) / step + 1, step);
+    }
+
+    /**
+     * @brief Return `Array` with unique elements in order of their first occurrence
+     * @return Array<T> - Unique Array
+     */
+    Array unique () const {
+      Array X;
+      std::vector<int> first;
+      int groups = array_detail::groupEqual(this->A, this->S, first, nullptr, nullptr);
+      X.sizeAlloc(groups);
+      for (int g = 0; g < groups; g++) X.A[g] = this->A[first[g]];
+      return X;
+    }
+    /**
+     * @brief Return `Array` with unique elements in ascending order
+     * @return Array<T> - Sorted unique Array
+     */
+    Array sortedUnique () const {
+      Array X(*this);
+      if (X.S == 0) return X;
+      array_detail::sortRange(X.A, X.S, true);
+      int k = 1;
+      for (int i = 1; i < X.S; i++) {
+        if (!(X.A[k - 1] == X.A[i])) X.A[k++] = X.A[i];
+      }
+      X.S = k;
+      X.order = X.sortedOrder(true);
+      return X;
+    }
+    /**
+     * @brief Count occurrences of each unique element
+     * @param sorted `false` - counts follow `unique()` order (Default), `true` - counts follow `sortedUnique()` order
+     * @return Array<int> - Number of occurrences of each unique element
+     */
+    Array<int, Alloc> uniqueCounts (bool sorted = false) const {
+      std::vector<int> first, counts;
+      int groups = array_detail::groupEqual(this->A, this->S, first, nullptr, &counts);
+      Array<int, Alloc> X;
+      X.sizeAlloc(groups);
+      if (!sorted) {
+        for (int g = 0; g < groups; g++) X[g] = counts[g];
+        return X;
+      }
+      std::vector<int> rank = array_detail::groupRanks(this->A, first);
+      for (int g = 0; g < groups; g++) X[rank[g]] = counts[g];
+      return X;
+    }
+    /**
+     * @brief Index of each element in the Array of unique elements, so that `unique()[inverse[i]] == (*this)[i]`
+     * @param sorted `false` - indices into `unique()` (Default), `true` - indices into `sortedUnique()`
+     * @return Array<int> - Unique element index of each element
+     */
+    Array<int, Alloc> uniqueInverse (bool sorted = false) const {
+      Array<int, Alloc> X;
+      X.sizeAlloc(this->S);
+      std::vector<int> first;
+      array_detail::groupEqual(this->A, this->S, first, X.A, nullptr);
+      if (!sorted) return X;
+      std::vector<int> rank = array_detail::groupRanks(this->A, first);
+      for (int i = 0; i < this->S; i++) X.A[i] = rank[X.A[i]];
+      return X;
+    }
+
+    /**
+     * @brief Return `Array` with distinct elements present in this Array or in `other`
+     * @param other Second Array
+     * @param method `s` - ascending result, linear merge of sorted items (Default). Arrays that are not sorted are sorted first,
+     * `h` - result in order of first occurrence (this Array, then `other`), hash sets, no sorting
+     * @return Array<T> - Union
+     */
+    template <class OtherAlloc>
+    Array setUnion (const Array<T, OtherAlloc> &other, char method = 's') const { return setOperation(other, array_detail::SET_UNION, method); }
+    Array setUnion (const std::vector < T > &other, char method = 's') const { return setUnion(fromVector(other), method); }
+    Array setUnion (const std::list < T > &other, char method = 's') const { return setUnion(fromList(other), method); }
+    Array setUnion (const std::set < T > &other, char method = 's') const { return setUnion(fromSet(other), method); }
+    Array setUnion (std::initializer_list<T> other, char method = 's') const { return setUnion(fromInitList(other), method); }
+    Array setUnion (T* other, int size, char method = 's') const { return setUnion(fromPointer(other, size), method); }
+    /**
+     * @brief Return `Array` with distinct elements present both in this Array and in `other`.
+     * Inputs of very different sizes are intersected by galloping search, 32-bit integers with SIMD block compares
+     * @param other Second Array
+     * @param method `s` - ascending result, linear merge of sorted items (Default). Arrays that are not sorted are sorted first,
+     * `h` - result in order of first occurrence in this Array, hash sets, no sorting
+     * @return Array<T> - Intersection
+     */
+    template <class OtherAlloc>
+    Array setIntersection (const Array<T, OtherAlloc> &other, char method = 's') const { return setOperation(other, array_detail::SET_INTERSECTION, method); }
+    Array setIntersection (const std::vector < T > &other, char method = 's') const { return setIntersection(fromVector(other), method); }
+    Array setIntersection (const std::list < T > &other, char method = 's') const { return setIntersection(fromList(other), method); }
+    Array setIntersection (const std::set < T > &other, char method = 's') const { return setIntersection(fromSet(other), method); }
+    Array setIntersection (std::initializer_list<T> other, char method = 's') const { return setIntersection(fromInitList(other), method); }
+    Array setIntersection (T* other, int size, char method = 's') const { return setIntersection(fromPointer(other, size), method); }
+    /**
+     * @brief Return `Array` with distinct elements of this Array that are not present in `other`.
+     * A much larger `other` is searched by galloping search
+     * @param other Second Array
+     * @param method `s` - ascending result, linear merge of sorted items (Default). Arrays that are not sorted are sorted first,
+     * `h` - result in order of first occurrence in this Array, hash sets, no sorting
+     * @return Array<T> - Difference
+     */
+    template <class OtherAlloc>
+    Array setDifference (const Array<T, OtherAlloc> &other, char method = 's') const { return setOperation(other, array_detail::SET_DIFFERENCE, method); }
+    Array setDifference (const std::vector < T > &other, char method = 's') const { return setDifference(fromVector(other), method); }
+    Array setDifference (const std::list < T > &other, char method = 's') const { return setDifference(fromList(other), method); }
+    Array setDifference (const std::set < T > &other, char method = 's') const { return setDifference(fromSet(other), method); }
+    Array setDifference (std::initializer_list<T> other, char method = 's') const { return setDifference(fromInitList(other), method); }
+    Array setDifference (T* other, int size, char method = 's') const { return setDifference(fromPointer(other, size), method); }
+    /**
+     * @brief Return `Array` with distinct elements present in exactly one of this Array and `other`
+     * @param other Second Array
+     * @param method `s` - ascending result, linear merge of sorted items (Default). Arrays that are not sorted are sorted first,
+     * `h` - result in order of first occurrence (this Array, then `other`), hash sets, no sorting
+     * @return Array<T> - Symmetric difference
+     */
+    template <class OtherAlloc>
+    Array setSymmetricDifference (const Array<T, OtherAlloc> &other, char method = 's') const { return setOperation(other, array_detail::SET_SYMMETRIC, method); }
+    Array setSymmetricDifference (const std::vector < T > &other, char method = 's') const { return setSymmetricDifference(fromVector(other), method); }
+    Array setSymmetricDifference (const std::list < T > &other, char method = 's') const { return setSymmetricDifference(fromList(other), method); }
+    Array setSymmetricDifference (const std::set < T > &other, char method = 's') const { return setSymmetricDifference(fromSet(other), method); }
+    Array setSymmetricDifference (std::initializer_list<T> other, char method = 's') const { return setSymmetricDifference(fromInitList(other), method); }
+    Array setSymmetricDifference (T* other, int size, char method = 's') const { return setSymmetricDifference(fromPointer(other, size), method); }
+
+    /**
+     * Array functors
+     */
+
+    /**
+     * @brief Execute `func` for each element of the `Array`
+     * @param func Function to execute. Element is passed as an argument. Should return `void`.
+     */
+    void forEach (void (*func)(T elem)) const {
+      for (int i = 0; i < this->S; i++) func(this->A[i]);
+    }
+    /**
+     * @brief Execute `func` for each element of the `Array`
+     * @param func Function to execute. Arguments: element, index of an element. Should return `void`.
+     */
+    void forEach (void (*func)(T elem, int index)) const {
+      for (int i = 0; i < this->S; i++) func(this->A[i], i);
+    }
+    /**
+     * @brief Execute `func` for each element of the `Array`
+     * @param func Function to execute. Arguments: element, index of an element, array. Should return `void`.
+     */
+    void forEach (void (*func)(T elem, int index, const Array &array)) const {
+      for (int i = 0; i < this->S; i++) func(this->A[i], i, *this);
+    }
+    /**
+     * @brief Execute `func` for each element of the `Array`. Accepts any callable (capturing lambdas, functors), calls are inlined
+     * @param func Callable taking element, element and index, or element, index and array. Should return `void`.
+     */
+    template <class F>
+    void forEach (F func) const {
+      for (int i = 0; i < this->S; i++) array_detail::callElement(func, this->A[i], i, *this, array_detail::ArgsThree());
+    }
+
+    /**
+     * @brief Filters `Array` elements using `func` provided
+     * @param func Filtering function. Element is passed as an argument. Should return `bool`.
+     * @return Array<T> Filtered `Array`
+     */
+    Array filter (bool (*func)(T elem)) const { return this->filterElements(func); }
+    /**
+     * @brief Filters `Array` elements using `func` provided
+     * @param func Filtering function. Arguments: element, index of an element. Should return `bool`.
+     * @return Array<T> Filtered `Array`
+     */
+    Array filter (bool (*func)(T elem, int index)) const { return this->filterElements(func); }
+    /**
+     * @brief Filters `Array` elements using `func` provided
+     * @param func Filtering function. Arguments: element, index of an element, array. Should return `bool`.
+     * @return Array<T> Filtered `Array`
+     */
+    Array filter (bool (*func)(T elem, int index, const Array &array)) const { return this->filterElements(func); }
+    /**
+     * @brief Filters `Array` elements using `func` provided. Accepts any callable (capturing lambdas, functors), calls are inlined
+     * @param func Callable taking element, element and index, or element, index and array. Should return `bool`.
+     * @return Array<T> Filtered `Array`
+     */
+    template <class F>
+    Array filter (F func) const { return this->filterElements(func); }
+    /**
+     * @brief Return elements whose `mask` element is `true`, in original order (e.g. `a.compress(a > 0)`).
+     * Result is counted first and written into a single pre-sized `Array` by vectorized compaction
+     * @param mask Boolean mask of the same size as the Array
+     * @return Array<T> Selected elements
+     */
+    template <class MaskAlloc>
+    Array compress (const Array<bool, MaskAlloc> &mask) const {
+      if (mask.size() != this->S) throw std::invalid_argument("Mask size does not match Array size");
+      Array X;
+      int n = mask.countTrue();
+      if (n == 0) return X;
+      if (std::is_trivially_copyable<T>::value) {
+        X.reallocate(n);
+        X.S = n;
+      }
+      else X.sizeAlloc(n);
+      array_detail::compress(this->A, mask.W, this->S, X.A, n);
+      return X;
+    }
+    template <class E>
+    Array compress (const ArrayExpr<E> &mask) const {
+      static_assert(std::is_same<typename E::value_type, bool>::value, "Mask expression must be boolean");
+      return this->compress(Array<bool, Alloc>(mask));
+    }
+    /**
+     * @brief Return indices of `true` elements of `mask` (e.g. `a.where(a > 0)`)
+     * @param mask Boolean mask of the same size as the Array
+     * @return Array<int> Indices in ascending order
+     */
+    template <class MaskAlloc>
+    Array<int, Alloc> where (const Array<bool, MaskAlloc> &mask) const {
+      if (mask.size() != this->S) throw std::invalid_argument("Mask size does not match Array size");
+      Array<int, Alloc> X;
+      int n = mask.countTrue();
+      if (n == 0) return X;
+      X.reallocate(n);
+      X.S = n;
+      array_detail::maskIndices(mask.W, this->S, X.A);
+      return X;
+    }
+    template <class E>
+    Array<int, Alloc> where (const ArrayExpr<E> &mask) const {
+      static_assert(std::is_same<typename E::value_type, bool>::value, "Mask expression must be boolean");
+      return this->where(Array<bool, Alloc>(mask));
+    }
+
+    /**
+     * @brief Map `Array` elements using `func` provided
+     * @tparam U Destination `Array` type
+     * @param func Mapping function. Element is passed as an argument. Should return `U`.
+     * @return Array<U> Mapped `Array`
+     */
+    template <typename U>
+    Array<U, Alloc> map (U (*func)(T elem)) const { return this->mapElements<U>(func); }
+    /**
+     * @brief Map `Array` elements using `func` provided
+     * @tparam U Destination `Array` type
+     * @param func Mapping function. Arguments: element, index of an element. Should return `U`.
+     * @return Array<U> Mapped `Array`
+     */
+    template <typename U>
+    Array<U, Alloc> map (U (*func)(T elem, int index)) const { return this->mapElements<U>(func); }
+    /**
+     * @brief Map `Array` elements using `func` provided
+     * @tparam U Destination `Array` type
+     * @param func Mapping function. Arguments: element, index of an element, array. Should return `U`.
+     * @return Array<U> Mapped `Array`
+     */
+    template <typename U>
+    Array<U, Alloc> map (U (*func)(T elem, int index, const Array &array)) const { return this->mapElements<U>(func); }
+    /**
+     * @brief Map `Array` elements using `func` provided. Accepts any callable (capturing lambdas, functors), calls are inlined
+     * @tparam U Destination `Array` type. Default: result type of `func`
+     * @param func Callable taking element, element and index, or element, index and array. Should return `U`.
+     * @return Array<U> Mapped `Array`
+     */
+    template <typename U = void, class F>
+    Array<typename array_detail::MapType<U, F, T, Array>::type, Alloc> map (F func) const {
+      return this->mapElements<typename array_detail::MapType<U, F, T, Array>::type>(func);
+    }
+
+    /*
+     * Parallel functors (chunks processed on `ArrayThreadPool::shared()`). `func` is called concurrently, so it should be thread-safe
+     */
+
+    /**
+     * @brief Execute `func` for each element of the `Array` in parallel. Order of calls is unspecified
+     * @param policy Execution policy
+     * @param func Callable taking element, element and index, or element, index and array. Should return `void`.
+     */
+    template <class F>
+    void forEach (const ArrayPolicy &policy, F func) const {
+      int tasks = policy.tasks(this->S);
+      if (tasks <= 1) return this->forEach(func);
+      array_detail::parallelChunks(0, this->S - 1, tasks, [&] (int, int lo, int hi) {
+        for (int i = lo; i <= hi; i++) array_detail::callElement(func, this->A[i], i, *this, array_detail::ArgsThree());
+      });
+    }
+    /**
+     * @brief Filters `Array` elements using `func` in parallel. Every chunk evaluates and counts its elements,
+     * an exclusive prefix sum of the counts gives each chunk its output offset, then kept elements are scattered.
+     * Result is the same as for the serial `filter`
+     * @param policy Execution policy
+     * @param func Callable taking element, element and index, or element, index and array. Should return `bool`.
+     * @return Array<T> Filtered `Array`
+     */
+    template <class F>
+    Array filter (const ArrayPolicy &policy, F func) const {
+      int tasks = policy.tasks(this->S);
+      if (tasks <= 1) return this->filterElements(func);
+      std::vector<unsigned char> keep(this->S);
+      std::vector<int> offset(tasks + 1, 0);
+      array_detail::parallelChunks(0, this->S - 1, tasks, [&] (int c, int lo, int hi) {
+        int k = 0;
+        for (int i = lo; i <= hi; i++) {
+          keep[i] = array_detail::callElement(func, this->A[i], i, *this, array_detail::ArgsThree()) ? 1 : 0;
+          k += keep[i];
+        }
+        offset[c + 1] = k;
+      });
+      for (int c = 0; c < tasks; c++) offset[c + 1] += offset[c];
+      Array X;
+      int n = offset[tasks];
+      if (n == 0) return X;
+      if (std::is_trivially_copyable<T>::value) {
+        X.reallocate(n);
+        X.S = n;
+      }
+      else X.sizeAlloc(n);
+      array_detail::parallelChunks(0, this->S - 1, tasks, [&] (int c, int lo, int hi) {
+        T* out = X.A + offset[c];
+        for (int i = lo; i <= hi; i++) {
+          if (keep[i]) *out++ = this->A[i];
+        }
+      });
+      return X;
+    }
+    /**
+     * @brief Map `Array` elements using `func` in parallel. Results are written directly into a pre-sized `Array`
+     * @tparam U Destination `Array` type. Default: result type of `func`
+     * @param policy Execution policy
+     * @param func Callable taking element, element and index, or element, index and array. Should return `U`.
+     * @return Array<U> Mapped `Array`
+     */
+    template <typename U = void, class F>
+    Array<typename array_detail::MapType<U, F, T, Array>::type, Alloc> map (const ArrayPolicy &policy, F func) const {
+      typedef typename array_detail::MapType<U, F, T, Array>::type R;
+      int tasks = policy.tasks(this->S);
+      if (tasks <= 1) return this->mapElements<R>(func);
+      Array<R, Alloc> X;
+      X.sizeAlloc(this->S);
+      // Chunks start at multiples of 64, so no two tasks write the same word of a packed `Array<bool>`
+      ArrayThreadPool::shared().run(tasks, [&] (int c) {
+        int lo = (int) (((long long) this->S * c / tasks) & ~63LL);
+        int hi = c + 1 == tasks ? this->S : (int) (((long long) this->S * (c + 1) / tasks) & ~63LL);
+        for (int i = lo; i < hi; i++) X.put(i, array_detail::callElement(func, this->A[i], i, *this, array_detail::ArgsThree()));
+      });
+      return X;
+    }
+
+    /*
+     * Converters
+     */
+
+    /**
+     * @brief Return `Array` in different type `U`
+     * @tparam U Destination `Array` type
+     * @return Array<U> Re-typed `Array`
+     */
+    template <typename U>
+    Array<U, Alloc> astype () {
+      Array<U, Alloc> X;
+      X.sizeAlloc(this->S);
+      for (int i = 0; i < this->S; i++) X.put(i, (U) (this->A[i]));
+      return X;
+    }
+    
+    /**
+     * @brief Convert `Array` to `std::vector`
+     * @return std::vector<T> 
+     */
+    std::vector<T> toVector () {
+      std::vector<T> vec;
+      for (int i = 0; i < this->S; i++) vec.push_back(this->A[i]);
+      return vec;
+    }
+
+    /**
+     * @brief Convert `Array` to `std::list`
+     * @return std::list<T> 
+     */
+    std::list<T> toList () {
+      std::list<T> lst;
+      for (int i = 0; i < this->S; i++) lst.push_back(this->A[i]);
+      return lst;
+    }
+
+    /**
+     * @brief Convert `Array` to `std::set`
+     * @return std::set<T> 
+     */
+    std::set<T> toSet () {
+      std::set<T> st;
+      for (int i = 0; i < this->S; i++) st.insert(this->A[i]);
+      return st;
+    }
+
+    /**
+     * Methods for number arrays only
+     */
+
+    /**
+     * @brief Get min value of `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return T - min value
+     */
+    T min (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len == 0) return 0;
+      T minV = this->A[b];
+      for (int i = b + 1; i <= e; i++) {
+        if (this->A[i] < minV) minV = this->A[i];
+      }
+      return minV;
+    }
+
+    /**
+     * @brief Get max value of `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return T - max value
+     */
+    T max (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len == 0) return 0;
+      T maxV = this->A[b];
+      for (int i = b + 1; i <= e; i++) {
+        if (this->A[i] > maxV) maxV = this->A[i];
+      }
+      return maxV;
+    }
+
+    /**
+     * @brief Get indices of min values of `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<int> - min values' indices
+     */
+    Array<int, Alloc> argmin (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      Array<int, Alloc> X;
+      if (this->S == 0) return X;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len == 0) return X;
+      this->argminInto(X, b, e);
+      return X;
+    }
+
+    /**
+     * @brief Get indices of max values of `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<int> - max values' indices
+     */
+    Array<int, Alloc> argmax (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      Array<int, Alloc> X;
+      if (this->S == 0) return X;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len == 0) return X;
+      this->argmaxInto(X, b, e);
+      return X;
+    }
+
+    /**
+     * @brief Get Sum of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return T - sum
+     */
+    T sum (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len == 0) return 0;
+      T s = 0;
+      for (int i = b; i <= e; i++) s += this->A[i];
+      return s;
+    }
+
+    /**
+     * @brief Get Product of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return T - product
+     */
+    T product (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len == 0) return 0;
+      T p = 1;
+      for (int i = b; i <= e; i++) {
+        p *= this->A[i];
+        if (p == 0) return 0;
+      }
+      return p;
+    }
+
+    /**
+     * @brief Get Arithmetic Mean of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - arithmetic mean
+     */
+    double mean (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len == 0) return 0;
+      return (this->sum(b, e) * 1.0) / (len * 1.0);
+    }
+
+    /**
+     * @brief Get Geometric Mean of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - geometric mean
+     */
+    double meanG (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len == 0) return 0;
+      return pow(this->product(b, e) * 1.0, 1.0 / (len * 1.0));
+    }
+
+    /**
+     * @brief Get Harmonic Mean of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - harmonic mean
+     */
+    double meanH (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len == 0) return 0;
+      double rs = 0.0;
+      for (int i = b; i <= e; i++) rs += (1.0 / (1.0 * this->A[i]));
+      return (len * 1.0) / rs;
+    }
+
+    /**
+     * @brief Get Weighted Mean of the `Array` items in range `[from,to]` using `weights` array
+     * @param weights Weights Array. If shorter than `[from,to]` range, weights for remaining elements will be `0`.
+     * If longer than `[from,to]` range, remaining weights will not be used.
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - Weighted mean
+     */
+    double weightedMean (Array<double> weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0 || weights.size() == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len == 0) return 0;
+      double s = 0.0, ws = 0.0;
+      for (int i = b; i <= e; i++) {
+        int wIdx = i - b;
+        if (wIdx >= weights.size()) break;
+        s += (this->A[i] * weights[wIdx]);
+        ws += weights[wIdx];
+      }
+      return s / ws;
+    }
+    double weightedMean (const std::vector < double > &weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromVector(weights), from, to); }
+    double weightedMean (const std::list < double > &weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromList(weights), from, to); }
+    double weightedMean (const std::set < double > &weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromSet(weights), from, to); }
+    double weightedMean (std::initializer_list<double> weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromInitList(weights), from, to); }
+    double weightedMean (double* weights, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromPointer(weights, size), from, to); }
+
+    /**
+     * @brief Get sample Variance of the `Array` items in range `[from,to]` (normalized by the range length - 1)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - variance
+     */
+    double variance (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len <= 1) return 0;
+      double m = this->mean(b, e), s = 0.0;
+      for (int i = b; i <= e; i++) { s += pow(this->A[i] - m, 2.0); }
+      return s / (len - 1.0);
+    }
+
+    /**
+     * @brief Get Standard Deviation of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - standard deviation
+     */
+    double stdev (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return sqrt(this->variance(from, to)); }
+
+    /*
+     * Parallel reductions (chunks processed on `ArrayThreadPool::shared()`, partial results merged in chunk order)
+     */
+
+    /**
+     * @brief Get min value of `Array` items in range `[from,to]` in parallel
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return T - min value
+     */
+    T min (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int tasks = policy.tasks(e - b + 1);
+      if (tasks <= 1) return this->min(b, e);
+      std::vector<T> partial(tasks);
+      array_detail::parallelChunks(b, e, tasks, [&] (int c, int lo, int hi) { partial[c] = this->min(lo, hi); });
+      T minV = partial[0];
+      for (int c = 1; c < tasks; c++) if (partial[c] < minV) minV = partial[c];
+      return minV;
+    }
+
+    /**
+     * @brief Get max value of `Array` items in range `[from,to]` in parallel
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return T - max value
+     */
+    T max (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int tasks = policy.tasks(e - b + 1);
+      if (tasks <= 1) return this->max(b, e);
+      std::vector<T> partial(tasks);
+      array_detail::parallelChunks(b, e, tasks, [&] (int c, int lo, int hi) { partial[c] = this->max(lo, hi); });
+      T maxV = partial[0];
+      for (int c = 1; c < tasks; c++) if (partial[c] > maxV) maxV = partial[c];
+      return maxV;
+    }
+
+    /**
+     * @brief Get indices of min values of `Array` items in range `[from,to]` in parallel.
+     * Indices are returned in ascending order, same as `argmin(from, to)`
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<int> - min values' indices
+     */
+    Array<int, Alloc> argmin (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return Array<int, Alloc>();
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int tasks = policy.tasks(e - b + 1);
+      if (tasks <= 1) return this->argmin(b, e);
+      // Partial results use the default allocator, pool threads may not have access to `Alloc` state (e.g. active `ArrayArena`)
+      std::vector<Array<int>> partial(tasks);
+      array_detail::parallelChunks(b, e, tasks, [&] (int c, int lo, int hi) { this->argminInto(partial[c], lo, hi); });
+      T minV = this->A[partial[0].A[0]];
+      for (int c = 1; c < tasks; c++) if (this->A[partial[c].A[0]] < minV) minV = this->A[partial[c].A[0]];
+      Array<int, Alloc> X;
+      for (int c = 0; c < tasks; c++) if (this->A[partial[c].A[0]] == minV) X.append(Array<int, Alloc>(partial[c]));
+      return X;
+    }
+
+    /**
+     * @brief Get indices of max values of `Array` items in range `[from,to]` in parallel.
+     * Indices are returned in ascending order, same as `argmax(from, to)`
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<int> - max values' indices
+     */
+    Array<int, Alloc> argmax (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return Array<int, Alloc>();
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int tasks = policy.tasks(e - b + 1);
+      if (tasks <= 1) return this->argmax(b, e);
+      // Partial results use the default allocator, pool threads may not have access to `Alloc` state (e.g. active `ArrayArena`)
+      std::vector<Array<int>> partial(tasks);
+      array_detail::parallelChunks(b, e, tasks, [&] (int c, int lo, int hi) { this->argmaxInto(partial[c], lo, hi); });
+      T maxV = this->A[partial[0].A[0]];
+      for (int c = 1; c < tasks; c++) if (this->A[partial[c].A[0]] > maxV) maxV = this->A[partial[c].A[0]];
+      Array<int, Alloc> X;
+      for (int c = 0; c < tasks; c++) if (this->A[partial[c].A[0]] == maxV) X.append(Array<int, Alloc>(partial[c]));
+      return X;
+    }
+
+    /**
+     * @brief Get Sum of the `Array` items in range `[from,to]` in parallel
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return T - sum
+     */
+    T sum (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int tasks = policy.tasks(e - b + 1);
+      if (tasks <= 1) return this->sum(b, e);
+      std::vector<T> partial(tasks);
+      array_detail::parallelChunks(b, e, tasks, [&] (int c, int lo, int hi) { partial[c] = this->sum(lo, hi); });
+      T s = 0;
+      for (int c = 0; c < tasks; c++) s += partial[c];
+      return s;
+    }
+
+    /**
+     * @brief Get Product of the `Array` items in range `[from,to]` in parallel
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return T - product
+     */
+    T product (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int tasks = policy.tasks(e - b + 1);
+      if (tasks <= 1) return this->product(b, e);
+      std::vector<T> partial(tasks);
+      array_detail::parallelChunks(b, e, tasks, [&] (int c, int lo, int hi) { partial[c] = this->product(lo, hi); });
+      T p = 1;
+      for (int c = 0; c < tasks; c++) {
+        p *= partial[c];
+        if (p == 0) return 0;
+      }
+      return p;
+    }
+
+    /**
+     * @brief Get Arithmetic Mean of the `Array` items in range `[from,to]` in parallel
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - arithmetic mean
+     */
+    double mean (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      return (this->sum(policy, b, e) * 1.0) / (len * 1.0);
+    }
+
+    /**
+     * @brief Get Variance of the `Array` items in range `[from,to]` in parallel. Each chunk runs Welford's algorithm,
+     * chunk results are merged pairwise. Normalized the same way as `variance(from, to)`
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - variance
+     */
+    double variance (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (len <= 1) return 0;
+      int tasks = policy.tasks(len);
+      if (tasks <= 1) return this->variance(b, e);
+      std::vector<array_detail::Moments> partial(tasks);
+      array_detail::parallelChunks(b, e, tasks, [&] (int c, int lo, int hi) {
+        array_detail::Moments mo;
+        for (int i = lo; i <= hi; i++) mo.add((double) this->A[i]);
+        partial[c] = mo;
+      });
+      array_detail::Moments total;
+      for (int c = 0; c < tasks; c++) total.merge(partial[c]);
+      return total.m2 / (len - 1.0);
+    }
+
+    /**
+     * @brief Get Standard Deviation of the `Array` items in range `[from,to]` in parallel
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - standard deviation
+     */
+    double stdev (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return sqrt(this->variance(policy, from, to)); }
+
+    /*
+     * Moving window statistics (O(n) in total, independent of `window`)
+     */
+
+    /**
+     * @brief Get sums of consecutive windows of `window` items
+     * @param window Window length
+     * @param step Distance between starts of consecutive windows. Default 1
+     * @param edge `v` - valid: only full windows `[i, i + window - 1]` for `i = 0, step, ...` (Default),
+     * `p` - partial: result `k` covers `[k * step - window + 1, k * step]` clipped to the Array, so windows at the beginning are shorter
+     * @return Array<T> - sum of each window
+     */
+    Array<T, Alloc> movingSum (int window, int step = 1, char edge = 'v') const {
+      array_detail::MovingSum<T> acc(this->A, window);
+      return this->slide<T>(window, step, edge, acc);
+    }
+
+    /**
+     * @brief Get arithmetic means of consecutive windows of `window` items
+     * @param window Window length
+     * @param step Distance between starts of consecutive windows. Default 1
+     * @param edge `v` - only full windows (Default), `p` - also shorter windows at the beginning (see `movingSum`)
+     * @return Array<double> - arithmetic mean of each window
+     */
+    Array<double, Alloc> movingMean (int window, int step = 1, char edge = 'v') const {
+      array_detail::MovingMean<T> acc(this->A, window);
+      return this->slide<double>(window, step, edge, acc);
+    }
+
+    /**
+     * @brief Get min values of consecutive windows of `window` items
+     * @param window Window length
+     * @param step Distance between starts of consecutive windows. Default 1
+     * @param edge `v` - only full windows (Default), `p` - also shorter windows at the beginning (see `movingSum`)
+     * @return Array<T> - min value of each window
+     */
+    Array<T, Alloc> movingMin (int window, int step = 1, char edge = 'v') const {
+      // Windows longer than the Array never leave its first block
+      array_detail::MovingExtreme<T, array_detail::Ascending<T>> acc(this->A, window < this->S ? window : this->S);
+      return this->slide<T>(window, step, edge, acc);
+    }
+
+    /**
+     * @brief Get max values of consecutive windows of `window` items
+     * @param window Window length
+     * @param step Distance between starts of consecutive windows. Default 1
+     * @param edge `v` - only full windows (Default), `p` - also shorter windows at the beginning (see `movingSum`)
+     * @return Array<T> - max value of each window
+     */
+    Array<T, Alloc> movingMax (int window, int step = 1, char edge = 'v') const {
+      // Windows longer than the Array never leave its first block
+      array_detail::MovingExtreme<T, array_detail::Descending<T>> acc(this->A, window < this->S ? window : this->S);
+      return this->slide<T>(window, step, edge, acc);
+    }
+
+    /**
+     * @brief Get sample variances of consecutive windows of `window` items (`0` for windows of 1 item)
+     * @param window Window length
+     * @param step Distance between starts of consecutive windows. Default 1
+     * @param edge `v` - only full windows (Default), `p` - also shorter windows at the beginning (see `movingSum`)
+     * @return Array<double> - variance of each window
+     */
+    Array<double, Alloc> movingVariance (int window, int step = 1, char edge = 'v') const {
+      array_detail::MovingVariance<T> acc(this->A, window);
+      return this->slide<double>(window, step, edge, acc);
+    }
+
+    /**
+     * @brief Get sample standard deviations of consecutive windows of `window` items
+     * @param window Window length
+     * @param step Distance between starts of consecutive windows. Default 1
+     * @param edge `v` - only full windows (Default), `p` - also shorter windows at the beginning (see `movingSum`)
+     * @return Array<double> - standard deviation of each window
+     */
+    Array<double, Alloc> movingStdev (int window, int step = 1, char edge = 'v') const {
+      Array<double, Alloc> X = this->movingVariance(window, step, edge);
+      for (int i = 0; i < X.size(); i++) X[i] = sqrt(X[i]);
+      return X;
+    }
+
+    /*
+     * Cumulative (prefix scan) operations
+     */
+
+    /**
+     * @brief Cumulative sums of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<T> - `X[i]` = sum of items `from` .. `from + i`
+     */
+    Array cumsum (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->scanned<array_detail::SCAN_SUM>(ArrayPolicy(1), from, to); }
+    /**
+     * @brief Cumulative sums of the `Array` items in range `[from,to]` in parallel (two passes over the range)
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<T> - `X[i]` = sum of items `from` .. `from + i`
+     */
+    Array cumsum (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->scanned<array_detail::SCAN_SUM>(policy, from, to); }
+    /**
+     * @brief Replace the `Array` items in range `[from,to]` with their cumulative sums (see `cumsum`)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void cumsumInPlace (int from = ARRAY_BEGIN, int to = ARRAY_END) { this->scanInPlace<array_detail::SCAN_SUM>(ArrayPolicy(1), from, to); }
+    /**
+     * @brief Replace the `Array` items in range `[from,to]` with their cumulative sums in parallel (see `cumsum`)
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void cumsumInPlace (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) { this->scanInPlace<array_detail::SCAN_SUM>(policy, from, to); }
+
+    /**
+     * @brief Cumulative products of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<T> - `X[i]` = product of items `from` .. `from + i`
+     */
+    Array cumprod (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->scanned<array_detail::SCAN_PROD>(ArrayPolicy(1), from, to); }
+    /**
+     * @brief Cumulative products of the `Array` items in range `[from,to]` in parallel (two passes over the range)
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<T> - `X[i]` = product of items `from` .. `from + i`
+     */
+    Array cumprod (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->scanned<array_detail::SCAN_PROD>(policy, from, to); }
+    /**
+     * @brief Replace the `Array` items in range `[from,to]` with their cumulative products (see `cumprod`)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void cumprodInPlace (int from = ARRAY_BEGIN, int to = ARRAY_END) { this->scanInPlace<array_detail::SCAN_PROD>(ArrayPolicy(1), from, to); }
+    /**
+     * @brief Replace the `Array` items in range `[from,to]` with their cumulative products in parallel (see `cumprod`)
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void cumprodInPlace (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) { this->scanInPlace<array_detail::SCAN_PROD>(policy, from, to); }
+
+    /**
+     * @brief Cumulative minimums of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<T> - `X[i]` = min of items `from` .. `from + i`
+     */
+    Array cummin (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->scanned<array_detail::SCAN_MIN>(ArrayPolicy(1), from, to); }
+    /**
+     * @brief Cumulative minimums of the `Array` items in range `[from,to]` in parallel (two passes over the range)
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<T> - `X[i]` = min of items `from` .. `from + i`
+     */
+    Array cummin (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->scanned<array_detail::SCAN_MIN>(policy, from, to); }
+    /**
+     * @brief Replace the `Array` items in range `[from,to]` with their cumulative minimums (see `cummin`)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void cumminInPlace (int from = ARRAY_BEGIN, int to = ARRAY_END) { this->scanInPlace<array_detail::SCAN_MIN>(ArrayPolicy(1), from, to); }
+    /**
+     * @brief Replace the `Array` items in range `[from,to]` with their cumulative minimums in parallel (see `cummin`)
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void cumminInPlace (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) { this->scanInPlace<array_detail::SCAN_MIN>(policy, from, to); }
+
+    /**
+     * @brief Cumulative maximums of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<T> - `X[i]` = max of items `from` .. `from + i`
+     */
+    Array cummax (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->scanned<array_detail::SCAN_MAX>(ArrayPolicy(1), from, to); }
+    /**
+     * @brief Cumulative maximums of the `Array` items in range `[from,to]` in parallel (two passes over the range)
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<T> - `X[i]` = max of items `from` .. `from + i`
+     */
+    Array cummax (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->scanned<array_detail::SCAN_MAX>(policy, from, to); }
+    /**
+     * @brief Replace the `Array` items in range `[from,to]` with their cumulative maximums (see `cummax`)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void cummaxInPlace (int from = ARRAY_BEGIN, int to = ARRAY_END) { this->scanInPlace<array_detail::SCAN_MAX>(ArrayPolicy(1), from, to); }
+    /**
+     * @brief Replace the `Array` items in range `[from,to]` with their cumulative maximums in parallel (see `cummax`)
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void cummaxInPlace (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) { this->scanInPlace<array_detail::SCAN_MAX>(policy, from, to); }
+
+    /**
+     * @brief Get count, min, max, sum, mean, variance, standard deviation, geometric and harmonic mean of the `Array` items
+     * in range `[from,to]` in a single pass. Variance is the sample variance of the range (`m2 / (count - 1)`)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return ArrayStats<T> - statistics bundle
+     */
+    ArrayStats<T> describe (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return ArrayStats<T>();
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      return array_detail::describe(this->A + b, e - b + 1);
+    }
+    /**
+     * @brief Same as `describe(from, to)`, chunks are summarized in parallel and merged in chunk order
+     * @param policy Execution policy
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return ArrayStats<T> - statistics bundle
+     */
+    ArrayStats<T> describe (const ArrayPolicy &policy, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return ArrayStats<T>();
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int tasks = policy.tasks(e - b + 1);
+      if (tasks <= 1) return array_detail::describe(this->A + b, e - b + 1);
+      std::vector<ArrayStats<T>> partial(tasks);
+      array_detail::parallelChunks(b, e, tasks, [&] (int c, int lo, int hi) { partial[c] = array_detail::describe(this->A + lo, hi - lo + 1); });
+      ArrayStats<T> total;
+      for (int c = 0; c < tasks; c++) total.merge(partial[c]);
+      return total;
+    }
+
+    /*
+     * OPERATORS
+     */
+    // Copy assignment operator
+    Array& operator=(const Array& other) {
+      if (this != &other) {
+        if (other.S > this->C) {
+          T* newA = (T*) Alloc::allocate(other.S * sizeof(T));
+          if (newA == NULL) throw std::invalid_argument("Failed to Allocate Memory");
+          Alloc::deallocate(this->A, this->C * sizeof(T));
+          this->A = newA;
+          this->C = other.S;
+        }
+        this->S = other.S;
+        this->order = other.order;
+        for (int i = 0; i < S; i++) this->A[i] = other.A[i];
+      }
+      return *this;
+    }
+    // Move assignment operator
+    Array& operator=(Array&& other) noexcept {
+      if (this != &other) {
+        Alloc::deallocate(this->A, this->C * sizeof(T));
+        this->S = other.S;
+        this->C = other.C;
+        this->A = other.A;
+        this->order = other.order;
+        other.S = 0;
+        other.C = 0;
+        other.A = nullptr;
+      }
+      return *this;
+    }
+
+    // Expression assignment operator (evaluates `expr` in a single pass)
+    template <class E>
+    Array& operator=(const ArrayExpr<E> &expr) {
+      this->assignExpr(expr);
+      return *this;
+    }
+
+    /**
+     * @brief Lazy expression reading this Array. Starting point for fused expressions, e.g. `a.expr().sum()`
+     * @return ArrayExpr
+     */
+    ArrayExpr<Leaf> expr () const { return ArrayExpr<Leaf>(Leaf(*this)); }
+
+    /*
+     * Arithmetic operations with constants (keeping the Array). Return lazy `ArrayExpr`
+     */
+    ScalarExpr<array_detail::OP_ADD> operator+ (const T& number) const { return this->scalarExpr<array_detail::OP_ADD>(number); }
+    ScalarExpr<array_detail::OP_SUB> operator- (const T& number) const { return this->scalarExpr<array_detail::OP_SUB>(number); }
+    ScalarExpr<array_detail::OP_MUL> operator* (const T& number) const { return this->scalarExpr<array_detail::OP_MUL>(number); }
+    ScalarExpr<array_detail::OP_DIV> operator/ (const T& number) const { return this->scalarExpr<array_detail::OP_DIV>(number); }
+    ScalarExpr<array_detail::OP_MOD> operator% (const T& number) const { return this->scalarExpr<array_detail::OP_MOD>(number); }
+
+    /*
+     * Arithmetic operations with arrays (keeping both arrays). Return lazy `ArrayExpr` for `Array` operands
+     */
+    BinaryExpr<array_detail::OP_ADD> operator+ (const Array& array) const { return this->binaryExpr<array_detail::OP_ADD>(array); }
+    Array operator+ (const std::vector <T> &STL_Vector) const { return this->operator+(Array::fromVector(STL_Vector)); }
+    Array operator+ (const std::list <T> &STL_List) const { return this->operator+(Array::fromList(STL_List)); }
+    Array operator+ (const std::set <T> &STL_Set) const { return this->operator+(Array::fromSet(STL_Set)); }
+    Array operator+ (const std::initializer_list <T> &STL_InitList) const { return this->operator+(Array::fromInitList(STL_InitList)); }
+    BinaryExpr<array_detail::OP_SUB> operator- (const Array& array) const { return this->binaryExpr<array_detail::OP_SUB>(array); }
+    Array operator- (const std::vector <T> &STL_Vector) const { return this->operator-(Array::fromVector(STL_Vector)); }
+    Array operator- (const std::list <T> &STL_List) const { return this->operator-(Array::fromList(STL_List)); }
+    Array operator- (const std::set <T> &STL_Set) const { return this->operator-(Array::fromSet(STL_Set)); }
+    Array operator- (const std::initializer_list <T> &STL_InitList) const { return this->operator-(Array::fromInitList(STL_InitList)); }
+    BinaryExpr<array_detail::OP_MUL> operator* (const Array& array) const { return this->binaryExpr<array_detail::OP_MUL>(array); }
+    Array operator* (const std::vector <T> &STL_Vector) const { return this->operator*(Array::fromVector(STL_Vector)); }
+    Array operator* (const std::list <T> &STL_List) const { return this->operator*(Array::fromList(STL_List)); }
+    Array operator* (const std::set <T> &STL_Set) const { return this->operator*(Array::fromSet(STL_Set)); }
+    Array operator* (const std::initializer_list <T> &STL_InitList) const { return this->operator*(Array::fromInitList(STL_InitList)); }
+    BinaryExpr<array_detail::OP_DIV> operator/ (const Array& array) const { return this->binaryExpr<array_detail::OP_DIV>(array); }
+    Array operator/ (const std::vector <T> &STL_Vector) const { return this->operator/(Array::fromVector(STL_Vector)); }
+    Array operator/ (const std::list <T> &STL_List) const { return this->operator/(Array::fromList(STL_List)); }
+    Array operator/ (const std::set <T> &STL_Set) const { return this->operator/(Array::fromSet(STL_Set)); }
+    Array operator/ (const std::initializer_list <T> &STL_InitList) const { return this->operator/(Array::fromInitList(STL_InitList)); }
+    BinaryExpr<array_detail::OP_MOD> operator% (const Array& array) const { return this->binaryExpr<array_detail::OP_MOD>(array); }
+    Array operator% (const std::vector <T> &STL_Vector) const { return this->operator%(Array::fromVector(STL_Vector)); }
+    Array operator% (const std::list <T> &STL_List) const { return this->operator%(Array::fromList(STL_List)); }
+    Array operator% (const std::set <T> &STL_Set) const { return this->operator%(Array::fromSet(STL_Set)); }
+    Array operator% (const std::initializer_list <T> &STL_InitList) const { return this->operator%(Array::fromInitList(STL_InitList)); }
+
+    /*
+     * Arithmetic operations with constants (modifying the Array)
+     */
+    Array& operator+= (const T& number) {
+      this->order = 0;
+      array_detail::arith<array_detail::OP_ADD>(this->A, number, this->A, this->S);
+      return *this;
+    }
+    Array& operator-= (const T& number) {
+      this->order = 0;
+      array_detail::arith<array_detail::OP_SUB>(this->A, number, this->A, this->S);
+      return *this;
+    }
+    Array& operator*= (const T& number) {
+      this->order = 0;
+      array_detail::arith<array_detail::OP_MUL>(this->A, number, this->A, this->S);
+      return *this;
+    }
+    Array& operator/= (const T& number) {
+      this->order = 0;
+      array_detail::arith<array_detail::OP_DIV>(this->A, number, this->A, this->S);
+      return *this;
+    }
+    Array& operator%= (const T& number) {
+      this->order = 0;
+      array_detail::arith<array_detail::OP_MOD>(this->A, number, this->A, this->S);
+      return *this;
+    }
+
+    /*
+     * Arithmetic operations with other arrays (modifying the first Array)
+     */
+    Array& operator+= (const Array &array) { return this->arithAssign<array_detail::OP_ADD>(array); }
+    template <class E>
+    Array& operator+= (const ArrayExpr<E> &expr) { return this->arithAssignExpr<array_detail::OP_ADD>(expr); }
+    Array& operator+= (const std::vector <T> &STL_Vector) { return this->operator+=(Array::fromVector(STL_Vector)); }
+    Array& operator+= (const std::list <T> &STL_List) { return this->operator+=(Array::fromList(STL_List)); }
+    Array& operator+= (const std::set <T> &STL_Set) { return this->operator+=(Array::fromSet(STL_Set)); }
+    Array& operator+= (const std::initializer_list <T> &STL_InitList) { return this->operator+=(Array::fromInitList(STL_InitList)); }
+    Array& operator-= (const Array &array) { return this->arithAssign<array_detail::OP_SUB>(array); }
+    template <class E>
+    Array& operator-= (const ArrayExpr<E> &expr) { return this->arithAssignExpr<array_detail::OP_SUB>(expr); }
+    Array& operator-= (const std::vector <T> &STL_Vector) { return this->operator-=(Array::fromVector(STL_Vector)); }
+    Array& operator-= (const std::list <T> &STL_List) { return this->operator-=(Array::fromList(STL_List)); }
+    Array& operator-= (const std::set <T> &STL_Set) { return this->operator-=(Array::fromSet(STL_Set)); }
+    Array& operator-= (const std::initializer_list <T> &STL_InitList) { return this->operator-=(Array::fromInitList(STL_InitList)); }
+    Array& operator*= (const Array &array) { return this->arithAssign<array_detail::OP_MUL>(array); }
+    template <class E>
+    Array& operator*= (const ArrayExpr<E> &expr) { return this->arithAssignExpr<array_detail::OP_MUL>(expr); }
+    Array& operator*= (const std::vector <T> &STL_Vector) { return this->operator*=(Array::fromVector(STL_Vector)); }
+    Array& operator*= (const std::list <T> &STL_List) { return this->operator*=(Array::fromList(STL_List)); }
+    Array& operator*= (const std::set <T> &STL_Set) { return this->operator*=(Array::fromSet(STL_Set)); }
+    Array& operator*= (const std::initializer_list <T> &STL_InitList) { return this->operator*=(Array::fromInitList(STL_InitList)); }
+    Array& operator/= (const Array &array) { return this->arithAssign<array_detail::OP_DIV>(array); }
+    template <class E>
+    Array& operator/= (const ArrayExpr<E> &expr) { return this->arithAssignExpr<array_detail::OP_DIV>(expr); }
+    Array& operator/= (const std::vector <T> &STL_Vector) { return this->operator/=(Array::fromVector(STL_Vector)); }
+    Array& operator/= (const std::list <T> &STL_List) { return this->operator/=(Array::fromList(STL_List)); }
+    Array& operator/= (const std::set <T> &STL_Set) { return this->operator/=(Array::fromSet(STL_Set)); }
+    Array& operator/= (const std::initializer_list <T> &STL_InitList) { return this->operator/=(Array::fromInitList(STL_InitList)); }
+    Array& operator%= (const Array &array) { return this->arithAssign<array_detail::OP_MOD>(array); }
+    template <class E>
+    Array& operator%= (const ArrayExpr<E> &expr) { return this->arithAssignExpr<array_detail::OP_MOD>(expr); }
+    Array& operator%= (const std::vector <T> &STL_Vector) { return this->operator%=(Array::fromVector(STL_Vector)); }
+    Array& operator%= (const std::list <T> &STL_List) { return this->operator%=(Array::fromList(STL_List)); }
+    Array& operator%= (const std::set <T> &STL_Set) { return this->operator%=(Array::fromSet(STL_Set)); }
+    Array& operator%= (const std::initializer_list <T> &STL_InitList) { return this->operator%=(Array::fromInitList(STL_InitList)); }
+
+    /*
+     * Boolean operators - comparing to constant. Return lazy `ArrayExpr` of `bool`
+     */
+    CompareScalarExpr<array_detail::CMP_EQ> operator== (const T& val) const { return this->compareScalarExpr<array_detail::CMP_EQ>(val); }
+    CompareScalarExpr<array_detail::CMP_GE> operator>= (const T& val) const { return this->compareScalarExpr<array_detail::CMP_GE>(val); }
+    CompareScalarExpr<array_detail::CMP_LE> operator<= (const T& val) const { return this->compareScalarExpr<array_detail::CMP_LE>(val); }
+    CompareScalarExpr<array_detail::CMP_GT> operator> (const T& val) const { return this->compareScalarExpr<array_detail::CMP_GT>(val); }
+    CompareScalarExpr<array_detail::CMP_LT> operator< (const T& val) const { return this->compareScalarExpr<array_detail::CMP_LT>(val); }
+    CompareScalarExpr<array_detail::CMP_NE> operator!= (const T& val) const { return this->compareScalarExpr<array_detail::CMP_NE>(val); }
+
+    /* 
+     * Boolean operators - comparing to another `Array`. Return lazy `ArrayExpr` of `bool` for `Array` operands.
+     * Elements outside the shorter Array compare as `false`
+     */
+    CompareExpr<array_detail::CMP_EQ> operator== (const Array &array) const { return this->compareExpr<array_detail::CMP_EQ>(array); }
+    Array<bool, Alloc> operator== (const std::vector <T> &STL_Vector) const { return this->operator==(Array::fromVector(STL_Vector)); }
+    Array<bool, Alloc> operator== (const std::list <T> &STL_List) const { return this->operator==(Array::fromList(STL_List)); }
+    Array<bool, Alloc> operator== (const std::set <T> &STL_Set) const { return this->operator==(Array::fromSet(STL_Set)); }
+    Array<bool, Alloc> operator== (const std::initializer_list <T> &STL_InitList) const { return this->operator==(Array::fromInitList(STL_InitList)); }
+    CompareExpr<array_detail::CMP_GE> operator>= (const Array &array) const { return this->compareExpr<array_detail::CMP_GE>(array); }
+    Array<bool, Alloc> operator>= (const std::vector <T> &STL_Vector) const { return this->operator>=(Array::fromVector(STL_Vector)); }
+    Array<bool, Alloc> operator>= (const std::list <T> &STL_List) const { return this->operator>=(Array::fromList(STL_List)); }
+    Array<bool, Alloc> operator>= (const std::set <T> &STL_Set) const { return this->operator>=(Array::fromSet(STL_Set)); }
+    Array<bool, Alloc> operator>= (const std::initializer_list <T> &STL_InitList) const { return this->operator>=(Array::fromInitList(STL_InitList)); }
+    CompareExpr<array_detail::CMP_LE> operator<= (const Array &array) const { return this->compareExpr<array_detail::CMP_LE>(array); }
+    Array<bool, Alloc> operator<= (const std::vector <T> &STL_Vector) const { return this->operator<=(Array::fromVector(STL_Vector)); }
+    Array<bool, Alloc> operator<= (const std::list <T> &STL_List) const { return this->operator<=(Array::fromList(STL_List)); }
+    Array<bool, Alloc> operator<= (const std::set <T> &STL_Set) const { return this->operator<=(Array::fromSet(STL_Set)); }
+    Array<bool, Alloc> operator<= (const std::initializer_list <T> &STL_InitList) const { return this->operator<=(Array::fromInitList(STL_InitList)); }
+    CompareExpr<array_detail::CMP_GT> operator> (const Array &array) const { return this->compareExpr<array_detail::CMP_GT>(array); }
+    Array<bool, Alloc> operator> (const std::vector <T> &STL_Vector) const { return this->operator>(Array::fromVector(STL_Vector)); }
+    Array<bool, Alloc> operator> (const std::list <T> &STL_List) const { return this->operator>(Array::fromList(STL_List)); }
+    Array<bool, Alloc> operator> (const std::set <T> &STL_Set) const { return this->operator>(Array::fromSet(STL_Set)); }
+    Array<bool, Alloc> operator> (const std::initializer_list <T> &STL_InitList) const { return this->operator>(Array::fromInitList(STL_InitList)); }
+    CompareExpr<array_detail::CMP_LT> operator< (const Array &array) const { return this->compareExpr<array_detail::CMP_LT>(array); }
+    Array<bool, Alloc> operator< (const std::vector <T> &STL_Vector) const { return this->operator<(Array::fromVector(STL_Vector)); }
+    Array<bool, Alloc> operator< (const std::list <T> &STL_List) const { return this->operator<(Array::fromList(STL_List)); }
+    Array<bool, Alloc> operator< (const std::set <T> &STL_Set) const { return this->operator<(Array::fromSet(STL_Set)); }
+    Array<bool, Alloc> operator< (const std::initializer_list <T> &STL_InitList) const { return this->operator<(Array::fromInitList(STL_InitList)); }
+    CompareExpr<array_detail::CMP_NE> operator!= (const Array &array) const { return this->compareExpr<array_detail::CMP_NE>(array); }
+    Array<bool, Alloc> operator!= (const std::vector <T> &STL_Vector) const { return this->operator!=(Array::fromVector(STL_Vector)); }
+    Array<bool, Alloc> operator!= (const std::list <T> &STL_List) const { return this->operator!=(Array::fromList(STL_List)); }
+    Array<bool, Alloc> operator!= (const std::set <T> &STL_Set) const { return this->operator!=(Array::fromSet(STL_Set)); }
+    Array<bool, Alloc> operator!= (const std::initializer_list <T> &STL_InitList) const { return this->operator!=(Array::fromInitList(STL_InitList)); }
+
+    /**
+     * Boolean operators for Array Masks (Keeping inital Array Masks)
+     */
+    Array<bool, Alloc> operator! () const {
+      Array<bool, Alloc> X(this->S);
+      for (int i = 0; i < this->S; i++) X[i] = !(this->A[i]);
+      return X;
+    }
+    Array<bool, Alloc> operator| (const Array<bool, Alloc> &mask) const {
+      int max_size = MAX_S(this->S, mask.size());
+      Array<bool, Alloc> X(max_size);
+      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i];
+      for (int i = 0; i < mask.size(); i++) X[i] = (bool) X[i] | (bool) mask[i];
+      return X;
+    }
+    Array<bool, Alloc> operator| (const std::vector<bool> &mask) const { return this->operator|(Array<bool, Alloc>::fromVector(mask)); }
+    Array<bool, Alloc> operator| (const std::list<bool> &mask) const { return this->operator|(Array<bool, Alloc>::fromList(mask)); }
+    Array<bool, Alloc> operator| (const std::set<bool> &mask) const { return this->operator|(Array<bool, Alloc>::fromSet(mask)); }
+    Array<bool, Alloc> operator| (const std::initializer_list<bool> &mask) const { return this->operator|(Array<bool, Alloc>::fromInitList(mask)); }
+    Array<bool, Alloc> operator& (const Array<bool, Alloc> &mask) const {
+      int max_size = MAX_S(this->S, mask.size());
+      Array<bool, Alloc> X(max_size);
+      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i];
+      for (int i = 0; i < mask.size(); i++) X[i] = (bool) X[i] & (bool) mask[i];
+      return X;
+    }
+    Array<bool, Alloc> operator& (const std::vector<bool> &mask) const { return this->operator&(Array<bool, Alloc>::fromVector(mask)); }
+    Array<bool, Alloc> operator& (const std::list<bool> &mask) const { return this->operator&(Array<bool, Alloc>::fromList(mask)); }
+    Array<bool, Alloc> operator& (const std::set<bool> &mask) const { return this->operator&(Array<bool, Alloc>::fromSet(mask)); }
+    Array<bool, Alloc> operator& (const std::initializer_list<bool> &mask) const { return this->operator&(Array<bool, Alloc>::fromInitList(mask)); }
+    Array<bool, Alloc> operator^ (const Array<bool, Alloc> &mask) const {
+      int max_size = MAX_S(this->S, mask.size());
+      Array<bool, Alloc> X(max_size);
+      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i];
+      for (int i = 0; i < mask.size(); i++) X[i] = (bool) X[i] ^ (bool) mask[i];
+      return X;
+    }
+    Array<bool, Alloc> operator^ (const std::vector<bool> &mask) const { return this->operator^(Array<bool, Alloc>::fromVector(mask)); }
+    Array<bool, Alloc> operator^ (const std::list<bool> &mask) const { return this->operator^(Array<bool, Alloc>::fromList(mask)); }
+    Array<bool, Alloc> operator^ (const std::set<bool> &mask) const { return this->operator^(Array<bool, Alloc>::fromSet(mask)); }
+    Array<bool, Alloc> operator^ (const std::initializer_list<bool> &mask) const { return this->operator^(Array<bool, Alloc>::fromInitList(mask)); }
+
+    /**
+     * Boolean operators with `bool` constant for Array Mask (Keeping inital Array Mask)
+     */
+    Array<bool, Alloc> operator| (bool val) const {
+      Array<bool, Alloc> X(this->S);
+      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i] | val;
+      return X;
+    }
+    Array<bool, Alloc> operator& (bool val) const {
+      Array<bool, Alloc> X(this->S);
+      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i] & val;
+      return X;
+    }
+    Array<bool, Alloc> operator^ (bool val) const {
+      Array<bool, Alloc> X(this->S);
+      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i] ^ val;
+      return X;
+    }
+};
+
+/**
+ * @brief `Array<bool>` stored as packed bitset (64 elements per 64-bit word), 8x smaller than one byte per element.
+ * Mask algebra (`!`, `~`, `|`, `&`, `^`, `==`, `!=`) works on whole words and `countTrue`, `any`, `all` use popcount.
+ * Non-const subscript returns proxy `Array<bool>::Reference` behaving like `bool&`.
+ * Bits past `size()` are always kept `0`
+ */
+template <class Alloc>
+class Array<bool, Alloc> {
+  template <class U, class A> friend class Array;
+  template <class U> friend struct array_detail::LeafNode;
+  template <class U> friend class ArrayWriter;
+  template <class U> friend class ArrayReader;
+  public:
+    /**
+     * @brief Reference to single element of packed `Array<bool>`
+     */
+    class Reference {
+      private:
+        uint64_t* word;
+        uint64_t bit;
+      public:
+        Reference (uint64_t* word, int index) noexcept : word(word), bit((uint64_t) 1 << (index & 63)) {}
+        operator bool () const noexcept { return (*this->word & this->bit) != 0; }
+        Reference& operator= (bool value) noexcept {
+          if (value) *this->word |= this->bit;
+          else *this->word &= ~this->bit;
+          return *this;
+        }
+        Reference& operator= (const Reference &other) noexcept { return *this = (bool) other; }
+        Reference& operator|= (bool value) noexcept { return *this = (bool) *this | value; }
+        Reference& operator&= (bool value) noexcept { return *this = (bool) *this & value; }
+        Reference& operator^= (bool value) noexcept { return *this = (bool) *this ^ value; }
+        // Negate the element
+        void flip () noexcept { *this->word ^= this->bit; }
+    };
+  private:
+    uint64_t* W;  // Packed elements, element `i` is bit `i % 64` of `W[i / 64]`
+    int S;        // Size in elements
+    int C;        // Capacity in elements (multiple of 64)
+    static int words (int bits) { return (int) (((long long) bits + 63) >> 6); }
+    // Mask of bits below `bits % 64` (all bits when `bits % 64 == 0`)
+    static uint64_t lowBits (int bits) { return (bits & 63) ? ((uint64_t) 1 << (bits & 63)) - 1 : ~(uint64_t) 0; }
+    int idx (int index) const {
+      if (index < -this->S || index >= this->S) throw std::invalid_argument("Invalid Array Index!");
+      if (index >= 0) return index;
+      return index + this->S;
+    }
+    void checkRange (int From, int To) const {
+      int width = idx(To) - idx(From) + 1;
+      if (width < 1 || width > this->S) throw std::invalid_argument("Invalid From-To Range");
+      return;
+    }
+    static void checkSize (int size) {
+      if (size < ARRAY_BEGIN || size > ARRAY_END) throw std::invalid_argument("Invalid Array Size provided");
+      return;
+    }
+    bool get (int i) const { return (this->W[i >> 6] >> (i & 63)) & 1; }
+    void put (int i, bool value) {
+      uint64_t bit = (uint64_t) 1 << (i & 63);
+      if (value) this->W[i >> 6] |= bit;
+      else this->W[i >> 6] &= ~bit;
+    }
+    // 64 elements starting at `i` (elements past capacity read as `0`)
+    uint64_t wordAt (int i) const {
+      int k = i >> 6, off = i & 63, n = words(this->C);
+      if (k >= n) return 0;
+      if (off == 0) return this->W[k];
+      uint64_t w = this->W[k] >> off;
+      if (k + 1 < n) w |= this->W[k + 1] << (64 - off);
+      return w;
+    }
+    // Allocate words for `size` elements without initializing them (caller writes every word)
+    void wordsAlloc (int size) {
+      checkSize(size);
+      this->S = size;
+      this->C = words(size) * 64;
+      if (size > 0) {
+        this->W = (uint64_t*) Alloc::allocate(words(size) * sizeof(uint64_t));
+        if (this->W == NULL) throw std::invalid_argument("Failed to Allocate Memory");
+      }
+      else this->W = nullptr;
+    }
+    void sizeAlloc (int size) {
+      this->wordsAlloc(size);
+      if (size > 0) memset((void*) this->W, 0, words(size) * sizeof(uint64_t));
+    }
+    // Reallocate storage to hold at least `capacity` elements (must be >= current size). New words are zeroed
+    void reallocate (int capacity) {
+      int oldWords = words(this->C), newWords = words(capacity);
+      if (newWords == 0) {
+        Alloc::deallocate(this->W, oldWords * sizeof(uint64_t));
+        this->W = nullptr;
+        this->C = 0;
+        return;
+      }
+      uint64_t* newW = (uint64_t*) Alloc::reallocate(this->W, oldWords * sizeof(uint64_t), newWords * sizeof(uint64_t));
+      if (newW == NULL) throw std::invalid_argument("Failed to Allocate Memory");
+      if (newWords > oldWords) memset((void*) (newW + oldWords), 0, (newWords - oldWords) * sizeof(uint64_t));
+      this->W = newW;
+      this->C = newWords * 64;
+    }
+    // Make room for at least `minCapacity` elements using geometric (1.5x) growth
+    void grow (int minCapacity) {
+      if (minCapacity <= this->C) return;
+      long long newCap = this->C + this->C / 2;
+      if (newCap < ARRAY_MIN_CAPACITY) newCap = ARRAY_MIN_CAPACITY;
+      if (newCap < minCapacity) newCap = minCapacity;
+      if (newCap > ARRAY_END) newCap = ARRAY_END;
+      this->reallocate((int) newCap);
+    }
+    // Shrink size to `size`, zeroing dropped elements
+    void truncate (int size) {
+      for (int k = words(size); k < words(this->S); k++) this->W[k] = 0;
+      if (size & 63) this->W[size >> 6] &= lowBits(size);
+      this->S = size;
+    }
+    // Number of `true` elements in `[b,e]` (valid range)
+    int countRange (int b, int e) const {
+      int wb = b >> 6, we = e >> 6;
+      uint64_t first = ~(uint64_t) 0 << (b & 63), last = lowBits(e + 1);
+      if (wb == we) return array_detail::popcount64(this->W[wb] & first & last);
+      int cnt = array_detail::popcount64(this->W[wb] & first);
+      for (int k = wb + 1; k < we; k++) cnt += array_detail::popcount64(this->W[k]);
+      return cnt + array_detail::popcount64(this->W[we] & last);
+    }
+    // First index in `[b,e]` (valid range) holding `elem`, `-1` if none
+    int findRange (bool elem, int b, int e) const {
+      int wb = b >> 6, we = e >> 6;
+      for (int k = wb; k <= we; k++) {
+        uint64_t w = elem ? this->W[k] : ~this->W[k];
+        if (k == wb) w &= ~(uint64_t) 0 << (b & 63);
+        if (k == we) w &= lowBits(e + 1);
+        if (w != 0) return (k << 6) + array_detail::ctz64(w);
+      }
+      return -1;
+    }
+    // Pack evaluated `e` (`n = e.size()` elements) into `W`, which must hold `n` elements
+    template <class E>
+    void pack (const E &e, int n) {
+      int m = e.minSize();
+      for (int k = 0; k < words(n); k++) {
+        int lo = k << 6, hi = lo + 64 < n ? lo + 64 : n;
+        uint64_t w = 0;
+        if (hi - lo == 64 && hi <= m) {
+          // Evaluate into bytes first so the element loop vectorizes, then gather 8 bytes per step
+          unsigned char b[64];
+          for (int i = 0; i < 64; i++) b[i] = (bool) e.fast(lo + i);
+          for (int j = 0; j < 64; j += 8) {
+            uint64_t v;
+            memcpy(&v, b + j, 8);
+            w |= ((v * 0x0102040810204080ULL) >> 56) << j;
+          }
+        } else if (hi <= m) {
+          for (int i = lo; i < hi; i++) w |= (uint64_t) (bool) e.fast(i) << (i - lo);
+        } else {
+          for (int i = lo; i < hi; i++) w |= (uint64_t) (bool) e.at(i) << (i - lo);
+        }
+        this->W[k] = w;
+      }
+    }
+    // Evaluate `expr` into this Array 64 elements at a time. Storage is reused when the result fits in the current capacity
+    template <class E>
+    void assignExpr (const ArrayExpr<E> &expr) {
+      int n = expr.size();
+      checkSize(n);
+      if (n > this->C) {
+        Array X;
+        X.reserve(n);
+        X.pack(expr.node(), n);
+        X.S = n;
+        *this = std::move(X);
+        return;
+      }
+      this->pack(expr.node(), n);
+      for (int k = words(n); k < words(this->S); k++) this->W[k] = 0;
+      this->S = n;
+    }
+    // `A[i] = A[i] Op mask[i]` word by word. Array is first extended with `false` to the size of `mask`
+    template <int Op>
+    Array& maskAssign (const Array &mask) {
+      if (&mask == this) {
+        Array copy = mask;
+        return this->maskAssign<Op>(copy);
+      }
+      if (mask.S > this->S) this->resize(mask.S);
+      int full = mask.S >> 6;
+      for (int k = 0; k < full; k++) this->W[k] = array_detail::Arith<Op, uint64_t>::apply(this->W[k], mask.W[k]);
+      if (mask.S & 63) {
+        // Elements past `mask` are kept (`&` with `1`, `|` and `^` with `0`)
+        uint64_t w = mask.W[full];
+        if (Op == array_detail::OP_AND) w |= ~lowBits(mask.S);
+        this->W[full] = array_detail::Arith<Op, uint64_t>::apply(this->W[full], w);
+      }
+      return *this;
+    }
+    // `A[i] Op mask[i]` into a new Array of the larger size (same rules as `maskAssign`), written word by word
+    template <int Op>
+    Array combine (const Array &mask) const {
+      Array X;
+      X.wordsAlloc(this->S > mask.S ? this->S : mask.S);
+      int wa = words(this->S), wm = words(mask.S), k = 0;
+      for (; k < wa && k < wm; k++) X.W[k] = array_detail::Arith<Op, uint64_t>::apply(this->W[k], mask.W[k]);
+      if (Op == array_detail::OP_AND && (mask.S & 63) && wm <= wa) X.W[wm - 1] = this->W[wm - 1] & (mask.W[wm - 1] | ~lowBits(mask.S));
+      for (; k < wa; k++) X.W[k] = this->W[k];
+      for (; k < wm; k++) X.W[k] = Op == array_detail::OP_AND ? 0 : mask.W[k];
+      return X;
+    }
+    // Element-wise `==` (`equal = true`) or `!=` with `other`. Elements outside the shorter Array are `false`
+    Array compareMask (const Array &other, bool equal) const {
+      int n = this->S > other.S ? this->S : other.S, m = this->S < other.S ? this->S : other.S;
+      Array X(n);
+      for (int k = 0; k < words(m); k++) {
+        uint64_t w = this->W[k] ^ other.W[k];
+        X.W[k] = equal ? ~w : w;
+      }
+      if (m & 63) X.W[m >> 6] &= lowBits(m);
+      return X;
+    }
+    typedef array_detail::LeafNode<bool> Leaf;
+    template <int Op> using ScalarExpr = ArrayExpr<array_detail::ScalarNode<Op, Leaf>>;
+    template <int Op> using BinaryExpr = ArrayExpr<array_detail::BinaryNode<Op, Leaf, Leaf>>;
+    template <int Cmp> using CompareScalarExpr = ArrayExpr<array_detail::CompareScalarNode<Cmp, Leaf>>;
+    template <int Cmp> using CompareExpr = ArrayExpr<array_detail::CompareNode<Cmp, Leaf, Leaf>>;
+    template <int Op>
+    ScalarExpr<Op> scalarExpr (bool number) const { return ScalarExpr<Op>(array_detail::ScalarNode<Op, Leaf>(Leaf(*this), number)); }
+    template <int Op>
+    BinaryExpr<Op> binaryExpr (const Array& array) const { return BinaryExpr<Op>(array_detail::BinaryNode<Op, Leaf, Leaf>(Leaf(*this), Leaf(array))); }
+    template <int Cmp>
+    CompareScalarExpr<Cmp> compareScalarExpr (bool val) const { return CompareScalarExpr<Cmp>(array_detail::CompareScalarNode<Cmp, Leaf>(Leaf(*this), val)); }
+    template <int Cmp>
+    CompareExpr<Cmp> compareExpr (const Array& array) const { return CompareExpr<Cmp>(array_detail::CompareNode<Cmp, Leaf, Leaf>(Leaf(*this), Leaf(array))); }
+    // `A[i] = A[i] Op expr[i]` (same size rules as `Array` arithmetic), evaluated 64 elements at a time
+    template <int Op, class E>
+    Array& arithAssignExpr (const ArrayExpr<E> &expr) {
+      typedef array_detail::BinaryNode<Op, Leaf, E> Node;
+      return *this = ArrayExpr<Node>(Node(Leaf(*this), expr.node()));
+    }
+    // Elements for which `func` returns `true`
+    template <class F>
+    Array filterElements (F &func) const {
+      Array X(this->S);
+      int k = 0;
+      for (int i = 0; i < this->S; i++) {
+        bool elem = this->get(i);
+        if (array_detail::callElement(func, elem, i, *this, array_detail::ArgsThree())) X.put(k++, elem);
+      }
+      X.truncate(k);
+      return X;
+    }
+    // Results of `func` for every element, written into a single allocation
+    template <typename U, class F>
+    Array<U, Alloc> mapElements (F &func) const {
+      Array<U, Alloc> X;
+      X.sizeAlloc(this->S);
+      for (int i = 0; i < this->S; i++) X.put(i, array_detail::callElement(func, this->get(i), i, *this, array_detail::ArgsThree()));
+      return X;
+    }
+  public:
+    /* STATIC METHODS FOR CONVERSIONS */
+    static Array fromVector (const std::vector < bool > &STL_Vector) {
+      Array a;
+      a.sizeAlloc(STL_Vector.size());
+      for (int i = 0; i < a.size(); i++) a.put(i, STL_Vector[i]);
+      return a;
+    }
+    static Array fromList (const std::list < bool > &STL_List) {
+      Array a;
+      a.sizeAlloc(STL_List.size());
+      int i = 0;
+      for (auto it = STL_List.cbegin(); it != STL_List.cend(); it++) {
+        if (i >= a.size()) break;
+        a.put(i, *it);
+        i++;
+      }
+      return a;
+    }
+    static Array fromSet (const std::set < bool > &STL_Set) {
+      Array a;
+      a.sizeAlloc(STL_Set.size());
+      int i = 0;
+      for (auto it = STL_Set.cbegin(); it != STL_Set.cend(); it++) {
+        if (i >= a.size()) break;
+        a.put(i, *it);
+        i++;
+      }
+      return a;
+    }
+    static Array fromInitList (std::initializer_list<bool> InitValues) {
+      Array a;
+      a.sizeAlloc(InitValues.size());
+      int i = 0;
+      for (auto it = InitValues.begin(); it != InitValues.end(); it++) {
+        if (i >= a.size()) break;
+        a.put(i, *it);
+        i++;
+      }
+      return a;
+    }
+    static Array fromPointer (bool* ptr, int size) {
+      Array a;
+      a.sizeAlloc(size);
+      for (int i = 0; i < a.size(); i++) a.put(i, ptr[i]);
+      return a;
+    }
+    /**
+     * @brief Read Array saved with `save` or `ArrayWriter<bool>`
+     * @param path File path
+     * @return Array
+     */
+    static Array load (const std::string &path);
+    /* CONSTRUCTORS */
+    // Empty Array Constructor -> Size = 0
+    Array () : W(nullptr), S(0), C(0) {}
+    // Array Constructor with initial size (all elements `false`)
+    explicit Array (int s) { this->sizeAlloc(s); }
+    // Array Constructor using STL Vector
+    explicit Array (const std::vector < bool > &STL_Vector) : W(nullptr), S(0), C(0) { *this = fromVector(STL_Vector); }
+    // Array Constructor using STL List
+    explicit Array (const std::list < bool > &STL_List) : W(nullptr), S(0), C(0) { *this = fromList(STL_List); }
+    // Array Constructor using STL Set
+    explicit Array (const std::set < bool > &STL_Set) : W(nullptr), S(0), C(0) { *this = fromSet(STL_Set); }
+    // Array Constructor using STL Initializer List
+    explicit Array (std::initializer_list<bool> InitValues) : W(nullptr), S(0), C(0) { *this = fromInitList(InitValues); }
+    // Array Constructor using pointer
+    Array (const bool* dynamicArray, int arraySize) {
+      this->sizeAlloc(arraySize);
+      for (int i = 0; i < this->S; i++) this->put(i, dynamicArray[i]);
+    }
+    // Copy constructor
+    Array (const Array& other) {
+      this->wordsAlloc(other.S);
+      if (this->S > 0) memcpy((void*) this->W, (const void*) other.W, words(this->S) * sizeof(uint64_t));
+    }
+    // Copy constructor from Array using another allocator
+    template <class OtherAlloc>
+    explicit Array (const Array<bool, OtherAlloc>& other) {
+      this->wordsAlloc(other.S);
+      if (this->S > 0) memcpy((void*) this->W, (const void*) other.W, words(this->S) * sizeof(uint64_t));
+    }
+    // Array Constructor evaluating an expression (e.g. `Array<bool> m = (a > 2) & (b < 3);`) in a single pass
+    template <class E>
+    Array (const ArrayExpr<E> &expr) : W(nullptr), S(0), C(0) { this->assignExpr(expr); }
+    // Move constructor
+    Array (Array&& other) noexcept : W(other.W), S(other.S), C(other.C) {
+      other.S = 0;
+      other.C = 0;
+      other.W = nullptr;
+    }
+    // Default Destructor
+    ~Array () {
+      if (this->W != nullptr) Alloc::deallocate(this->W, words(this->C) * sizeof(uint64_t));
+    }
+    // Getting array size
+    int size () const noexcept {return this->S;}
+    // Same as `size()`
+    int length () const noexcept {return this->S;}
+    // Getting number of elements the Array can hold without reallocating
+    int capacity () const noexcept {return this->C;}
+    /**
+     * @brief Make sure the Array can hold at least `capacity` elements without reallocating
+     * @param capacity Minimal capacity
+     */
+    void reserve (int capacity) {
+      checkSize(capacity);
+      if (capacity > this->C) this->reallocate(capacity);
+    }
+    /**
+     * @brief Release unused capacity
+     */
+    void shrinkToFit () {
+      if (words(this->C) > words(this->S)) this->reallocate(this->S);
+    }
+
+    /**
+     * @brief Print Array elements to stdout
+     * @param showType Default `false`
+     * @param showBrackets Default `true`
+     * @param endNewLine Default `true`
+     * @param elemNewLine Default `false`
+     * @param bracketOpenChar Default `'['`
+     * @param bracketCloseChar Default `']'`
+     * @param sep Default `", "`
+     */
+    void show (
+      bool showType = false, bool showBrackets = true, bool endNewLine = true, bool elemNewLine = false,
+      char bracketOpenChar = '[', char bracketCloseChar = ']', const std::string &sep = ", "
+    ) const noexcept {
+      if (showType) std::cout<<"`Array` ";
+      if (showBrackets) std::cout<<bracketOpenChar;
+      for (int i = 0; i < this->S; i++) {
+        std::cout<<this->get(i);
+        if (i < this->S - 1) std::cout<<sep;
+        if (elemNewLine) std::cout<<std::endl;
+      }
+      if (showBrackets) std::cout<<bracketCloseChar;
+      if (endNewLine) std::cout<<std::endl;
+    }
+
+    /**
+     * @brief Write Array items in range `[from,to]` to binary file (one byte per element, see `ArrayWriter`)
+     * @param path File path (overwritten)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void save (const std::string &path, int from = ARRAY_BEGIN, int to = ARRAY_END) const;
+
+    // Non-accessible and accessible subscripts (Negative indexing supported)
+    Reference operator[] (int index) {
+      int i = idx(index);
+      return Reference(this->W + (i >> 6), i);
+    }
+    bool operator[] (int index) const {return this->get(idx(index));}
+    // Multi-index subscript operator (read-only)
+    template <class IndexAlloc>
+    Array operator[] (const Array<int, IndexAlloc> &index) const {
+      Array X(index.size());
+      for (int i = 0; i < index.size(); i++) X.put(i, this->get(idx(index[i])));
+      return X;
+    }
+    Array operator[] (const std::vector <int> &index) const { return this->operator[](Array<int, Alloc>::fromVector(index)); }
+    Array operator[] (const std::list <int> &index) const { return this->operator[](Array<int, Alloc>::fromList(index)); }
+    Array operator[] (const std::set <int> &index) const { return this->operator[](Array<int, Alloc>::fromSet(index)); }
+    Array operator[] (const std::initializer_list <int> &index) const { return this->operator[](Array<int, Alloc>::fromInitList(index)); }
+    // Boolean mask subscript operator (read-only), same as `compress(mask)`
+    template <class MaskAlloc>
+    Array operator[] (const Array<bool, MaskAlloc> &mask) const { return this->compress(mask); }
+    template <class E>
+    Array operator[] (const ArrayExpr<E> &mask) const { return this->compress(mask); }
+
+    /**
+     * @brief Append `elem` to the end of Array
+     * @param elem 
+     */
+    void append (bool elem) {
+      int newSize = this->S + 1;
+      checkSize(newSize);
+      this->grow(newSize);
+      this->put(this->S, elem);
+      this->S++;
+    }
+    /**
+     * @brief Append `array` to the end of Array
+     * @param array 
+     */
+    void append (const Array& array) {
+      if (array.size() == 0) return;
+      int newSize = this->S + array.size();
+      checkSize(newSize);
+      if (&array == this) {
+        Array copy = array;
+        this->append(copy);
+        return;
+      }
+      this->grow(newSize);
+      int base = this->S >> 6, off = this->S & 63, n = words(array.S), end = words(newSize);
+      for (int k = 0; k < n; k++) {
+        if (off == 0) {
+          this->W[base + k] = array.W[k];
+          continue;
+        }
+        this->W[base + k] |= array.W[k] << off;
+        if (base + k + 1 < end) this->W[base + k + 1] |= array.W[k] >> (64 - off);
+      }
+      this->S = newSize;
+    }
+    void append (const std::vector < bool > &STL_Vector) { append(fromVector(STL_Vector)); }
+    void append (const std::list < bool > &STL_List) { append(fromList(STL_List)); }
+    void append (const std::set < bool > &STL_Set) { append(fromSet(STL_Set)); }
+    void append (std::initializer_list<bool> InitValues) { append(fromInitList(InitValues)); }
+    void append (bool* ptr, int size) { append(fromPointer(ptr, size)); }
+
+    /**
+     * @brief Insert `elem` into Array at specific `index`
+     * @param elem 
+     * @param index Default 0
+     */
+    void insert (bool elem, int index = ARRAY_BEGIN) {
+      int newSize = this->S + 1;
+      checkSize(newSize);
+      int i_idx = idx(index);
+      this->grow(newSize);
+      for (int i = newSize - 1; i > i_idx; i--) this->put(i, this->get(i - 1));
+      this->put(i_idx, elem);
+      this->S++;
+    }
+    /**
+     * @brief Insert `array` into Array at specific `index`
+     * @param array 
+     * @param index Default 0
+     */
+    void insert (const Array& array, int index = ARRAY_BEGIN) {
+      if (array.size() == 0) return;
+      int newSize = this->S + array.size();
+      checkSize(newSize);
+      int i_idx = idx(index);
+      if (&array == this) {
+        Array copy = array;
+        this->insert(copy, index);
+        return;
+      }
+      this->grow(newSize);
+      for (int i = newSize - 1; i >= i_idx + array.size(); i--) this->put(i, this->get(i - array.size()));
+      for (int i = 0; i < array.size(); i++) this->put(i_idx + i, array.get(i));
+      this->S += array.size();
+    }
+    void insert (const std::vector < bool > &STL_Vector, int index = ARRAY_BEGIN) { insert(fromVector(STL_Vector), index); }
+    void insert (const std::list < bool > &STL_List, int index = ARRAY_BEGIN) { insert(fromList(STL_List), index); }
+    void insert (const std::set < bool > &STL_Set, int index = ARRAY_BEGIN) { insert(fromSet(STL_Set), index); }
+    void insert (std::initializer_list<bool> InitValues, int index = ARRAY_BEGIN) { insert(fromInitList(InitValues), index); }
+    void insert (bool* ptr, int size, int index = ARRAY_BEGIN) { insert(fromPointer(ptr, size), index); }
+
+    /**
+     * @brief Delete n = `count` Array elements starting from `index` (fewer if the Array ends before)
+     * @param index Default 0
+     * @param count Default 1
+     */
+    void erase (int index = ARRAY_BEGIN, int count = 1) {
+      if (this->S == 0 || count <= 0) return;
+      int e_idx = idx(index);
+      int c_count = count > this->S - e_idx ? this->S - e_idx : count;
+      int newSize = this->S - c_count;
+      checkSize(newSize);
+      if (newSize > 0 && e_idx + c_count < this->S) {
+        for (int i = e_idx + count; i < this->S; i++) this->put(i - count, this->get(i));
+      }
+      this->truncate(newSize);
+    }
+
+    /**
+     * @brief Fill the Array with `elem` in range `[from,to]`
+     * @param elem 
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void fill (bool elem, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S == 0) return;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int wb = b >> 6, we = e >> 6;
+      for (int k = wb; k <= we; k++) {
+        uint64_t m = ~(uint64_t) 0;
+        if (k == wb) m &= ~(uint64_t) 0 << (b & 63);
+        if (k == we) m &= lowBits(e + 1);
+        if (elem) this->W[k] |= m;
+        else this->W[k] &= ~m;
+      }
+    }
+
+    /**
+     * @brief Reverse `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void reverse (int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S == 0) return;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      for (int i = b; i < (e + b + 1) / 2; i++) {
+        bool temp = this->get(i);
+        this->put(i, this->get(e - i + b));
+        this->put(e - i + b, temp);
+      }
+    }
+
+    /**
+     * @brief Shift `Array` items in range `[from,to]` by specified `amount` (rotating them inside the range)
+     * @param amount Shift amount. If negative, it shifts to the left
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void shift (int amount, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S == 0 || amount == 0) return;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int len = e - b + 1;
+      if (amount % len == 0 || len <= 1) return;
+      Array temp = this->slice(b, e);
+      int first = ((amount % len) + len) % len;
+      for (int i = 0; i < len; i++) this->put(b + (i + first) % len, temp.get(i));
+    }
+
+    /**
+     * @brief Replace all `Array` items in range `[from,to]`, which are `searchElem` with value of `replaceWith`.
+     * Every item in the range ends up equal to `replaceWith` unless both are the same, so this is a word-level `fill`
+     * @param searchElem Search Element
+     * @param replaceWith Replace Value
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void replace (bool searchElem, bool replaceWith, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (searchElem != replaceWith) this->fill(replaceWith, from, to);
+    }
+
+    /**
+     * @brief Sort `Array` items in range `[from,to]`: popcount of the range, then two word-level fills
+     * @param ascending Default `true` (`false` items first). `false` = descending order
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     */
+    void sort (bool ascending = true, int from = ARRAY_BEGIN, int to = ARRAY_END) {
+      if (this->S <= 1) return;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int ones = this->countRange(b, e), zeros = e - b + 1 - ones;
+      int split = ascending ? b + zeros : b + ones;
+      if (split > b) this->fill(!ascending, b, split - 1);
+      if (split <= e) this->fill(ascending, split, e);
+    }
+    /**
+     * @brief Returns `Array` with sorted items in range `[from,to]` (see `sort`).
+     * Does not modify initial `Array`
+     * @param ascending Default `true`. `false` = descending order
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<bool>
+     */
+    Array toSorted (bool ascending = true, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      Array X = *this;
+      X.sort(ascending, from, to);
+      return X;
+    }
+
+    /**
+     * @brief Remove all elements of the `Array`. Allocated capacity is kept for reuse
+     */
+    void clear () {
+      this->truncate(0);
+    }
+
+    /**
+     * @brief Resize the `Array` into specified size. New elements are `false`
+     * @warning Resizing array into smaller size will remove the data which is out of bounds. Resizing to `0` removes data completely
+     * @param size New Size
+     */
+    void resize (int size) {
+      checkSize(size);
+      if (size > this->C) this->reallocate(size);
+      if (size < this->S) this->truncate(size);
+      else this->S = size;
+    }
+
+    /**
+     * @brief Return `Array` using `from` and `to` index
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<bool>
+     */
+    Array slice (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      Array X;
+      if (this->S == 0) return X;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      X.sizeAlloc(e - b + 1);
+      for (int k = 0; k < words(X.S); k++) X.W[k] = this->wordAt(b + (k << 6));
+      X.truncate(X.S);
+      return X;
+    }
+
+    /**
+     * @brief Return `Array` with unique elements, in order of their first occurrence (at most `2` elements)
+     * @return Array<bool> - Unique Array
+     */
+    Array unique () const {
+      Array X;
+      if (this->S == 0) return X;
+      bool first = this->get(0);
+      X.append(first);
+      if (this->any() && !this->all()) X.append(!first);
+      return X;
+    }
+
+    /**
+     * @brief Count `true` elements in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return int - Number of `true` elements
+     */
+    int countTrue (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      return this->countRange(b, e);
+    }
+
+    /**
+     * @brief Count how many `elems` exist in the `Array` in range `[from,to]`
+     * @param elem Search element
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return int - Successful search count
+     */
+    int count (bool elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      int cnt = this->countRange(b, e);
+      return elem ? cnt : e - b + 1 - cnt;
+    }
+
+    /**
+     * @brief Check if any element in range `[from,to]` is `true`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return true - At least one `true` element,
+     * @return false - No `true` elements (or empty Array)
+     */
+    bool any (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return false;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      return this->findRange(true, b, e) != -1;
+    }
+
+    /**
+     * @brief Check if all elements in range `[from,to]` are `true`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return true - All elements `true` (or empty Array),
+     * @return false - At least one `false` element
+     */
+    bool all (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return true;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      return this->findRange(false, b, e) == -1;
+    }
+
+    /**
+     * @brief Check if `Array` items in range `[from,to]` contain `elem`
+     * @param elem Search element
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return true - Element found,
+     * @return false - Element not found
+     */
+    bool contains (bool elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->find(elem, from, to) != -1; }
+
+    /**
+     * @brief Find first index of search `elem` in range `[from,to]`. Returns `-1` if none found
+     * @param elem Search element
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return int - Found index or `-1`
+     */
+    int find (bool elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return -1;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      return this->findRange(elem, b, e);
+    }
+
+    /**
+     * @brief Find all indices of search `elem` in range `[from,to]`. Returns empty Array if none found
+     * @param elem Search element
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<int> - Array of indices
+     */
+    Array<int, Alloc> findAll (bool elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      Array<int, Alloc> X;
+      if (this->S == 0) return X;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      X.reserve(this->count(elem, b, e));
+      int wb = b >> 6, we = e >> 6;
+      for (int k = wb; k <= we; k++) {
+        uint64_t w = elem ? this->W[k] : ~this->W[k];
+        if (k == wb) w &= ~(uint64_t) 0 << (b & 63);
+        if (k == we) w &= lowBits(e + 1);
+        while (w != 0) {
+          X.append((k << 6) + array_detail::ctz64(w));
+          w &= w - 1;
+        }
+      }
+      return X;
+    }
+
+    /**
+     * @brief Return elements whose `mask` element is `true`, in original order
+     * @param mask Boolean mask of the same size as the Array
+     * @return Array<bool> Selected elements
+     */
+    template <class MaskAlloc>
+    Array compress (const Array<bool, MaskAlloc> &mask) const {
+      if (mask.size() != this->S) throw std::invalid_argument("Mask size does not match Array size");
+      Array X(mask.countTrue());
+      int k = 0;
+      for (int j = 0; j < words(this->S); j++) {
+        uint64_t w = mask.W[j];
+        while (w != 0) {
+          X.put(k++, this->get((j << 6) + array_detail::ctz64(w)));
+          w &= w - 1;
+        }
+      }
+      return X;
+    }
+    template <class E>
+    Array compress (const ArrayExpr<E> &mask) const {
+      static_assert(std::is_same<typename E::value_type, bool>::value, "Mask expression must be boolean");
+      return this->compress(Array(mask));
+    }
+    /**
+     * @brief Return indices of `true` elements of `mask`
+     * @param mask Boolean mask of the same size as the Array
+     * @return Array<int> Indices in ascending order
+     */
+    template <class MaskAlloc>
+    Array<int, Alloc> where (const Array<bool, MaskAlloc> &mask) const {
+      if (mask.size() != this->S) throw std::invalid_argument("Mask size does not match Array size");
+      Array<int, Alloc> X;
+      int n = mask.countTrue();
+      if (n == 0) return X;
+      X.reallocate(n);
+      X.S = n;
+      array_detail::maskIndices(mask.W, this->S, X.A);
+      return X;
+    }
+    template <class E>
+    Array<int, Alloc> where (const ArrayExpr<E> &mask) const {
+      static_assert(std::is_same<typename E::value_type, bool>::value, "Mask expression must be boolean");
+      return this->where(Array(mask));
+    }
+
+    /**
+     * Array functors (same overloads as for other element types)
+     */
+
+    /**
+     * @brief Execute `func` for each element of the `Array`
+     * @param func Function to execute. Element is passed as an argument. Should return `void`.
+     */
+    void forEach (void (*func)(bool elem)) const {
+      for (int i = 0; i < this->S; i++) func(this->get(i));
+    }
+    /**
+     * @brief Execute `func` for each element of the `Array`
+     * @param func Function to execute. Arguments: element, index of an element. Should return `void`.
+     */
+    void forEach (void (*func)(bool elem, int index)) const {
+      for (int i = 0; i < this->S; i++) func(this->get(i), i);
+    }
+    /**
+     * @brief Execute `func` for each element of the `Array`
+     * @param func Function to execute. Arguments: element, index of an element, array. Should return `void`.
+     */
+    void forEach (void (*func)(bool elem, int index, const Array &array)) const {
+      for (int i = 0; i < this->S; i++) func(this->get(i), i, *this);
+    }
+    /**
+     * @brief Execute `func` for each element of the `Array`. Accepts any callable (capturing lambdas, functors), calls are inlined
+     * @param func Callable taking element, element and index, or element, index and array. Should return `void`.
+     */
+    template <class F>
+    void forEach (F func) const {
+      for (int i = 0; i < this->S; i++) array_detail::callElement(func, this->get(i), i, *this, array_detail::ArgsThree());
+    }
+
+    /**
+     * @brief Filters `Array` elements using `func` provided
+     * @param func Filtering function. Element is passed as an argument. Should return `bool`.
+     * @return Array<bool> Filtered `Array`
+     */
+    Array filter (bool (*func)(bool elem)) const { return this->filterElements(func); }
+    /**
+     * @brief Filters `Array` elements using `func` provided
+     * @param func Filtering function. Arguments: element, index of an element. Should return `bool`.
+     * @return Array<bool> Filtered `Array`
+     */
+    Array filter (bool (*func)(bool elem, int index)) const { return this->filterElements(func); }
+    /**
+     * @brief Filters `Array` elements using `func` provided
+     * @param func Filtering function. Arguments: element, index of an element, array. Should return `bool`.
+     * @return Array<bool> Filtered `Array`
+     */
+    Array filter (bool (*func)(bool elem, int index, const Array &array)) const { return this->filterElements(func); }
+    /**
+     * @brief Filters `Array` elements using `func` provided. Accepts any callable (capturing lambdas, functors), calls are inlined
+     * @param func Callable taking element, element and index, or element, index and array. Should return `bool`.
+     * @return Array<bool> Filtered `Array`
+     */
+    template <class F>
+    Array filter (F func) const { return this->filterElements(func); }
+
+    /**
+     * @brief Map `Array` elements using `func` provided
+     * @tparam U Destination `Array` type
+     * @param func Mapping function. Element is passed as an argument. Should return `U`.
+     * @return Array<U> Mapped `Array`
+     */
+    template <typename U>
+    Array<U, Alloc> map (U (*func)(bool elem)) const { return this->mapElements<U>(func); }
+    /**
+     * @brief Map `Array` elements using `func` provided
+     * @tparam U Destination `Array` type
+     * @param func Mapping function. Arguments: element, index of an element. Should return `U`.
+     * @return Array<U> Mapped `Array`
+     */
+    template <typename U>
+    Array<U, Alloc> map (U (*func)(bool elem, int index)) const { return this->mapElements<U>(func); }
+    /**
+     * @brief Map `Array` elements using `func` provided
+     * @tparam U Destination `Array` type
+     * @param func Mapping function. Arguments: element, index of an element, array. Should return `U`.
+     * @return Array<U> Mapped `Array`
+     */
+    template <typename U>
+    Array<U, Alloc> map (U (*func)(bool elem, int index, const Array &array)) const { return this->mapElements<U>(func); }
+    /**
+     * @brief Map `Array` elements using `func` provided. Accepts any callable (capturing lambdas, functors), calls are inlined
+     * @tparam U Destination `Array` type. Default: result type of `func`
+     * @param func Callable taking element, element and index, or element, index and array. Should return `U`.
+     * @return Array<U> Mapped `Array`
+     */
+    template <typename U = void, class F>
+    Array<typename array_detail::MapType<U, F, bool, Array>::type, Alloc> map (F func) const {
+      return this->mapElements<typename array_detail::MapType<U, F, bool, Array>::type>(func);
+    }
+
+    /**
+     * @brief Execute `func` for each element of the `Array` in parallel. Order of calls is unspecified
+     * @param policy Execution policy
+     * @param func Callable taking element, element and index, or element, index and array. Should return `void`.
+     */
+    template <class F>
+    void forEach (const ArrayPolicy &policy, F func) const {
+      int tasks = policy.tasks(this->S);
+      if (tasks <= 1) return this->forEach(func);
+      array_detail::parallelChunks(0, this->S - 1, tasks, [&] (int, int lo, int hi) {
+        for (int i = lo; i <= hi; i++) array_detail::callElement(func, this->get(i), i, *this, array_detail::ArgsThree());
+      });
+    }
+    /**
+     * @brief Filters `Array` elements using `func` in parallel. Chunks evaluate `func`, kept elements are then packed
+     * in one serial pass (tasks would share output words). Result is the same as for the serial `filter`
+     * @param policy Execution policy
+     * @param func Callable taking element, element and index, or element, index and array. Should return `bool`.
+     * @return Array<bool> Filtered `Array`
+     */
+    template <class F>
+    Array filter (const ArrayPolicy &policy, F func) const {
+      int tasks = policy.tasks(this->S);
+      if (tasks <= 1) return this->filterElements(func);
+      std::vector<unsigned char> keep(this->S);
+      array_detail::parallelChunks(0, this->S - 1, tasks, [&] (int, int lo, int hi) {
+        for (int i = lo; i <= hi; i++) keep[i] = array_detail::callElement(func, this->get(i), i, *this, array_detail::ArgsThree()) ? 1 : 0;
+      });
+      Array X(this->S);
+      int k = 0;
+      for (int i = 0; i < this->S; i++) {
+        if (keep[i]) X.put(k++, this->get(i));
+      }
+      X.truncate(k);
+      return X;
+    }
+    /**
+     * @brief Map `Array` elements using `func` in parallel. Results are written directly into a pre-sized `Array`
+     * @tparam U Destination `Array` type. Default: result type of `func`
+     * @param policy Execution policy
+     * @param func Callable taking element, element and index, or element, index and array. Should return `U`.
+     * @return Array<U> Mapped `Array`
+     */
+    template <typename U = void, class F>
+    Array<typename array_detail::MapType<U, F, bool, Array>::type, Alloc> map (const ArrayPolicy &policy, F func) const {
+      typedef typename array_detail::MapType<U, F, bool, Array>::type R;
+      int tasks = policy.tasks(this->S);
+      if (tasks <= 1) return this->mapElements<R>(func);
+      Array<R, Alloc> X;
+      X.sizeAlloc(this->S);
+      // Chunks start at multiples of 64, so no two tasks write the same word of a packed `Array<bool>`
+      ArrayThreadPool::shared().run(tasks, [&] (int c) {
+        int lo = (int) (((long long) this->S * c / tasks) & ~63LL);
+        int hi = c + 1 == tasks ? this->S : (int) (((long long) this->S * (c + 1) / tasks) & ~63LL);
+        for (int i = lo; i < hi; i++) X.put(i, array_detail::callElement(func, this->get(i), i, *this, array_detail::ArgsThree()));
+      });
+      return X;
+    }
+
+    /**
+     * @brief Return `Array` in different type `U` (`true` -> `1`, `false` -> `0`)
+     * @tparam U Destination `Array` type
+     * @return Array<U> Re-typed `Array`
+     */
+    template <typename U>
+    Array<U, Alloc> astype () const {
+      Array<U, Alloc> X;
+      X.sizeAlloc(this->S);
+      for (int i = 0; i < this->S; i++) X.put(i, (U) this->get(i));
       return X;
     }
-    Array<T> operator[] (const std::vector <int> &index) const { return this->operator[](Array<int>::fromVector(index)); }
-    Array<T> operator[] (const std::list <int> &index) const { return this->operator[](Array<int>::fromList(index)); }
-    Array<T> operator[] (const std::set <int> &index) const { return this->operator[](Array<int>::fromSet(index)); }
-    Array<T> operator[] (const std::initializer_list <int> &index) const { return this->operator[](Array<int>::fromInitList(index)); }
 
     /**
-     * @brief Append `elem` to the end of Array
-     * @param elem 
+     * @brief Convert `Array` to `std::vector`
+     * @return std::vector<bool> 
      */
-    void append (const T& elem) {
-      int newSize = this->S + 1;
-      checkSize(newSize);
-      this->A = (T*)realloc(this->A, newSize * sizeof(T));
-      if (this->A == NULL) throw std::invalid_argument("Failed to Allocate Memory");
-      this->A[newSize - 1] = elem;
-      this->S++;
+    std::vector<bool> toVector () const {
+      std::vector<bool> vec(this->S);
+      for (int i = 0; i < this->S; i++) vec[i] = this->get(i);
+      return vec;
     }
+
     /**
-     * @brief Append `array` to the end of Array
-     * @param array 
+     * @brief Convert `Array` to `std::list`
+     * @return std::list<bool> 
      */
-    void append (const Array<T>& array) {
-      if (array.size() == 0) return;
-      int newSize = this->S + array.size();
-      checkSize(newSize);
-      this->A = (T*)realloc(this->A, newSize * sizeof(T));
-      if (this->A == NULL) throw std::invalid_argument("Failed to Allocate Memory");
-      for (int i = 0; i < array.size(); i++) this->A[this->S + i] = array[i];
-      this->S += array.size();
+    std::list<bool> toList () const {
+      std::list<bool> lst;
+      for (int i = 0; i < this->S; i++) lst.push_back(this->get(i));
+      return lst;
     }
-    void append (const std::vector < T > &STL_Vector) { append(fromVector(STL_Vector)); }
-    void append (const std::list < T > &STL_List) { append(fromList(STL_List)); }
-    void append (const std::set < T > &STL_Set) { append(fromSet(STL_Set)); }
-    void append (std::initializer_list<T> InitValues) { append(fromInitList(InitValues)); }
-    void append (T* ptr, int size) { append(fromPointer(ptr, size)); }
 
     /**
-     * @brief Insert `elem` into Array at specific `index`
-     * @param elem 
-     * @param index Default 0
+     * @brief Convert `Array` to `std::set`
+     * @return std::set<bool> 
      */
-    void insert (const T& elem, int index = ARRAY_BEGIN) {
-      int newSize = this->S + 1;
-      checkSize(newSize);
-      int i_idx = idx(index);
-      this->A = (T*)realloc(this->A, newSize * sizeof(T));
-      if (this->A == NULL) throw std::invalid_argument("Failed to Allocate Memory");
-      for (int i = newSize - 1; i > i_idx; i--) this->A[i] = this->A[i - 1];
-      this->A[i_idx] = elem;
-      this->S++;
+    std::set<bool> toSet () const {
+      std::set<bool> st;
+      if (this->S == 0) return st;
+      if (!this->all()) st.insert(false);
+      if (this->any()) st.insert(true);
+      return st;
     }
+
     /**
-     * @brief Insert `array` into Array at specific `index`
-     * @param array 
-     * @param index Default 0
+     * Numeric methods (`false` = 0, `true` = 1), answered from popcounts and word scans
      */
-    void insert (const Array<T>& array, int index = ARRAY_BEGIN) {
-      if (array.size() == 0) return;
-      int newSize = this->S + array.size();
-      checkSize(newSize);
-      int i_idx = idx(index);
-      this->A = (T*)realloc(this->A, newSize * sizeof(T));
-      if (this->A == NULL) throw std::invalid_argument("Failed to Allocate Memory");
-      for (int i = newSize - 1; i >= i_idx + array.size(); i--) this->A[i] = this->A[i - array.size()];
-      for (int i = 0; i < array.size(); i++) this->A[i_idx + i] = array[i];
-      this->S += array.size();
-    }
-    void insert (const std::vector < T > &STL_Vector, int index = ARRAY_BEGIN) { insert(fromVector(STL_Vector), index); }
-    void insert (const std::list < T > &STL_List, int index = ARRAY_BEGIN) { insert(fromList(STL_List), index); }
-    void insert (const std::set < T > &STL_Set, int index = ARRAY_BEGIN) { insert(fromSet(STL_Set), index); }
-    void insert (std::initializer_list<T> InitValues, int index = ARRAY_BEGIN) { insert(fromInitList(InitValues), index); }
-    void insert (T* ptr, int size, int index = ARRAY_BEGIN) { insert(fromPointer(ptr, size), index); }
 
     /**
-     * @brief Delete n = `count` Array elements starting from `index`
-     * @param index Default 0
-     * @param count Default 1
+     * @brief Get min value of `Array` items in range `[from,to]` (same as `all`)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return bool - min value (`false` for empty Array)
      */
-    void erase (int index = ARRAY_BEGIN, int count = 1) {
-      if (this->S == 0 || count <= 0) return;
-      int e_idx = idx(index);
-      int c_count = e_idx + count > this->S ? (e_idx + count - this->S + 1) : count;
-      int newSize = this->S - c_count;
-      checkSize(newSize);
-      if (newSize == 0) {
-        this->A = nullptr;
-        this->S = 0;
-        return;
-      }
-      if (e_idx + c_count >= this->S) {
-        this->A = (T*)realloc(this->A, newSize * sizeof(T));
-        this->S = newSize;
-        return;
-      }
-      for (int i = e_idx + count; i < this->S; i++) this->A[i - count] = this->A[i];
-      this->A = (T*)realloc(this->A, newSize * sizeof(T));
-      this->S = newSize;
+    bool min (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return false;
+      return this->all(from, to);
     }
-
     /**
-     * @brief Fill the Array with `elem` in range `[from,to]`
-     * @param elem 
+     * @brief Get max value of `Array` items in range `[from,to]` (same as `any`)
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
+     * @return bool - max value (`false` for empty Array)
      */
-    void fill (const T& elem, int from = ARRAY_BEGIN, int to = ARRAY_END) {
-      if (this->S == 0) return;
+    bool max (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->any(from, to); }
+    /**
+     * @brief Get indices of min values of `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<int> - min values' indices
+     */
+    Array<int, Alloc> argmin (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return Array<int, Alloc>();
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      for (int i = b; i <= e; i++) this->A[i] = elem;
+      return this->findAll(this->findRange(false, b, e) == -1, b, e);
     }
-
     /**
-     * @brief Fill the Array with specific `pattern` in range `[from,to]`
-     * @param pattern Array Pattern
-     * @param mode `'r'` - Repeating (default) - repeats pattern values if pattern is smaller than fill range.
-     * `'s'` - Stretch - copies pattern values to match fill range length
+     * @brief Get indices of max values of `Array` items in range `[from,to]`
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
+     * @return Array<int> - max values' indices
      */
-    void fill (const Array<T>& pattern, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) {
-      if (this->S == 0 || pattern.size() == 0) return;
-      if (pattern.size() == 1) {
-        this->fill(pattern[0], from, to);
-        return;
-      }
-      if (mode != 'r' && mode != 's') throw std::invalid_argument("Mode should be s - stretch or r - repeat");
+    Array<int, Alloc> argmax (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return Array<int, Alloc>();
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      if (mode == 'r') {
-        for (int i = b; i <= e; i++) this->A[i] = pattern[(i - b) % pattern.size()];
-        return;
-      }
-      for (int i = b; i <= e; i++) {
-        int index = (int) floor((i - b) * pattern.size() / (e - b + 1.0));
-        this->A[i] = pattern[index];
-      }
+      return this->findAll(this->findRange(true, b, e) != -1, b, e);
     }
-    void fill (const std::vector < T > &pattern, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) { fill(fromVector(pattern), mode, from, to); }
-    void fill (const std::list < T > &pattern, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) { fill(fromList(pattern), mode, from, to); }
-    void fill (const std::set < T > &pattern, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) { fill(fromSet(pattern), mode, from, to); }
-    void fill (std::initializer_list<T> pattern, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) { fill(fromInitList(pattern), mode, from, to); }
-    void fill (T* pattern, int size, char mode = 'r', int from = ARRAY_BEGIN, int to = ARRAY_END) { fill(fromPointer(pattern, size), mode, from, to); }
-
     /**
-     * @brief Reverse `Array` items in range `[from,to]`
+     * @brief Get Sum of the `Array` items in range `[from,to]`, i.e. number of `true` items (same as `countTrue`)
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
+     * @return int - sum
      */
-    void reverse (int from = ARRAY_BEGIN, int to = ARRAY_END) {
-      if (this->S == 0) return;
+    int sum (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->countTrue(from, to); }
+    /**
+     * @brief Get Product of the `Array` items in range `[from,to]` (same as `all`)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return bool - product (`false` for empty Array)
+     */
+    bool product (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->min(from, to); }
+    /**
+     * @brief Get Arithmetic Mean of the `Array` items in range `[from,to]` (fraction of `true` items)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - arithmetic mean
+     */
+    double mean (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      for (int i = b; i < (e + b + 1) / 2; i++) {
-        T temp = this->A[i];
-        this->A[i] = this->A[e - i + b];
-        this->A[e - i + b] = temp;
-      }
+      return (this->countRange(b, e) * 1.0) / (e - b + 1.0);
     }
-
     /**
-     * @brief Remove all elements of the `Array`
+     * @brief Get Geometric Mean of the `Array` items in range `[from,to]` (`1` if all items are `true`, else `0`)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - geometric mean
      */
-    void clear () {
-      if (this->S == 0) return;
-      this->A = nullptr;
-      this->S = 0;
-    }
-
+    double meanG (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->min(from, to) ? 1.0 : 0.0; }
     /**
-     * @brief Resize the `Array` into specified size.
-     * @warning Resizing array into smaller size will remove the data which is out of bounds. Resizing to `0` removes data completely
-     * @param size New Size
+     * @brief Get Harmonic Mean of the `Array` items in range `[from,to]` (`1` if all items are `true`, else `0`)
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - harmonic mean
      */
-    void resize (int size) {
-      checkSize(size);
-      T *new_a = (T*)calloc(size, sizeof(T));
-      if (new_a == NULL) throw std::invalid_argument("Failed to Allocate Memory");
-      memcpy(new_a, this->A, this->S * sizeof(T));
-      this->S = size;
-      free(this->A);
-      this->A = new_a;
-    }
-
+    double meanH (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return this->min(from, to) ? 1.0 : 0.0; }
     /**
-     * @brief Shift `Array` items in range `[from,to]` by specified `amount`
-     * @param amount Shift amount. If negative, it shifts to the left
+     * @brief Get Weighted Mean of the `Array` items in range `[from,to]` using `weights` array
+     * @param weights Weights Array. If shorter than `[from,to]` range, weights for remaining elements will be `0`.
+     * If longer than `[from,to]` range, remaining weights will not be used.
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
+     * @return double - Weighted mean
      */
-    void shift (int amount, int from = ARRAY_BEGIN, int to = ARRAY_END) {
-      if (this->S == 0 || amount == 0) return;
+    double weightedMean (Array<double> weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0 || weights.size() == 0) return 0;
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      int len = e - b + 1;
-      if (amount % len == 0 || len <= 1) return;
-      Array<T> temp = *this;
+      double s = 0.0, ws = 0.0;
       for (int i = b; i <= e; i++) {
-        int destIndex = b + ((i + amount - b) % len);
-        if (destIndex < b) destIndex = len + ((i + amount) % len);
-        this->A[destIndex] = temp[i];
+        int wIdx = i - b;
+        if (wIdx >= weights.size()) break;
+        if (this->get(i)) s += weights[wIdx];
+        ws += weights[wIdx];
       }
+      return s / ws;
     }
-
+    double weightedMean (const std::vector < double > &weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromVector(weights), from, to); }
+    double weightedMean (const std::list < double > &weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromList(weights), from, to); }
+    double weightedMean (const std::set < double > &weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromSet(weights), from, to); }
+    double weightedMean (std::initializer_list<double> weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromInitList(weights), from, to); }
+    double weightedMean (double* weights, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromPointer(weights, size), from, to); }
     /**
-     * @brief Replace all `Array` items in range `[from,to]`, which are `searchElem` with value of `replaceWith`
-     * @param searchElem Search Element
-     * @param replaceWith Replace Value
+     * @brief Get sample Variance of the `Array` items in range `[from,to]` (normalized by the range length - 1).
+     * With `k` `true` items out of `n` it is `k * (n - k) / (n * (n - 1))`
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
+     * @return double - variance
      */
-    void replace (const T& searchElem, const T& replaceWith, int from = ARRAY_BEGIN, int to = ARRAY_END) {
-      if (this->S == 0) return;
+    double variance (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      for (int i = b; i <= e; i++) {
-        if (this->A[i] == searchElem) this->A[i] = replaceWith;
+      double n = e - b + 1.0, k = this->countRange(b, e);
+      if (n <= 1) return 0;
+      return k * (n - k) / (n * (n - 1.0));
+    }
+    /**
+     * @brief Get Standard Deviation of the `Array` items in range `[from,to]`
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - standard deviation
+     */
+    double stdev (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return sqrt(this->variance(from, to)); }
+
+    /*
+     * OPERATORS
+     */
+    // Copy assignment operator
+    Array& operator= (const Array& other) {
+      if (this != &other) {
+        if (other.S > this->C) {
+          Array X(other);
+          *this = std::move(X);
+          return *this;
+        }
+        int n = words(other.S);
+        if (n > 0) memcpy((void*) this->W, (const void*) other.W, n * sizeof(uint64_t));
+        for (int k = n; k < words(this->S); k++) this->W[k] = 0;
+        this->S = other.S;
+      }
+      return *this;
+    }
+    // Move assignment operator
+    Array& operator= (Array&& other) noexcept {
+      if (this != &other) {
+        Alloc::deallocate(this->W, words(this->C) * sizeof(uint64_t));
+        this->S = other.S;
+        this->C = other.C;
+        this->W = other.W;
+        other.S = 0;
+        other.C = 0;
+        other.W = nullptr;
       }
+      return *this;
+    }
+    // Expression assignment operator (evaluates `expr` in a single pass)
+    template <class E>
+    Array& operator= (const ArrayExpr<E> &expr) {
+      this->assignExpr(expr);
+      return *this;
+    }
+
+    /**
+     * @brief Lazy expression reading this Array. Starting point for fused expressions, e.g. `(m.expr() + n).countTrue()`
+     * @return ArrayExpr
+     */
+    ArrayExpr<Leaf> expr () const { return ArrayExpr<Leaf>(Leaf(*this)); }
+
+    /*
+     * Arithmetic operations (elements as `0` / `1`, results converted back to `bool`). Return lazy `ArrayExpr`
+     */
+    ScalarExpr<array_detail::OP_ADD> operator+ (bool number) const { return this->scalarExpr<array_detail::OP_ADD>(number); }
+    ScalarExpr<array_detail::OP_SUB> operator- (bool number) const { return this->scalarExpr<array_detail::OP_SUB>(number); }
+    ScalarExpr<array_detail::OP_MUL> operator* (bool number) const { return this->scalarExpr<array_detail::OP_MUL>(number); }
+    ScalarExpr<array_detail::OP_DIV> operator/ (bool number) const { return this->scalarExpr<array_detail::OP_DIV>(number); }
+    ScalarExpr<array_detail::OP_MOD> operator% (bool number) const { return this->scalarExpr<array_detail::OP_MOD>(number); }
+    BinaryExpr<array_detail::OP_ADD> operator+ (const Array& array) const { return this->binaryExpr<array_detail::OP_ADD>(array); }
+    Array operator+ (const std::vector <bool> &STL_Vector) const { return this->operator+(fromVector(STL_Vector)); }
+    Array operator+ (const std::list <bool> &STL_List) const { return this->operator+(fromList(STL_List)); }
+    Array operator+ (const std::set <bool> &STL_Set) const { return this->operator+(fromSet(STL_Set)); }
+    Array operator+ (const std::initializer_list <bool> &STL_InitList) const { return this->operator+(fromInitList(STL_InitList)); }
+    BinaryExpr<array_detail::OP_SUB> operator- (const Array& array) const { return this->binaryExpr<array_detail::OP_SUB>(array); }
+    Array operator- (const std::vector <bool> &STL_Vector) const { return this->operator-(fromVector(STL_Vector)); }
+    Array operator- (const std::list <bool> &STL_List) const { return this->operator-(fromList(STL_List)); }
+    Array operator- (const std::set <bool> &STL_Set) const { return this->operator-(fromSet(STL_Set)); }
+    Array operator- (const std::initializer_list <bool> &STL_InitList) const { return this->operator-(fromInitList(STL_InitList)); }
+    BinaryExpr<array_detail::OP_MUL> operator* (const Array& array) const { return this->binaryExpr<array_detail::OP_MUL>(array); }
+    Array operator* (const std::vector <bool> &STL_Vector) const { return this->operator*(fromVector(STL_Vector)); }
+    Array operator* (const std::list <bool> &STL_List) const { return this->operator*(fromList(STL_List)); }
+    Array operator* (const std::set <bool> &STL_Set) const { return this->operator*(fromSet(STL_Set)); }
+    Array operator* (const std::initializer_list <bool> &STL_InitList) const { return this->operator*(fromInitList(STL_InitList)); }
+    BinaryExpr<array_detail::OP_DIV> operator/ (const Array& array) const { return this->binaryExpr<array_detail::OP_DIV>(array); }
+    Array operator/ (const std::vector <bool> &STL_Vector) const { return this->operator/(fromVector(STL_Vector)); }
+    Array operator/ (const std::list <bool> &STL_List) const { return this->operator/(fromList(STL_List)); }
+    Array operator/ (const std::set <bool> &STL_Set) const { return this->operator/(fromSet(STL_Set)); }
+    Array operator/ (const std::initializer_list <bool> &STL_InitList) const { return this->operator/(fromInitList(STL_InitList)); }
+    BinaryExpr<array_detail::OP_MOD> operator% (const Array& array) const { return this->binaryExpr<array_detail::OP_MOD>(array); }
+    Array operator% (const std::vector <bool> &STL_Vector) const { return this->operator%(fromVector(STL_Vector)); }
+    Array operator% (const std::list <bool> &STL_List) const { return this->operator%(fromList(STL_List)); }
+    Array operator% (const std::set <bool> &STL_Set) const { return this->operator%(fromSet(STL_Set)); }
+    Array operator% (const std::initializer_list <bool> &STL_InitList) const { return this->operator%(fromInitList(STL_InitList)); }
+
+    /*
+     * Arithmetic operations modifying the Array
+     */
+    Array& operator+= (bool number) { return *this = this->scalarExpr<array_detail::OP_ADD>(number); }
+    Array& operator-= (bool number) { return *this = this->scalarExpr<array_detail::OP_SUB>(number); }
+    Array& operator*= (bool number) { return *this = this->scalarExpr<array_detail::OP_MUL>(number); }
+    Array& operator/= (bool number) { return *this = this->scalarExpr<array_detail::OP_DIV>(number); }
+    Array& operator%= (bool number) { return *this = this->scalarExpr<array_detail::OP_MOD>(number); }
+    Array& operator+= (const Array &array) { return this->arithAssignExpr<array_detail::OP_ADD>(array.expr()); }
+    template <class E>
+    Array& operator+= (const ArrayExpr<E> &expr) { return this->arithAssignExpr<array_detail::OP_ADD>(expr); }
+    Array& operator+= (const std::vector <bool> &STL_Vector) { return this->operator+=(fromVector(STL_Vector)); }
+    Array& operator+= (const std::list <bool> &STL_List) { return this->operator+=(fromList(STL_List)); }
+    Array& operator+= (const std::set <bool> &STL_Set) { return this->operator+=(fromSet(STL_Set)); }
+    Array& operator+= (const std::initializer_list <bool> &STL_InitList) { return this->operator+=(fromInitList(STL_InitList)); }
+    Array& operator-= (const Array &array) { return this->arithAssignExpr<array_detail::OP_SUB>(array.expr()); }
+    template <class E>
+    Array& operator-= (const ArrayExpr<E> &expr) { return this->arithAssignExpr<array_detail::OP_SUB>(expr); }
+    Array& operator-= (const std::vector <bool> &STL_Vector) { return this->operator-=(fromVector(STL_Vector)); }
+    Array& operator-= (const std::list <bool> &STL_List) { return this->operator-=(fromList(STL_List)); }
+    Array& operator-= (const std::set <bool> &STL_Set) { return this->operator-=(fromSet(STL_Set)); }
+    Array& operator-= (const std::initializer_list <bool> &STL_InitList) { return this->operator-=(fromInitList(STL_InitList)); }
+    Array& operator*= (const Array &array) { return this->arithAssignExpr<array_detail::OP_MUL>(array.expr()); }
+    template <class E>
+    Array& operator*= (const ArrayExpr<E> &expr) { return this->arithAssignExpr<array_detail::OP_MUL>(expr); }
+    Array& operator*= (const std::vector <bool> &STL_Vector) { return this->operator*=(fromVector(STL_Vector)); }
+    Array& operator*= (const std::list <bool> &STL_List) { return this->operator*=(fromList(STL_List)); }
+    Array& operator*= (const std::set <bool> &STL_Set) { return this->operator*=(fromSet(STL_Set)); }
+    Array& operator*= (const std::initializer_list <bool> &STL_InitList) { return this->operator*=(fromInitList(STL_InitList)); }
+    Array& operator/= (const Array &array) { return this->arithAssignExpr<array_detail::OP_DIV>(array.expr()); }
+    template <class E>
+    Array& operator/= (const ArrayExpr<E> &expr) { return this->arithAssignExpr<array_detail::OP_DIV>(expr); }
+    Array& operator/= (const std::vector <bool> &STL_Vector) { return this->operator/=(fromVector(STL_Vector)); }
+    Array& operator/= (const std::list <bool> &STL_List) { return this->operator/=(fromList(STL_List)); }
+    Array& operator/= (const std::set <bool> &STL_Set) { return this->operator/=(fromSet(STL_Set)); }
+    Array& operator/= (const std::initializer_list <bool> &STL_InitList) { return this->operator/=(fromInitList(STL_InitList)); }
+    Array& operator%= (const Array &array) { return this->arithAssignExpr<array_detail::OP_MOD>(array.expr()); }
+    template <class E>
+    Array& operator%= (const ArrayExpr<E> &expr) { return this->arithAssignExpr<array_detail::OP_MOD>(expr); }
+    Array& operator%= (const std::vector <bool> &STL_Vector) { return this->operator%=(fromVector(STL_Vector)); }
+    Array& operator%= (const std::list <bool> &STL_List) { return this->operator%=(fromList(STL_List)); }
+    Array& operator%= (const std::set <bool> &STL_Set) { return this->operator%=(fromSet(STL_Set)); }
+    Array& operator%= (const std::initializer_list <bool> &STL_InitList) { return this->operator%=(fromInitList(STL_InitList)); }
+
+    /*
+     * Element-wise comparison with another mask. Elements outside the shorter Array compare as `false`
+     */
+    Array operator== (const Array &mask) const { return this->compareMask(mask, true); }
+    Array operator== (const std::vector <bool> &STL_Vector) const { return this->operator==(fromVector(STL_Vector)); }
+    Array operator== (const std::list <bool> &STL_List) const { return this->operator==(fromList(STL_List)); }
+    Array operator== (const std::set <bool> &STL_Set) const { return this->operator==(fromSet(STL_Set)); }
+    Array operator== (const std::initializer_list <bool> &STL_InitList) const { return this->operator==(fromInitList(STL_InitList)); }
+    Array operator!= (const Array &mask) const { return this->compareMask(mask, false); }
+    Array operator!= (const std::vector <bool> &STL_Vector) const { return this->operator!=(fromVector(STL_Vector)); }
+    Array operator!= (const std::list <bool> &STL_List) const { return this->operator!=(fromList(STL_List)); }
+    Array operator!= (const std::set <bool> &STL_Set) const { return this->operator!=(fromSet(STL_Set)); }
+    Array operator!= (const std::initializer_list <bool> &STL_InitList) const { return this->operator!=(fromInitList(STL_InitList)); }
+    Array operator== (bool val) const { return val ? *this : !*this; }
+    Array operator!= (bool val) const { return val ? !*this : *this; }
+
+    /*
+     * Ordering comparisons (`false < true`). Return lazy `ArrayExpr` of `bool`, elements outside the shorter Array are `false`
+     */
+    CompareScalarExpr<array_detail::CMP_LT> operator< (bool val) const { return this->compareScalarExpr<array_detail::CMP_LT>(val); }
+    CompareScalarExpr<array_detail::CMP_LE> operator<= (bool val) const { return this->compareScalarExpr<array_detail::CMP_LE>(val); }
+    CompareScalarExpr<array_detail::CMP_GT> operator> (bool val) const { return this->compareScalarExpr<array_detail::CMP_GT>(val); }
+    CompareScalarExpr<array_detail::CMP_GE> operator>= (bool val) const { return this->compareScalarExpr<array_detail::CMP_GE>(val); }
+    CompareExpr<array_detail::CMP_LT> operator< (const Array &mask) const { return this->compareExpr<array_detail::CMP_LT>(mask); }
+    Array operator< (const std::vector <bool> &STL_Vector) const { return this->operator<(fromVector(STL_Vector)); }
+    Array operator< (const std::list <bool> &STL_List) const { return this->operator<(fromList(STL_List)); }
+    Array operator< (const std::set <bool> &STL_Set) const { return this->operator<(fromSet(STL_Set)); }
+    Array operator< (const std::initializer_list <bool> &STL_InitList) const { return this->operator<(fromInitList(STL_InitList)); }
+    CompareExpr<array_detail::CMP_LE> operator<= (const Array &mask) const { return this->compareExpr<array_detail::CMP_LE>(mask); }
+    Array operator<= (const std::vector <bool> &STL_Vector) const { return this->operator<=(fromVector(STL_Vector)); }
+    Array operator<= (const std::list <bool> &STL_List) const { return this->operator<=(fromList(STL_List)); }
+    Array operator<= (const std::set <bool> &STL_Set) const { return this->operator<=(fromSet(STL_Set)); }
+    Array operator<= (const std::initializer_list <bool> &STL_InitList) const { return this->operator<=(fromInitList(STL_InitList)); }
+    CompareExpr<array_detail::CMP_GT> operator> (const Array &mask) const { return this->compareExpr<array_detail::CMP_GT>(mask); }
+    Array operator> (const std::vector <bool> &STL_Vector) const { return this->operator>(fromVector(STL_Vector)); }
+    Array operator> (const std::list <bool> &STL_List) const { return this->operator>(fromList(STL_List)); }
+    Array operator> (const std::set <bool> &STL_Set) const { return this->operator>(fromSet(STL_Set)); }
+    Array operator> (const std::initializer_list <bool> &STL_InitList) const { return this->operator>(fromInitList(STL_InitList)); }
+    CompareExpr<array_detail::CMP_GE> operator>= (const Array &mask) const { return this->compareExpr<array_detail::CMP_GE>(mask); }
+    Array operator>= (const std::vector <bool> &STL_Vector) const { return this->operator>=(fromVector(STL_Vector)); }
+    Array operator>= (const std::list <bool> &STL_List) const { return this->operator>=(fromList(STL_List)); }
+    Array operator>= (const std::set <bool> &STL_Set) const { return this->operator>=(fromSet(STL_Set)); }
+    Array operator>= (const std::initializer_list <bool> &STL_InitList) const { return this->operator>=(fromInitList(STL_InitList)); }
+
+    /**
+     * Boolean operators for Array Masks (Keeping inital Array Masks)
+     */
+    Array operator! () const {
+      Array X;
+      X.wordsAlloc(this->S);
+      for (int k = 0; k < words(X.S); k++) X.W[k] = ~this->W[k];
+      X.truncate(X.S);
+      return X;
+    }
+    // Same as `operator!`
+    Array operator~ () const { return !*this; }
+    Array operator| (const Array &mask) const {
+      return this->combine<array_detail::OP_OR>(mask);
+    }
+    Array operator| (const std::vector<bool> &mask) const { return this->operator|(fromVector(mask)); }
+    Array operator| (const std::list<bool> &mask) const { return this->operator|(fromList(mask)); }
+    Array operator| (const std::set<bool> &mask) const { return this->operator|(fromSet(mask)); }
+    Array operator| (const std::initializer_list<bool> &mask) const { return this->operator|(fromInitList(mask)); }
+    Array operator& (const Array &mask) const {
+      return this->combine<array_detail::OP_AND>(mask);
+    }
+    Array operator& (const std::vector<bool> &mask) const { return this->operator&(fromVector(mask)); }
+    Array operator& (const std::list<bool> &mask) const { return this->operator&(fromList(mask)); }
+    Array operator& (const std::set<bool> &mask) const { return this->operator&(fromSet(mask)); }
+    Array operator& (const std::initializer_list<bool> &mask) const { return this->operator&(fromInitList(mask)); }
+    Array operator^ (const Array &mask) const {
+      return this->combine<array_detail::OP_XOR>(mask);
+    }
+    Array operator^ (const std::vector<bool> &mask) const { return this->operator^(fromVector(mask)); }
+    Array operator^ (const std::list<bool> &mask) const { return this->operator^(fromList(mask)); }
+    Array operator^ (const std::set<bool> &mask) const { return this->operator^(fromSet(mask)); }
+    Array operator^ (const std::initializer_list<bool> &mask) const { return this->operator^(fromInitList(mask)); }
+
+    /**
+     * Boolean operators with `bool` constant for Array Mask (Keeping inital Array Mask)
+     */
+    Array operator| (bool val) const {
+      Array X(*this);
+      if (val) X.fill(true);
+      return X;
+    }
+    Array operator& (bool val) const {
+      Array X(*this);
+      if (!val) X.fill(false);
+      return X;
+    }
+    Array operator^ (bool val) const { return val ? !*this : *this; }
+
+    /**
+     * Boolean operators for Array Masks (modifying initial Array Mask)
+     */
+    Array& operator|= (const Array &mask) { return this->maskAssign<array_detail::OP_OR>(mask); }
+    Array& operator|= (const std::vector<bool> &mask) { return this->operator|=(fromVector(mask)); }
+    Array& operator|= (const std::list<bool> &mask) { return this->operator|=(fromList(mask)); }
+    Array& operator|= (const std::set<bool> &mask) { return this->operator|=(fromSet(mask)); }
+    Array& operator|= (const std::initializer_list<bool> &mask) { return this->operator|=(fromInitList(mask)); }
+    Array& operator&= (const Array &mask) { return this->maskAssign<array_detail::OP_AND>(mask); }
+    Array& operator&= (const std::vector<bool> &mask) { return this->operator&=(fromVector(mask)); }
+    Array& operator&= (const std::list<bool> &mask) { return this->operator&=(fromList(mask)); }
+    Array& operator&= (const std::set<bool> &mask) { return this->operator&=(fromSet(mask)); }
+    Array& operator&= (const std::initializer_list<bool> &mask) { return this->operator&=(fromInitList(mask)); }
+    Array& operator^= (const Array &mask) { return this->maskAssign<array_detail::OP_XOR>(mask); }
+    Array& operator^= (const std::vector<bool> &mask) { return this->operator^=(fromVector(mask)); }
+    Array& operator^= (const std::list<bool> &mask) { return this->operator^=(fromList(mask)); }
+    Array& operator^= (const std::set<bool> &mask) { return this->operator^=(fromSet(mask)); }
+    Array& operator^= (const std::initializer_list<bool> &mask) { return this->operator^=(fromInitList(mask)); }
+};
+
+/*
+ * Operators combining `ArrayExpr` with other expressions, `Array` / `ArrayView` operands and constants.
+ * `Array` and `ArrayView` mix in either order
+ */
+#define ARRAY_EXPR_OPERATOR(OP, NODE, CODE) \
+  template <class L, class R> \
+  ArrayExpr<array_detail::NODE<CODE, L, R>> operator OP (const ArrayExpr<L> &l, const ArrayExpr<R> &r) { \
+    return ArrayExpr<array_detail::NODE<CODE, L, R>>(array_detail::NODE<CODE, L, R>(l.node(), r.node())); \
+  } \
+  template <class L, class T, class A> \
+  ArrayExpr<array_detail::NODE<CODE, L, array_detail::LeafNode<T>>> operator OP (const ArrayExpr<L> &l, const Array<T, A> &r) { \
+    typedef array_detail::NODE<CODE, L, array_detail::LeafNode<T>> Node; \
+    return ArrayExpr<Node>(Node(l.node(), array_detail::LeafNode<T>(r))); \
+  } \
+  template <class T, class A, class R> \
+  ArrayExpr<array_detail::NODE<CODE, array_detail::LeafNode<T>, R>> operator OP (const Array<T, A> &l, const ArrayExpr<R> &r) { \
+    typedef array_detail::NODE<CODE, array_detail::LeafNode<T>, R> Node; \
+    return ArrayExpr<Node>(Node(array_detail::LeafNode<T>(l), r.node())); \
+  } \
+  template <class L, class T> \
+  ArrayExpr<array_detail::NODE<CODE, L, array_detail::ViewNode<T>>> operator OP (const ArrayExpr<L> &l, const ArrayView<T> &r) { \
+    typedef array_detail::NODE<CODE, L, array_detail::ViewNode<T>> Node; \
+    return ArrayExpr<Node>(Node(l.node(), r.expr().node())); \
+  } \
+  template <class T, class R> \
+  ArrayExpr<array_detail::NODE<CODE, array_detail::ViewNode<T>, R>> operator OP (const ArrayView<T> &l, const ArrayExpr<R> &r) { \
+    typedef array_detail::NODE<CODE, array_detail::ViewNode<T>, R> Node; \
+    return ArrayExpr<Node>(Node(l.expr().node(), r.node())); \
+  } \
+  template <class T, class A> \
+  ArrayExpr<array_detail::NODE<CODE, array_detail::LeafNode<T>, array_detail::ViewNode<T>>> operator OP (const Array<T, A> &l, const ArrayView<T> &r) { \
+    typedef array_detail::NODE<CODE, array_detail::LeafNode<T>, array_detail::ViewNode<T>> Node; \
+    return ArrayExpr<Node>(Node(array_detail::LeafNode<T>(l), r.expr().node())); \
+  } \
+  template <class T, class A> \
+  ArrayExpr<array_detail::NODE<CODE, array_detail::ViewNode<T>, array_detail::LeafNode<T>>> operator OP (const ArrayView<T> &l, const Array<T, A> &r) { \
+    typedef array_detail::NODE<CODE, array_detail::ViewNode<T>, array_detail::LeafNode<T>> Node; \
+    return ArrayExpr<Node>(Node(l.expr().node(), array_detail::LeafNode<T>(r))); \
+  }
+#define ARRAY_EXPR_SCALAR_OPERATOR(OP, NODE, CODE) \
+  template <class L> \
+  ArrayExpr<array_detail::NODE<CODE, L>> operator OP (const ArrayExpr<L> &l, const typename L::value_type &s) { \
+    return ArrayExpr<array_detail::NODE<CODE, L>>(array_detail::NODE<CODE, L>(l.node(), s)); \
+  }
+
+ARRAY_EXPR_OPERATOR(+, BinaryNode, array_detail::OP_ADD)
+ARRAY_EXPR_OPERATOR(-, BinaryNode, array_detail::OP_SUB)
+ARRAY_EXPR_OPERATOR(*, BinaryNode, array_detail::OP_MUL)
+ARRAY_EXPR_OPERATOR(/, BinaryNode, array_detail::OP_DIV)
+ARRAY_EXPR_OPERATOR(%, BinaryNode, array_detail::OP_MOD)
+ARRAY_EXPR_OPERATOR(|, BinaryNode, array_detail::OP_OR)
+ARRAY_EXPR_OPERATOR(&, BinaryNode, array_detail::OP_AND)
+ARRAY_EXPR_OPERATOR(^, BinaryNode, array_detail::OP_XOR)
+ARRAY_EXPR_SCALAR_OPERATOR(+, ScalarNode, array_detail::OP_ADD)
+ARRAY_EXPR_SCALAR_OPERATOR(-, ScalarNode, array_detail::OP_SUB)
+ARRAY_EXPR_SCALAR_OPERATOR(*, ScalarNode, array_detail::OP_MUL)
+ARRAY_EXPR_SCALAR_OPERATOR(/, ScalarNode, array_detail::OP_DIV)
+ARRAY_EXPR_SCALAR_OPERATOR(%, ScalarNode, array_detail::OP_MOD)
+ARRAY_EXPR_SCALAR_OPERATOR(|, ScalarNode, array_detail::OP_OR)
+ARRAY_EXPR_SCALAR_OPERATOR(&, ScalarNode, array_detail::OP_AND)
+ARRAY_EXPR_SCALAR_OPERATOR(^, ScalarNode, array_detail::OP_XOR)
+ARRAY_EXPR_OPERATOR(==, CompareNode, array_detail::CMP_EQ)
+ARRAY_EXPR_OPERATOR(!=, CompareNode, array_detail::CMP_NE)
+ARRAY_EXPR_OPERATOR(<, CompareNode, array_detail::CMP_LT)
+ARRAY_EXPR_OPERATOR(<=, CompareNode, array_detail::CMP_LE)
+ARRAY_EXPR_OPERATOR(>, CompareNode, array_detail::CMP_GT)
+ARRAY_EXPR_OPERATOR(>=, CompareNode, array_detail::CMP_GE)
+ARRAY_EXPR_SCALAR_OPERATOR(==, CompareScalarNode, array_detail::CMP_EQ)
+ARRAY_EXPR_SCALAR_OPERATOR(!=, CompareScalarNode, array_detail::CMP_NE)
+ARRAY_EXPR_SCALAR_OPERATOR(<, CompareScalarNode, array_detail::CMP_LT)
+ARRAY_EXPR_SCALAR_OPERATOR(<=, CompareScalarNode, array_detail::CMP_LE)
+ARRAY_EXPR_SCALAR_OPERATOR(>, CompareScalarNode, array_detail::CMP_GT)
+ARRAY_EXPR_SCALAR_OPERATOR(>=, CompareScalarNode, array_detail::CMP_GE)
+#undef ARRAY_EXPR_OPERATOR
+#undef ARRAY_EXPR_SCALAR_OPERATOR
+
+template <class L>
+ArrayExpr<array_detail::NotNode<L>> operator! (const ArrayExpr<L> &l) {
+  return ArrayExpr<array_detail::NotNode<L>>(array_detail::NotNode<L>(l.node()));
+}
+
+/**
+ * @brief Non-owning read-only window over `Array` elements (pointer + length + stride), returned by `Array::view`.
+ * Creating a view neither allocates nor copies, so sliding windows over large buffers are free.
+ * Comparison and arithmetic operators return lazy `ArrayExpr`, same as for `Array`
+ * @warning View is invalidated when the viewed `Array` reallocates or is destroyed
+ */
+template <class T>
+class ArrayView {
+  private:
+    const T* P;
+    int S;
+    int step;
+    typedef array_detail::ViewNode<T> Node;
+    int idx (int index) const {
+      if (index < -this->S || index >= this->S) throw std::invalid_argument("Invalid Array Index!");
+      if (index >= 0) return index;
+      return index + this->S;
     }
+    const T& at (int i) const { return this->P[(long long) i * this->step]; }
+  public:
+    // Empty View -> Size = 0
+    ArrayView () : P(nullptr), S(0), step(1) {}
+    // View over `size` elements starting at `data`, `stride` elements apart
+    ArrayView (const T* data, int size, int stride = 1) : P(data), S(size), step(stride) {
+      if (size < 0) throw std::invalid_argument("Invalid Array Size provided");
+      if (stride < 1) throw std::invalid_argument("View step should be positive");
+    }
+    // Getting view size
+    int size () const noexcept { return this->S; }
+    // Same as `size()`
+    int length () const noexcept { return this->S; }
+    // Distance between viewed elements
+    int stride () const noexcept { return this->step; }
+    // Read-only subscript (Negative indexing supported)
+    T operator[] (int index) const { return this->at(idx(index)); }
 
     /**
-     * @brief Sort `Array` items in range `[from,to]` using optimized bubble sort
-     * 
-     * @param ascending Default `true`. `false` = descending order
+     * @brief Get view of this view using `from` and `to` index and optional `step`. Does not copy
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
+     * @param step Distance between viewed elements. Default 1
+     * @return ArrayView<T>
      */
-    void sort (bool ascending = true, int from = ARRAY_BEGIN, int to = ARRAY_END) {
-      if (this->S <= 1) return;
+    ArrayView<T> view (int from = ARRAY_BEGIN, int to = ARRAY_END, int step = 1) const {
+      if (step < 1) throw std::invalid_argument("View step should be positive");
+      if (this->S == 0) return ArrayView<T>();
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int len = (e - b + 1);
-      if (len <= 1) return;
-      for (int i = 0; i < len; i++) {
-        bool swapped = false;
-        for (int j = b; j < e - i; j++) {
-          if ((ascending && this->A[j] > this->A[j+1]) || (!ascending && this->A[j] < this->A[j+1])) {
-            T temp = this->A[j];
-            this->A[j] = this->A[j+1];
-            this->A[j+1] = temp;
-            swapped = true;
-          }
-        }
-        if (!swapped) break;
-      }
+      if (e < b) throw std::invalid_argument("Invalid From-To Range");
+      return ArrayView<T>(this->P + (long long) b * this->step, (e - b) / step + 1, step * this->step);
     }
+
     /**
-     * @brief Returns `Array` with sorted items in range `[from,to]` using optimized bubble sort. 
-     * Does not modify initial `Array`
-     * @param ascending Default `true`. `false` = descending order
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
-     * @return Array<T> 
+     * @brief Copy viewed elements into new `Array`
+     * @return Array<T>
      */
-    Array<T> toSorted (bool ascending = true, int from = ARRAY_BEGIN, int to = ARRAY_END) {
-      Array<T> X = *this;
-      if (this->S <= 1) return X;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int len = (e - b + 1);
-      if (len <= 1) return X;
-      for (int i = 0; i < len; i++) {
-        bool swapped = false;
-        for (int j = b; j < e - i; j++) {
-          if ((ascending && X[j] > X[j+1]) || (!ascending && X[j] < X[j+1])) {
-            T temp = X[j];
-            X[j] = X[j+1];
-            X[j+1] = temp;
-            swapped = true;
-          }
-        }
-        if (!swapped) break;
+    Array<T> toArray () const { return Array<T>(this->expr()); }
+
+    /**
+     * @brief Print viewed elements to stdout (see `Array::show`)
+     */
+    void show (
+      bool showType = false, bool showBrackets = true, bool endNewLine = true, bool elemNewLine = false,
+      char bracketOpenChar = '[', char bracketCloseChar = ']', const std::string &sep = ", "
+    ) const noexcept {
+      if (showType) std::cout<<"`ArrayView` ";
+      if (showBrackets) std::cout<<bracketOpenChar;
+      for (int i = 0; i < this->S; i++) {
+        std::cout<<this->at(i);
+        if (i < this->S - 1) std::cout<<sep;
+        if (elemNewLine) std::cout<<std::endl;
       }
-      return X;
+      if (showBrackets) std::cout<<bracketCloseChar;
+      if (endNewLine) std::cout<<std::endl;
     }
 
     /**
-     * @brief Check if `Array` items in range `[from,to]` contain `elem`
+     * @brief Check if viewed elements contain `elem`
      * @param elem Search element
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
      * @return true - Element found,
      * @return false - Element not found
      */
-    bool contains (const T& elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      if (this->S == 0) return false;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      for (int i = b; i <= e; i++) {
-        if (this->A[i] == elem) return true;
+    bool contains (const T& elem) const { return this->find(elem) != -1; }
+
+    /**
+     * @brief Count how many `elems` exist in the view
+     * @param elem Search element
+     * @return int - Successful search count
+     */
+    int count (const T& elem) const {
+      int cnt = 0;
+      for (int i = 0; i < this->S; i++) {
+        if (this->at(i) == elem) cnt++;
       }
-      return false;
+      return cnt;
     }
 
     /**
-     * @brief Check if `Array` items in range `[from,to]` contain a `pattern`
-     * @param pattern Search pattern
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
-     * @return true - Pattern found,
-     * @return false - Pattern not found
+     * @brief Find first view index of search `elem`. Returns `-1` if none found
+     * @param elem Search element
+     * @return int - Found index or `-1`
      */
-    bool contains (const Array<T>& pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      if (this->S == 0 || pattern.size() > this->S) return false;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int current_search = 0;
-      for (int i = b; i <= e; i++) {
-        if (this->A[i] == pattern[current_search]) current_search++;
-        else current_search = 0;
-        if (current_search == pattern.size()) return true;
+    int find (const T& elem) const {
+      for (int i = 0; i < this->S; i++) {
+        if (this->at(i) == elem) return i;
       }
-      return false;
+      return -1;
     }
-    bool contains (const std::vector < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return contains(fromVector(pattern), from, to); }
-    bool contains (const std::list < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return contains(fromList(pattern), from, to); }
-    bool contains (const std::set < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return contains(fromSet(pattern), from, to); }
-    bool contains (std::initializer_list<T> pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return contains(fromInitList(pattern), from, to); }
-    bool contains (T* pattern, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return contains(fromPointer(pattern, size), from, to); }
 
     /**
-     * @brief Count how many `elems` exist in an `Array` in range `[from,to]`
+     * @brief Find all view indices of search `elem`. Returns empty Array if none found
      * @param elem Search element
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
-     * @return int - Successful search count
+     * @return Array<int> - Array of indices
      */
-    int count (const T& elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      if (this->S == 0) return 0;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int cnt = 0;
-      for (int i = b; i <= e; i++) {
-        if (this->A[i] == elem) cnt++;
+    Array<int> findAll (const T& elem) const {
+      Array<int> X;
+      for (int i = 0; i < this->S; i++) {
+        if (this->at(i) == elem) X.append(i);
       }
-      return cnt;
+      return X;
     }
 
     /**
-     * @brief Count how many `patterns` exist in an `Array` in range `[from,to]`
-     * @param pattern Search pattern (sub-array)
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
-     * @return int - Successful search count
+     * @brief Get min value of viewed elements
+     * @return T - min value
      */
-    int count (const Array<T>& pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      if (this->S == 0 || pattern.size() > this->S) return 0;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int cnt = 0;
-      int current_search = 0;
-      for (int i = b; i <= e; i++) {
-        if (this->A[i] == pattern[current_search]) current_search++;
-        else current_search = 0;
-        if (current_search == pattern.size()) {
-          cnt++;
-          current_search = 0;
-        }
+    T min () const {
+      if (this->S == 0) return 0;
+      T minV = this->at(0);
+      for (int i = 1; i < this->S; i++) {
+        if (this->at(i) < minV) minV = this->at(i);
       }
-      return cnt;
+      return minV;
     }
-    int count (const std::vector < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return count(fromVector(pattern), from, to); }
-    int count (const std::list < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return count(fromList(pattern), from, to); }
-    int count (const std::set < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return count(fromSet(pattern), from, to); }
-    int count (std::initializer_list<T> pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return count(fromInitList(pattern), from, to); }
-    int count (T* pattern, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return count(fromPointer(pattern, size), from, to); }
 
     /**
-     * @brief Find first index of search `elem` in range `[from,to]`. Returns `-1` if none found
-     * @param elem Search element
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
-     * @return int - Found index or `-1`
+     * @brief Get max value of viewed elements
+     * @return T - max value
      */
-    int find (const T& elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      if (this->S == 0) return -1;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      for (int i = b; i <= e; i++) {
-        if (this->A[i] == elem) return i;
+    T max () const {
+      if (this->S == 0) return 0;
+      T maxV = this->at(0);
+      for (int i = 1; i < this->S; i++) {
+        if (this->at(i) > maxV) maxV = this->at(i);
       }
-      return -1;
+      return maxV;
     }
 
     /**
-     * @brief Find first index of search `pattern` in range `[from,to]`. Returns `-1` if none found
-     * @param pattern Search pattern
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
-     * @return int - Start index of found pattern or `-1`
+     * @brief Get Sum of viewed elements
+     * @return T - sum
      */
-    int find (const Array<T>& pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      if (this->S == 0 || pattern.size() > this->S) return -1;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int current_search = 0;
-      for (int i = b; i <= e; i++) {
-        if (this->A[i] == pattern[current_search]) current_search++;
-        else current_search = 0;
-        if (current_search == pattern.size()) return (i + 1 - pattern.size());
-      }
-      return -1;
+    T sum () const {
+      T s = 0;
+      for (int i = 0; i < this->S; i++) s += this->at(i);
+      return s;
     }
-    int find (const std::vector < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return find(fromVector(pattern), from, to); }
-    int find (const std::list < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return find(fromList(pattern), from, to); }
-    int find (const std::set < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return find(fromSet(pattern), from, to); }
-    int find (std::initializer_list<T> pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return find(fromInitList(pattern), from, to); }
-    int find (T* pattern, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return find(fromPointer(pattern, size), from, to); }
 
     /**
-     * @brief Find all indices of search `elem` in range `[from,to]`. Returns empty Array if none found
-     * @param elem Search element
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
-     * @return Array<int> - Array of indices
+     * @brief Get Product of viewed elements
+     * @return T - product
      */
-    Array<int> findAll (const T& elem, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      Array<int> X;
-      if (this->S == 0) return X;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      for (int i = b; i <= e; i++) {
-        if (this->A[i] == elem) X.append(i);
+    T product () const {
+      if (this->S == 0) return 0;
+      T p = 1;
+      for (int i = 0; i < this->S; i++) {
+        p *= this->at(i);
+        if (p == 0) return 0;
       }
-      return X;
+      return p;
     }
 
     /**
-     * @brief Find all indices of search `pattern` in range `[from,to]`. Returns empty Array if none found
-     * @param pattern Search pattern
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
-     * @return Array<int> - Starting indices of each pattern found
+     * @brief Get Arithmetic Mean of viewed elements
+     * @return double - arithmetic mean
      */
-    Array<int> findAll (const Array<T>& pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      Array<int> X;
-      if (this->S == 0 || pattern.size() > this->S) return X;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int current_search = 0;
-      for (int i = b; i <= e; i++) {
-        if (this->A[i] == pattern[current_search]) current_search++;
-        else current_search = 0;
-        if (current_search == pattern.size()) {
-          X.append(i + 1 - pattern.size());
-          current_search = 0;
-        }
+    double mean () const {
+      if (this->S == 0) return 0;
+      return (this->sum() * 1.0) / (this->S * 1.0);
+    }
+
+    /**
+     * @brief Get sample Variance of viewed elements (normalized by `size() - 1`)
+     * @return double - variance
+     */
+    double variance () const {
+      if (this->S <= 1) return 0;
+      array_detail::Moments mo;
+      for (int i = 0; i < this->S; i++) mo.add((double) this->at(i));
+      return mo.m2 / (this->S - 1.0);
+    }
+
+    /**
+     * @brief Get sample Standard Deviation of viewed elements
+     * @return double - standard deviation
+     */
+    double stdev () const { return sqrt(this->variance()); }
+
+    /**
+     * @brief Lazy expression reading viewed elements
+     * @return ArrayExpr
+     */
+    ArrayExpr<Node> expr () const { return ArrayExpr<Node>(Node(this->P, this->S, this->step)); }
+
+    /*
+     * Comparison operators (lazy, see `Array`)
+     */
+    ArrayExpr<array_detail::CompareScalarNode<array_detail::CMP_EQ, Node>> operator== (const T& val) const { return this->expr() == val; }
+    ArrayExpr<array_detail::CompareScalarNode<array_detail::CMP_NE, Node>> operator!= (const T& val) const { return this->expr() != val; }
+    ArrayExpr<array_detail::CompareScalarNode<array_detail::CMP_LT, Node>> operator< (const T& val) const { return this->expr() < val; }
+    ArrayExpr<array_detail::CompareScalarNode<array_detail::CMP_LE, Node>> operator<= (const T& val) const { return this->expr() <= val; }
+    ArrayExpr<array_detail::CompareScalarNode<array_detail::CMP_GT, Node>> operator> (const T& val) const { return this->expr() > val; }
+    ArrayExpr<array_detail::CompareScalarNode<array_detail::CMP_GE, Node>> operator>= (const T& val) const { return this->expr() >= val; }
+    ArrayExpr<array_detail::CompareNode<array_detail::CMP_EQ, Node, Node>> operator== (const ArrayView<T> &other) const { return this->expr() == other.expr(); }
+    ArrayExpr<array_detail::CompareNode<array_detail::CMP_NE, Node, Node>> operator!= (const ArrayView<T> &other) const { return this->expr() != other.expr(); }
+    ArrayExpr<array_detail::CompareNode<array_detail::CMP_LT, Node, Node>> operator< (const ArrayView<T> &other) const { return this->expr() < other.expr(); }
+    ArrayExpr<array_detail::CompareNode<array_detail::CMP_LE, Node, Node>> operator<= (const ArrayView<T> &other) const { return this->expr() <= other.expr(); }
+    ArrayExpr<array_detail::CompareNode<array_detail::CMP_GT, Node, Node>> operator> (const ArrayView<T> &other) const { return this->expr() > other.expr(); }
+    ArrayExpr<array_detail::CompareNode<array_detail::CMP_GE, Node, Node>> operator>= (const ArrayView<T> &other) const { return this->expr() >= other.expr(); }
+
+    /*
+     * Arithmetic operators (lazy, see `Array`)
+     */
+    ArrayExpr<array_detail::ScalarNode<array_detail::OP_ADD, Node>> operator+ (const T& number) const { return this->expr() + number; }
+    ArrayExpr<array_detail::ScalarNode<array_detail::OP_SUB, Node>> operator- (const T& number) const { return this->expr() - number; }
+    ArrayExpr<array_detail::ScalarNode<array_detail::OP_MUL, Node>> operator* (const T& number) const { return this->expr() * number; }
+    ArrayExpr<array_detail::ScalarNode<array_detail::OP_DIV, Node>> operator/ (const T& number) const { return this->expr() / number; }
+    ArrayExpr<array_detail::ScalarNode<array_detail::OP_MOD, Node>> operator% (const T& number) const { return this->expr() % number; }
+    ArrayExpr<array_detail::BinaryNode<array_detail::OP_ADD, Node, Node>> operator+ (const ArrayView<T> &other) const { return this->expr() + other.expr(); }
+    ArrayExpr<array_detail::BinaryNode<array_detail::OP_SUB, Node, Node>> operator- (const ArrayView<T> &other) const { return this->expr() - other.expr(); }
+    ArrayExpr<array_detail::BinaryNode<array_detail::OP_MUL, Node, Node>> operator* (const ArrayView<T> &other) const { return this->expr() * other.expr(); }
+    ArrayExpr<array_detail::BinaryNode<array_detail::OP_DIV, Node, Node>> operator/ (const ArrayView<T> &other) const { return this->expr() / other.expr(); }
+    ArrayExpr<array_detail::BinaryNode<array_detail::OP_MOD, Node, Node>> operator% (const ArrayView<T> &other) const { return this->expr() % other.expr(); }
+};
+
+/**
+ * @brief Streaming writer of the binary `Array` format (see `Array::save`). Elements can be written in any number of chunks,
+ * element count and checksum are stored in the header on `close()`
+ */
+template <class T>
+class ArrayWriter {
+  private:
+    FILE* file;
+    unsigned long long count;
+    array_detail::Checksum checksum;
+    std::string path;
+    template <class Alloc>
+    void writeArray (const Array<T, Alloc> &array, std::false_type) {
+      this->write(array.A, array.S);
+    }
+    // Packed `Array<bool>` is unpacked to one byte per element in chunks
+    template <class Alloc>
+    void writeArray (const Array<T, Alloc> &array, std::true_type) {
+      bool buffer[4096];
+      for (int i = 0; i < array.S; i += 4096) {
+        int n = array.S - i < 4096 ? array.S - i : 4096;
+        for (int j = 0; j < n; j++) buffer[j] = array.get(i + j);
+        this->write(buffer, n);
       }
-      return X;
     }
-    Array<int> findAll (const std::vector < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return findAll(fromVector(pattern), from, to); }
-    Array<int> findAll (const std::list < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return findAll(fromList(pattern), from, to); }
-    Array<int> findAll (const std::set < T > &pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return findAll(fromSet(pattern), from, to); }
-    Array<int> findAll (std::initializer_list<T> pattern, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return findAll(fromInitList(pattern), from, to); }
-    Array<int> findAll (T* pattern, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return findAll(fromPointer(pattern, size), from, to); }
+  public:
+    // Create (or overwrite) file at `path`
+    explicit ArrayWriter (const std::string &path) : file(nullptr), count(0), path(path) {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be saved");
+      this->file = fopen(path.c_str(), "wb");
+      if (this->file == NULL) throw std::invalid_argument("Failed to open file: " + path);
+      unsigned char header[array_detail::FORMAT_HEADER_SIZE] = {0};
+      if (fwrite(header, 1, sizeof(header), this->file) != sizeof(header)) {
+        fclose(this->file);
+        this->file = nullptr;
+        throw std::invalid_argument("Failed to write file: " + path);
+      }
+    }
+    ArrayWriter (const ArrayWriter&) = delete;
+    ArrayWriter& operator= (const ArrayWriter&) = delete;
+    // Closes the file if `close()` was not called (errors are ignored then)
+    ~ArrayWriter () {
+      if (this->file == nullptr) return;
+      try {
+        this->close();
+      } catch (...) {}
+    }
+    // Number of elements written so far
+    unsigned long long size () const noexcept { return this->count; }
+    // Append `n` elements from `data`
+    void write (const T* data, int n) {
+      if (this->file == nullptr) throw std::invalid_argument("ArrayWriter is closed");
+      if (n <= 0) return;
+      if (fwrite(data, sizeof(T), n, this->file) != (size_t) n) throw std::invalid_argument("Failed to write file: " + this->path);
+      this->checksum.update(data, n * sizeof(T));
+      this->count += n;
+    }
+    // Append all elements of `array`
+    template <class Alloc>
+    void write (const Array<T, Alloc> &array) {
+      this->writeArray(array, std::is_same<T, bool>());
+    }
+    // Append single element
+    void write (const T& elem) { this->write(&elem, 1); }
+    // Store header and close the file. Further writes throw
+    void close () {
+      if (this->file == nullptr) return;
+      unsigned char header[array_detail::FORMAT_HEADER_SIZE] = {0};
+      memcpy(header, "DNGA", 4);
+      array_detail::putLE(header + 4, array_detail::FORMAT_VERSION, 2);
+      header[6] = array_detail::TypeKind<T>::value;
+      header[7] = array_detail::bigEndianHost() ? 1 : 0;
+      array_detail::putLE(header + 8, sizeof(T), 4);
+      array_detail::putLE(header + 16, this->count, 8);
+      array_detail::putLE(header + 24, this->checksum.digest(), 8);
+      bool ok = fseek(this->file, 0, SEEK_SET) == 0 && fwrite(header, 1, sizeof(header), this->file) == sizeof(header);
+      ok = fclose(this->file) == 0 && ok;
+      this->file = nullptr;
+      if (!ok) throw std::invalid_argument("Failed to write file: " + this->path);
+    }
+};
 
+/**
+ * @brief Streaming reader of the binary `Array` format (see `Array::load`). Header is validated on open,
+ * payload checksum once the last element has been read
+ */
+template <class T>
+class ArrayReader {
+  private:
+    FILE* file;
+    unsigned long long count;
+    unsigned long long position;
+    uint64_t expected;
+    bool swap;
+    array_detail::Checksum checksum;
+    std::string path;
+    void fail (const std::string &message) {
+      if (this->file != nullptr) fclose(this->file);
+      this->file = nullptr;
+      throw std::invalid_argument(message + ": " + this->path);
+    }
+    template <class Alloc>
+    int readArray (Array<T, Alloc> &chunk, int n, std::false_type) {
+      return this->read(&chunk[0], n);
+    }
+    // Packed `Array<bool>` is filled from one byte per element chunks
+    template <class Alloc>
+    int readArray (Array<T, Alloc> &chunk, int n, std::true_type) {
+      bool buffer[4096];
+      for (int i = 0; i < n; i += 4096) {
+        int got = this->read(buffer, n - i < 4096 ? n - i : 4096);
+        for (int j = 0; j < got; j++) chunk.put(i + j, buffer[j]);
+      }
+      return n;
+    }
+  public:
+    // Open file at `path` and validate its header against `T`
+    explicit ArrayReader (const std::string &path) : file(nullptr), count(0), position(0), expected(0), swap(false), path(path) {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be loaded");
+      this->file = fopen(path.c_str(), "rb");
+      if (this->file == NULL) throw std::invalid_argument("Failed to open file: " + path);
+      unsigned char header[array_detail::FORMAT_HEADER_SIZE];
+      if (fread(header, 1, sizeof(header), this->file) != sizeof(header) || memcmp(header, "DNGA", 4) != 0) this->fail("Not an Array file");
+      if (array_detail::getLE(header + 4, 2) > array_detail::FORMAT_VERSION) this->fail("Unsupported Array file version");
+      if (header[6] != array_detail::TypeKind<T>::value || array_detail::getLE(header + 8, 4) != sizeof(T)) this->fail("Array file element type mismatch");
+      this->swap = (header[7] != 0) != array_detail::bigEndianHost();
+      if (this->swap && (header[6] == array_detail::KIND_RAW || header[7] > 1)) this->fail("Array file byte order not supported");
+      this->count = array_detail::getLE(header + 16, 8);
+      this->expected = array_detail::getLE(header + 24, 8);
+    }
+    ArrayReader (const ArrayReader&) = delete;
+    ArrayReader& operator= (const ArrayReader&) = delete;
+    ~ArrayReader () {
+      if (this->file != nullptr) fclose(this->file);
+    }
+    // Total number of elements in the file
+    unsigned long long size () const noexcept { return this->count; }
+    // Number of elements not read yet
+    unsigned long long remaining () const noexcept { return this->count - this->position; }
     /**
-     * @brief Get slice of the Array using `from` and `to` index
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
-     * @return `Array<T>` Array Slice
+     * @brief Read up to `n` next elements into `data`
+     * @return int - Number of elements read (`0` at the end of file)
      */
-    Array<T> slice(int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      Array<T> X;
-      if (this->S == 0) return X;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int s_size = e - b + 1;
-      X.sizeAlloc(s_size);
-      for (int i = 0; i < s_size; i++) X[i] = this->A[b + i];
-      return X;
+    int read (T* data, int n) {
+      if (this->file == nullptr) throw std::invalid_argument("ArrayReader is closed");
+      if (n <= 0 || this->remaining() == 0) return 0;
+      if ((unsigned long long) n > this->remaining()) n = (int) this->remaining();
+      if (fread(data, sizeof(T), n, this->file) != (size_t) n) this->fail("Array file is truncated");
+      this->checksum.update(data, n * sizeof(T));
+      if (this->swap && sizeof(T) > 1) array_detail::byteSwap(data, n, sizeof(T));
+      this->position += n;
+      if (this->remaining() == 0 && this->checksum.digest() != this->expected) this->fail("Array file checksum mismatch");
+      return n;
+    }
+    /**
+     * @brief Read up to `n` next elements into `chunk` (resized to the number of elements read)
+     * @return int - Number of elements read (`0` at the end of file)
+     */
+    template <class Alloc>
+    int read (Array<T, Alloc> &chunk, int n) {
+      if (n <= 0 || this->remaining() == 0) {
+        chunk.clear();
+        return 0;
+      }
+      if ((unsigned long long) n > this->remaining()) n = (int) this->remaining();
+      chunk.resize(n);
+      return this->readArray(chunk, n, std::is_same<T, bool>());
+    }
+    // Close the file
+    void close () {
+      if (this->file != nullptr) fclose(this->file);
+      this->file = nullptr;
+    }
+};
+
+/**
+ * @brief Compiled set of search patterns (Aho-Corasick automaton). Reports every occurrence of every pattern, overlapping ones
+ * included, in a single pass over the searched Array (see `Array::findAllMulti`).
+ * Integer patterns over a narrow range of values index symbols directly, and automata small enough
+ * (`states * symbols <= ARRAY_PATTERN_TABLE`) use a full transition table with one lookup per element.
+ * Patterns are compiled on the first search after `add`, call `compile()` before sharing the set between threads
+ */
+template <class T>
+class PatternSet {
+  private:
+    std::vector<std::vector<T>> patterns;
+    mutable bool compiled;
+    // Symbol ids: positions in sorted unique pattern elements, for integers in a narrow range also indexed by `x - low`
+    mutable std::vector<T> symbols;
+    mutable std::vector<int> direct;
+    mutable T low;
+    // Automaton, state `0` is the root
+    mutable std::vector<int> fail;      // Longest proper suffix state
+    mutable std::vector<int> dict;      // Nearest state on the failure chain where a pattern ends (`0` = none)
+    mutable std::vector<int> first;     // First pattern ending in the state (`-1` = none)
+    mutable std::vector<int> same;      // Next pattern equal to pattern `i` (`-1` = none)
+    mutable std::vector<int> delta;     // Full transition table `state * symbols + id` (empty when too large)
+    mutable std::vector<int> edgeStart; // Trie edges of state `s` are `[edgeStart[s], edgeStart[s + 1])`, sorted by symbol
+    mutable std::vector<int> edgeSymbol;
+    mutable std::vector<int> edgeTarget;
+    int search (const T& x) const {
+      int lo = 0, hi = (int) this->symbols.size() - 1;
+      while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (this->symbols[mid] == x) return mid;
+        if (this->symbols[mid] < x) lo = mid + 1;
+        else hi = mid - 1;
+      }
+      return -1;
+    }
+    int symbolId (const T& x, std::true_type) const {
+      if (this->direct.empty()) return this->search(x);
+      uint64_t o = (uint64_t) x - (uint64_t) this->low;
+      return o < this->direct.size() ? this->direct[o] : -1;
+    }
+    int symbolId (const T& x, std::false_type) const { return this->search(x); }
+    void buildDirect (std::true_type) const {
+      this->direct.clear();
+      if (this->symbols.empty()) return;
+      uint64_t span = (uint64_t) this->symbols.back() - (uint64_t) this->symbols.front();
+      if (span >= ARRAY_PATTERN_DIRECT) return;
+      this->low = this->symbols.front();
+      this->direct.assign(span + 1, -1);
+      for (int i = 0; i < (int) this->symbols.size(); i++) this->direct[(uint64_t) this->symbols[i] - (uint64_t) this->low] = i;
+    }
+    void buildDirect (std::false_type) const { this->direct.clear(); }
+    // Trie edge of state `s` for symbol `c` (`-1` = none)
+    int edge (int s, int c) const {
+      int lo = this->edgeStart[s], hi = this->edgeStart[s + 1] - 1;
+      while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (this->edgeSymbol[mid] == c) return this->edgeTarget[mid];
+        if (this->edgeSymbol[mid] < c) lo = mid + 1;
+        else hi = mid - 1;
+      }
+      return -1;
     }
-
-    /**
-     * @brief Return `Array` with unique elements
-     * @return Array<T> - Unique Array
-     */
-    Array<T> unique () const {
-      Array<T> X;
-      for (int i = 0; i < this->S; i++) {
-        if (!X.contains(this->A[i])) X.append(this->A[i]);
+    // Transition from state `s` by symbol `c` following failure links
+    int step (int s, int c) const {
+      if (!this->delta.empty()) return this->delta[(size_t) s * this->symbols.size() + c];
+      while (true) {
+        int t = this->edge(s, c);
+        if (t >= 0) return t;
+        if (s == 0) return 0;
+        s = this->fail[s];
       }
-      return X;
+    }
+  public:
+    // Empty set
+    PatternSet () : compiled(false), low() {}
+    // Set of all `patterns` (pattern ids are their positions)
+    explicit PatternSet (std::initializer_list<std::initializer_list<T>> patterns) : compiled(false), low() {
+      for (auto it = patterns.begin(); it != patterns.end(); it++) this->add(*it);
     }
 
     /**
-     * Array functors
-     */
-
-    /**
-     * @brief Execute `func` for each element of the `Array`
-     * @param func Function to execute. Element is passed as an argument. Should return `void`.
+     * @brief Add search pattern
+     * @param pattern Non-empty pattern
+     * @return int - Pattern id reported with its matches
      */
-    void forEach (void (*func)(T elem)) const {
-      for (int i = 0; i < this->S; i++) func(this->A[i]);
+    template <class Alloc>
+    int add (const Array<T, Alloc> &pattern) {
+      std::vector<T> p(pattern.size());
+      for (int i = 0; i < pattern.size(); i++) p[i] = pattern[i];
+      return this->add(p);
     }
-    /**
-     * @brief Execute `func` for each element of the `Array`
-     * @param func Function to execute. Arguments: element, index of an element. Should return `void`.
-     */
-    void forEach (void (*func)(T elem, int index)) const {
-      for (int i = 0; i < this->S; i++) func(this->A[i], i);
+    int add (const std::vector<T> &pattern) {
+      if (pattern.empty()) throw std::invalid_argument("Empty search pattern");
+      this->patterns.push_back(pattern);
+      this->compiled = false;
+      return (int) this->patterns.size() - 1;
     }
-    /**
-     * @brief Execute `func` for each element of the `Array`
-     * @param func Function to execute. Arguments: element, index of an element, array. Should return `void`.
-     */
-    void forEach (void (*func)(T elem, int index, const Array<T> &array)) const {
-      for (int i = 0; i < this->S; i++) func(this->A[i], i, *this);
+    int add (std::initializer_list<T> pattern) { return this->add(std::vector<T>(pattern)); }
+    // Number of patterns
+    int size () const noexcept { return (int) this->patterns.size(); }
+    // Number of automaton states (compiles the set)
+    int states () const {
+      this->compile();
+      return (int) this->fail.size();
     }
 
     /**
-     * @brief Filters `Array` elements using `func` provided
-     * @param func Filtering function. Element is passed as an argument. Should return `bool`.
-     * @return Array<T> Filtered `Array`
+     * @brief Build the automaton. Runs automatically on the first search after `add`
      */
-    Array<T> filter (bool (*func)(T elem)) const {
-      Array<T> X;
-      for (int i = 0; i < this->S; i++) {
-        if (func(this->A[i])) X.append(this->A[i]);
+    void compile () const {
+      if (this->compiled) return;
+      std::integral_constant<bool, std::is_integral<T>::value> integral;
+      // Symbols
+      this->symbols.clear();
+      for (size_t p = 0; p < this->patterns.size(); p++) this->symbols.insert(this->symbols.end(), this->patterns[p].begin(), this->patterns[p].end());
+      if (!this->symbols.empty()) array_detail::introSort(&this->symbols[0], (int) this->symbols.size(), array_detail::Ascending<T>());
+      size_t unique = 0;
+      for (size_t i = 0; i < this->symbols.size(); i++) {
+        if (unique == 0 || !(this->symbols[unique - 1] == this->symbols[i])) this->symbols[unique++] = this->symbols[i];
       }
-      return X;
-    }
-    /**
-     * @brief Filters `Array` elements using `func` provided
-     * @param func Filtering function. Arguments: element, index of an element. Should return `bool`.
-     * @return Array<T> Filtered `Array`
-     */
-    Array<T> filter (bool (*func)(T elem, int index)) const {
-      Array<T> X;
-      for (int i = 0; i < this->S; i++) {
-        if (func(this->A[i], i)) X.append(this->A[i]);
+      this->symbols.resize(unique);
+      this->buildDirect(integral);
+      int K = (int) unique;
+      // Trie with child lists. Patterns are inserted last to first so equal patterns are chained in ascending id order
+      std::vector<int> child(1, -1), sibling(1, -1), symbol(1, -1);
+      this->first.assign(1, -1);
+      this->same.assign(this->patterns.size(), -1);
+      for (int p = (int) this->patterns.size() - 1; p >= 0; p--) {
+        int s = 0;
+        for (size_t j = 0; j < this->patterns[p].size(); j++) {
+          int c = this->symbolId(this->patterns[p][j], integral);
+          int t = child[s];
+          while (t >= 0 && symbol[t] != c) t = sibling[t];
+          if (t < 0) {
+            t = (int) child.size();
+            child.push_back(-1);
+            sibling.push_back(child[s]);
+            symbol.push_back(c);
+            this->first.push_back(-1);
+            child[s] = t;
+          }
+          s = t;
+        }
+        this->same[p] = this->first[s];
+        this->first[s] = p;
       }
-      return X;
+      int n = (int) child.size();
+      // Sorted edge lists
+      this->edgeStart.assign(n + 1, 0);
+      this->edgeSymbol.assign(n - 1, 0);
+      this->edgeTarget.assign(n - 1, 0);
+      for (int s = 0, k = 0; s < n; s++) {
+        this->edgeStart[s] = k;
+        for (int t = child[s]; t >= 0; t = sibling[t]) {
+          int j = k++;
+          while (j > this->edgeStart[s] && this->edgeSymbol[j - 1] > symbol[t]) {
+            this->edgeSymbol[j] = this->edgeSymbol[j - 1];
+            this->edgeTarget[j] = this->edgeTarget[j - 1];
+            j--;
+          }
+          this->edgeSymbol[j] = symbol[t];
+          this->edgeTarget[j] = t;
+        }
+        this->edgeStart[s + 1] = k;
+      }
+      // Failure and output links in breadth-first order
+      bool dense = (long long) n * K <= ARRAY_PATTERN_TABLE;
+      this->fail.assign(n, 0);
+      this->dict.assign(n, 0);
+      this->delta.clear();
+      if (dense) this->delta.assign((size_t) n * K, 0);
+      std::vector<int> queue(1, 0);
+      for (size_t q = 0; q < queue.size(); q++) {
+        int u = queue[q];
+        for (int k = this->edgeStart[u]; k < this->edgeStart[u + 1]; k++) {
+          int c = this->edgeSymbol[k], t = this->edgeTarget[k];
+          if (u != 0) {
+            int f = this->fail[u];
+            while (f != 0 && this->edge(f, c) < 0) f = this->fail[f];
+            int g = this->edge(f, c);
+            this->fail[t] = g >= 0 ? g : 0;
+          }
+          this->dict[t] = this->first[this->fail[t]] >= 0 ? this->fail[t] : this->dict[this->fail[t]];
+          queue.push_back(t);
+        }
+        if (dense) {
+          int* row = &this->delta[(size_t) u * K];
+          const int* fallback = &this->delta[(size_t) this->fail[u] * K];
+          for (int c = 0; c < K; c++) row[c] = u == 0 ? 0 : fallback[c];
+          for (int k = this->edgeStart[u]; k < this->edgeStart[u + 1]; k++) row[this->edgeSymbol[k]] = this->edgeTarget[k];
+        }
+      }
+      this->compiled = true;
     }
+
     /**
-     * @brief Filters `Array` elements using `func` provided
-     * @param func Filtering function. Arguments: element, index of an element, array. Should return `bool`.
-     * @return Array<T> Filtered `Array`
+     * @brief Report every match inside `data[0..n)` as `onMatch(patternId, offset + startIndex)`, in order of match end
+     * (longer patterns first for matches ending at the same element)
      */
-    Array<T> filter (bool (*func)(T elem, int index, const Array<T> &array)) const {
-      Array<T> X;
-      for (int i = 0; i < this->S; i++) {
-        if (func(this->A[i], i, *this)) X.append(this->A[i]);
+    template <class F>
+    void scan (const T* data, int n, int offset, F onMatch) const {
+      this->compile();
+      if (this->patterns.empty()) return;
+      std::integral_constant<bool, std::is_integral<T>::value> integral;
+      int s = 0;
+      for (int i = 0; i < n; i++) {
+        int c = this->symbolId(data[i], integral);
+        if (c < 0) {
+          s = 0;
+          continue;
+        }
+        s = this->step(s, c);
+        for (int o = this->first[s] >= 0 ? s : this->dict[s]; o > 0; o = this->dict[o]) {
+          for (int p = this->first[o]; p >= 0; p = this->same[p]) onMatch(p, offset + i - (int) this->patterns[p].size() + 1);
+        }
       }
-      return X;
     }
 
     /**
-     * @brief Map `Array` elements using `func` provided
-     * @tparam U Destination `Array` type
-     * @param func Mapping function. Element is passed as an argument. Should return `U`.
-     * @return Array<U> Mapped `Array`
+     * @brief Find every match of every pattern in `array` items in range `[from,to]` (same as `array.findAllMulti(*this, from, to)`)
+     * @param array Searched Array
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return Array<PatternMatch> - `(pattern, index)` pairs in order of match end
      */
-    template <typename U>
-    Array<U> map (U (*func)(T elem)) const {
-      Array<U> X;
-      for (int i = 0; i < this->S; i++) X.append(func(this->A[i]));
-      return X;
+    template <class Alloc>
+    Array<PatternMatch, Alloc> findAll (const Array<T, Alloc> &array, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      return array.findAllMulti(*this, from, to);
+    }
+};
+
+/**
+ * @brief Streaming statistics of values seen one at a time, in O(1) memory. Provides the numeric API of `Array`
+ * (`mean`, `variance`, ...) without storing the values. Accumulators filled on separate threads are combined with `merge`
+ */
+template <class T>
+class RunningStats {
+  private:
+    ArrayStats<T> st;  // `logSum` excludes the pending product below
+    // Product of positive values not yet added to `logSum`, kept as `prod * 2^exps`. `prod` is renormalized by `frexp`
+    // whenever it leaves `[2^-500, 2^500]`
+    double prod;
+    long long exps;
+    ArrayStats<T> folded () const {
+      ArrayStats<T> s = this->st;
+      s.logSum += log(this->prod) + this->exps * 0.69314718055994530942;
+      return s;
     }
+  public:
+    RunningStats () : prod(1.0), exps(0) {}
+
     /**
-     * @brief Map `Array` elements using `func` provided
-     * @tparam U Destination `Array` type
-     * @param func Mapping function. Arguments: element, index of an element. Should return `U`.
-     * @return Array<U> Mapped `Array`
+     * @brief Add one value (Welford update of mean and variance)
+     * @param value Value
      */
-    template <typename U>
-    Array<U> map (U (*func)(T elem, int index)) const {
-      Array<U> X;
-      for (int i = 0; i < this->S; i++) X.append(func(this->A[i], i));
-      return X;
+    void push (const T& value) {
+      double x = (double) value;
+      if (this->st.count == 0) {
+        this->st.min = value;
+        this->st.max = value;
+      } else {
+        if (value < this->st.min) this->st.min = value;
+        if (value > this->st.max) this->st.max = value;
+      }
+      this->st.count++;
+      // Reciprocal of the count does not depend on the previous mean, so the update chain has no division
+      double inv = 1.0 / this->st.count;
+      double delta = x - this->st.mean;
+      this->st.mean += delta * inv;
+      this->st.m2 += delta * (x - this->st.mean);
+      this->st.sum += x;
+      this->st.reciprocalSum += 1.0 / x;
+      if (x > 3.054936363499605e-151 && x < 3.273390607896142e+150) this->prod *= x;
+      else if (x > 0) {
+        int e;
+        this->prod *= frexp(x, &e);
+        this->exps += e;
+      }
+      else this->st.logSum += x < 0 ? NAN : -INFINITY;
+      if (!(this->prod > 3.054936363499605e-151 && this->prod < 3.273390607896142e+150)) {
+        int e;
+        this->prod = frexp(this->prod, &e);
+        this->exps += e;
+      }
     }
     /**
-     * @brief Map `Array` elements using `func` provided
-     * @tparam U Destination `Array` type
-     * @param func Mapping function. Arguments: element, index of an element, array. Should return `U`.
-     * @return Array<U> Mapped `Array`
+     * @brief Add all items of `array` (summarized with `Array::describe`, then merged)
+     * @param array Values
      */
-    template <typename U>
-    Array<U> map (U (*func)(T elem, int index, const Array<T> &array)) const {
-      Array<U> X;
-      for (int i = 0; i < this->S; i++) X.append(func(this->A[i], i, *this));
-      return X;
+    template <class Alloc>
+    void push (const Array<T, Alloc> &array) { this->st.merge(array.describe()); }
+    // Combine with accumulator of other values
+    void merge (const RunningStats &other) { this->st.merge(other.folded()); }
+    // Forget all values
+    void clear () {
+      this->st = ArrayStats<T>();
+      this->prod = 1.0;
+      this->exps = 0;
     }
 
-    /*
-     * Converters
-     */
+    // Number of values
+    long long count () const noexcept { return this->st.count; }
+    // Min value, `0` if empty
+    T min () const { return this->st.count > 0 ? this->st.min : 0; }
+    // Max value, `0` if empty
+    T max () const { return this->st.count > 0 ? this->st.max : 0; }
+    double sum () const noexcept { return this->st.sum; }
+    // Arithmetic mean, `0` if empty
+    double mean () const noexcept { return this->st.mean; }
+    double meanG () const { return this->folded().meanG(); }
+    double meanH () const { return this->st.meanH(); }
+    // Sample variance, same as `Array::variance()` of all values
+    double variance () const { return this->st.variance(); }
+    double stdev () const { return this->st.stdev(); }
+    // All statistics at once
+    ArrayStats<T> stats () const { return this->folded(); }
+};
 
-    /**
-     * @brief Return `Array` in different type `U`
-     * @tparam U Destination `Array` type
-     * @return Array<U> Re-typed `Array`
-     */
-    template <typename U>
-    Array<U> astype () {
-      Array<U> X;
-      for (int i = 0; i < this->S; i++) X.append((U) (this->A[i]));
-      return X;
+#ifndef ARRAY_RANGE_BLOCK
+#define ARRAY_RANGE_BLOCK 32  // Items per block of `RangeQueryIndex` (at most 256, offsets inside a block are stored in a byte)
+#endif
+
+namespace array_detail {
+  // Prefix sums of `T` used by range indexes: wrapping 64-bit integers for integral types (difference of two prefixes
+  // is exact even if a prefix wraps around), `long double` for floating point types
+  template <class T, bool Floating = std::is_floating_point<T>::value>
+  struct RangeSum {
+    typedef unsigned long long type;
+    static T value (type s) { return (T) s; }
+    static double mean (type s, int n) { return (std::is_signed<T>::value ? (double) (long long) s : (double) s) / n; }
+    // Set `prefix[i]` to the sum of the first `i` items of `a`, `error` is not needed
+    static void prefixes (const T* a, int n, std::vector<type> &prefix, std::vector<type> &error) {
+      prefix.resize(n + 1);
+      prefix[0] = 0;
+      for (int i = 0; i < n; i++) prefix[i + 1] = prefix[i] + (type) a[i];
+      error.clear();
     }
-    
-    /**
-     * @brief Convert `Array` to `std::vector`
-     * @return std::vector<T> 
-     */
-    std::vector<T> toVector () {
-      std::vector<T> vec;
-      for (int i = 0; i < this->S; i++) vec.push_back(this->A[i]);
-      return vec;
+    // Sum of items `[b,e]`
+    static type range (const std::vector<type> &prefix, const std::vector<type> &, int b, int e) { return prefix[e + 1] - prefix[b]; }
+  };
+  template <class T>
+  struct RangeSum<T, true> {
+    typedef long double type;
+    static T value (type s) { return (T) s; }
+    static double mean (type s, int n) { return (double) (s / n); }
+    // Set `prefix[i]` to the sum of the first `i` items of `a` and `error[i]` to its rounding error (TwoSum), so a
+    // large item does not cancel the small ones after it when two prefixes are subtracted
+    static void prefixes (const T* a, int n, std::vector<type> &prefix, std::vector<type> &error) {
+      prefix.resize(n + 1);
+      error.resize(n + 1);
+      prefix[0] = error[0] = 0;
+      for (int i = 0; i < n; i++) {
+        type x = a[i], s = prefix[i] + x, t = s - prefix[i];
+        error[i + 1] = error[i] + ((prefix[i] - (s - t)) + (x - t));
+        prefix[i + 1] = s;
+      }
+    }
+    static type range (const std::vector<type> &prefix, const std::vector<type> &error, int b, int e) {
+      return (prefix[e + 1] - prefix[b]) + (error[e + 1] - error[b]);
     }
+  };
+  // `floor(log2(x))` for `x > 0`
+  inline int floorLog2 (unsigned x) {
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(x);
+#else
+    int k = 0;
+    while (x >>= 1) k++;
+    return k;
+#endif
+  }
+}
 
+/**
+ * @brief Precomputed index for repeated range queries on an Array that does not change.
+ * `min`, `max`, `argmin`, `argmax` are answered in O(1) by a sparse table over blocks of `ARRAY_RANGE_BLOCK` items,
+ * combined with the min / max of the partial blocks at both ends. `sum` and `mean` are a difference of two prefix sums
+ * (compensated for floating point types, so large items outside the range do not cancel the items inside).
+ * Building takes O(n) time and about `n * (sizeof(T) + 12)` bytes. The index keeps a copy of the items,
+ * so it does not follow later changes of the Array (see `RangeQueryTree` for that)
+ */
+template <class T>
+class RangeQueryIndex {
+  private:
+    typedef array_detail::RangeSum<T> Sum;
+    std::vector<T> values;
+    std::vector<typename Sum::type> prefix;  // `prefix[i]` = sum of the first `i` items
+    std::vector<typename Sum::type> error;   // Rounding error of `prefix[i]` (floating point types only)
+    // Offset (from the block start) of the first min / max of items from the block start to `i` (`Head`)
+    // and from `i` to the block end (`Tail`)
+    std::vector<uint8_t> minHead;
+    std::vector<uint8_t> minTail;
+    std::vector<uint8_t> maxHead;
+    std::vector<uint8_t> maxTail;
+    // `minTable[k][j]` = index of the first min of blocks `j` .. `j + 2^k - 1`
+    std::vector<std::vector<int>> minTable;
+    std::vector<std::vector<int>> maxTable;
+    int S;
+    int idx (int index) const {
+      if (index < -this->S || index >= this->S) throw std::invalid_argument("Invalid Array Index!");
+      if (index >= 0) return index;
+      return index + this->S;
+    }
+    void checkRange (int From, int To) const {
+      int width = idx(To) - idx(From) + 1;
+      if (width < 1 || width > this->S) throw std::invalid_argument("Invalid From-To Range");
+      return;
+    }
+    // Better of items `i` and `j` (`i < j`), `i` on ties
+    template <bool Max>
+    int pick (int i, int j) const {
+      return (Max ? this->values[i] < this->values[j] : this->values[j] < this->values[i]) ? j : i;
+    }
+    template <bool Max>
+    void buildSide (std::vector<uint8_t> &head, std::vector<uint8_t> &tail, std::vector<std::vector<int>> &table) {
+      const int B = ARRAY_RANGE_BLOCK;
+      int blocks = (this->S + B - 1) / B;
+      head.resize(this->S);
+      tail.resize(this->S);
+      table.assign(blocks > 0 ? array_detail::floorLog2(blocks) + 1 : 0, std::vector<int>());
+      if (blocks == 0) return;
+      table[0].resize(blocks);
+      for (int j = 0; j < blocks; j++) {
+        int b = j * B, e = b + B - 1 < this->S - 1 ? b + B - 1 : this->S - 1;
+        int m = b;
+        for (int i = b; i <= e; i++) {
+          m = this->pick<Max>(m, i);
+          head[i] = (uint8_t) (m - b);
+        }
+        table[0][j] = m;
+        m = e;
+        for (int i = e; i >= b; i--) {
+          m = this->pick<Max>(i, m);
+          tail[i] = (uint8_t) (m - b);
+        }
+      }
+      for (int k = 1; k < (int) table.size(); k++) {
+        int half = 1 << (k - 1);
+        table[k].resize(blocks - 2 * half + 1);
+        for (int j = 0; j + 2 * half <= blocks; j++) table[k][j] = this->pick<Max>(table[k - 1][j], table[k - 1][j + half]);
+      }
+    }
+    // Index of the first min / max of valid range `[b,e]`
+    template <bool Max>
+    int best (int b, int e) const {
+      const int B = ARRAY_RANGE_BLOCK;
+      int bb = b / B, be = e / B;
+      if (bb == be) {
+        int m = b;
+        for (int i = b + 1; i <= e; i++) m = this->pick<Max>(m, i);
+        return m;
+      }
+      const std::vector<std::vector<int>> &table = Max ? this->maxTable : this->minTable;
+      int m = bb * B + (Max ? this->maxTail : this->minTail)[b];
+      if (be - bb > 1) {
+        int k = array_detail::floorLog2(be - bb - 1);
+        m = this->pick<Max>(m, this->pick<Max>(table[k][bb + 1], table[k][be - (1 << k)]));
+      }
+      return this->pick<Max>(m, be * B + (Max ? this->maxHead : this->minHead)[e]);
+    }
+  public:
+    RangeQueryIndex () : S(0) {}
     /**
-     * @brief Convert `Array` to `std::list`
-     * @return std::list<T> 
+     * @brief Build index of `array` items
+     * @param array Indexed Array
      */
-    std::list<T> toList () {
-      std::list<T> lst;
-      for (int i = 0; i < this->S; i++) lst.push_back(this->A[i]);
-      return lst;
-    }
+    template <class Alloc>
+    explicit RangeQueryIndex (const Array<T, Alloc> &array) : S(0) { this->build(array); }
 
     /**
-     * @brief Convert `Array` to `std::set`
-     * @return std::set<T> 
+     * @brief Rebuild index from `array` items (e.g. after the Array changed)
+     * @param array Indexed Array
      */
-    std::set<T> toSet () {
-      std::set<T> st;
-      for (int i = 0; i < this->S; i++) st.insert(this->A[i]);
-      return st;
+    template <class Alloc>
+    void build (const Array<T, Alloc> &array) {
+      this->S = array.S;
+      this->values.assign(array.A, array.A + array.S);
+      Sum::prefixes(array.A, array.S, this->prefix, this->error);
+      this->buildSide<false>(this->minHead, this->minTail, this->minTable);
+      this->buildSide<true>(this->maxHead, this->maxTail, this->maxTable);
     }
 
-    /**
-     * Methods for number arrays only
-     */
+    // Number of indexed items
+    int size () const noexcept { return this->S; }
 
     /**
-     * @brief Get min value of `Array` items in range `[from,to]`
+     * @brief Get min value of items in range `[from,to]` (same as `Array::min`)
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
      * @return T - min value
      */
     T min (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
       if (this->S == 0) return 0;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len == 0) return 0;
-      T minV = this->A[b];
-      for (int i = b + 1; i <= e; i++) {
-        if (this->A[i] < minV) minV = this->A[i];
-      }
-      return minV;
+      return this->values[this->argmin(from, to)];
     }
-
     /**
-     * @brief Get max value of `Array` items in range `[from,to]`
+     * @brief Get max value of items in range `[from,to]` (same as `Array::max`)
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
      * @return T - max value
      */
     T max (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
       if (this->S == 0) return 0;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len == 0) return 0;
-      T maxV = this->A[b];
-      for (int i = b + 1; i <= e; i++) {
-        if (this->A[i] > maxV) maxV = this->A[i];
-      }
-      return maxV;
+      return this->values[this->argmax(from, to)];
     }
-
     /**
-     * @brief Get indices of min values of `Array` items in range `[from,to]`
+     * @brief Get index of the first min value of items in range `[from,to]` (first item of `Array::argmin`)
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
-     * @return Array<int> - min values' indices
+     * @return int - min value index, `-1` if the index is empty
      */
-    Array<int> argmin (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      Array<int> X;
-      if (this->S == 0) return X;
+    int argmin (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return -1;
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len == 0) return X;
-      T minV = this->A[b];
-      X.append(b);
-      for (int i = b + 1; i <= e; i++) {
-        if (this->A[i] < minV) {
-          minV = this->A[i];
-          X.clear();
-          X.append(i);
-        } else if (this->A[i] == minV) X.append(i);
-      }
-      return X;
+      return this->best<false>(b, e);
     }
-
     /**
-     * @brief Get indices of max values of `Array` items in range `[from,to]`
+     * @brief Get index of the first max value of items in range `[from,to]` (first item of `Array::argmax`)
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
-     * @return Array<int> - max values' indices
+     * @return int - max value index, `-1` if the index is empty
      */
-    Array<int> argmax (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      Array<int> X;
-      if (this->S == 0) return X;
+    int argmax (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return -1;
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len == 0) return X;
-      T maxV = this->A[b];
-      X.append(b);
-      for (int i = b + 1; i <= e; i++) {
-        if (this->A[i] > maxV) {
-          maxV = this->A[i];
-          X.clear();
-          X.append(i);
-        } else if (this->A[i] == maxV) X.append(i);
-      }
-      return X;
+      return this->best<true>(b, e);
     }
-
     /**
-     * @brief Get Sum of the `Array` items in range `[from,to]`
+     * @brief Get Sum of items in range `[from,to]` (same as `Array::sum`)
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
      * @return T - sum
@@ -932,537 +7533,444 @@ class Array {
       if (this->S == 0) return 0;
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len == 0) return 0;
-      T s = 0;
-      for (int i = b; i <= e; i++) s += this->A[i];
-      return s;
+      return Sum::value(Sum::range(this->prefix, this->error, b, e));
+    }
+    /**
+     * @brief Get Arithmetic Mean of items in range `[from,to]`. Integral sums do not overflow `T` here
+     * @param from Default 0 (Inclusive)
+     * @param to Default Last Index (Inclusive)
+     * @return double - arithmetic mean
+     */
+    double mean (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      return Sum::mean(Sum::range(this->prefix, this->error, b, e), e - b + 1);
+    }
+};
+
+/**
+ * @brief Range query index that supports point updates: segment tree with sum, first min and first max of every node.
+ * Queries (same API as `RangeQueryIndex`) and updates take O(log n). Building takes O(n)
+ */
+template <class T>
+class RangeQueryTree {
+  private:
+    typedef array_detail::RangeSum<T> Sum;
+    struct Node {
+      typename Sum::type sum;
+      int lo;  // Index of the first min, `-1` for an empty node
+      int hi;  // Index of the first max
+    };
+    std::vector<T> values;
+    // Bottom-up tree: item `i` is leaf `tree[S + i]`, `tree[i]` combines `tree[2i]` and `tree[2i+1]`
+    std::vector<Node> tree;
+    int S;
+    int idx (int index) const {
+      if (index < -this->S || index >= this->S) throw std::invalid_argument("Invalid Array Index!");
+      if (index >= 0) return index;
+      return index + this->S;
+    }
+    void checkRange (int From, int To) const {
+      int width = idx(To) - idx(From) + 1;
+      if (width < 1 || width > this->S) throw std::invalid_argument("Invalid From-To Range");
+      return;
+    }
+    // `a` covers items left of `b`, ties keep the item of `a`
+    Node combine (const Node &a, const Node &b) const {
+      if (a.lo < 0) return b;
+      if (b.lo < 0) return a;
+      Node r;
+      r.sum = a.sum + b.sum;
+      r.lo = this->values[b.lo] < this->values[a.lo] ? b.lo : a.lo;
+      r.hi = this->values[a.hi] < this->values[b.hi] ? b.hi : a.hi;
+      return r;
+    }
+    // Combined node of valid range `[b,e]`
+    Node query (int b, int e) const {
+      Node left = { 0, -1, -1 }, right = { 0, -1, -1 };
+      for (int l = b + this->S, r = e + this->S + 1; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) left = this->combine(left, this->tree[l++]);
+        if (r & 1) right = this->combine(this->tree[--r], right);
+      }
+      return this->combine(left, right);
+    }
+  public:
+    RangeQueryTree () : S(0) {}
+    /**
+     * @brief Build tree of `array` items
+     * @param array Indexed Array
+     */
+    template <class Alloc>
+    explicit RangeQueryTree (const Array<T, Alloc> &array) : S(0) { this->build(array); }
+
+    /**
+     * @brief Rebuild tree from `array` items
+     * @param array Indexed Array
+     */
+    template <class Alloc>
+    void build (const Array<T, Alloc> &array) {
+      this->S = array.S;
+      this->values.assign(array.A, array.A + array.S);
+      this->tree.resize(2 * this->S);
+      for (int i = 0; i < this->S; i++) {
+        Node leaf = { (typename Sum::type) this->values[i], i, i };
+        this->tree[this->S + i] = leaf;
+      }
+      for (int i = this->S - 1; i > 0; i--) this->tree[i] = this->combine(this->tree[2 * i], this->tree[2 * i + 1]);
     }
 
+    // Number of indexed items
+    int size () const noexcept { return this->S; }
+    // Item at `index` (negative index counts from the end)
+    T get (int index) const { return this->values[idx(index)]; }
+
     /**
-     * @brief Get Product of the `Array` items in range `[from,to]`
-     * @param from Default 0 (Inclusive)
-     * @param to Default Last Index (Inclusive)
-     * @return T - product
+     * @brief Replace item at `index` and update the tree in O(log n)
+     * @param index Item index (negative index counts from the end)
+     * @param value New value
      */
-    T product (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      if (this->S == 0) return 0;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len == 0) return 0;
-      T p = 1;
-      for (int i = b; i <= e; i++) {
-        p *= this->A[i];
-        if (p == 0) return 0;
-      }
-      return p;
+    void set (int index, const T& value) {
+      int i = idx(index);
+      this->values[i] = value;
+      this->tree[this->S + i].sum = (typename Sum::type) value;
+      for (int p = (this->S + i) >> 1; p > 0; p >>= 1) this->tree[p] = this->combine(this->tree[2 * p], this->tree[2 * p + 1]);
+    }
+    /**
+     * @brief Add `delta` to item at `index` and update the tree in O(log n)
+     * @param index Item index (negative index counts from the end)
+     * @param delta Added value
+     */
+    void add (int index, const T& delta) {
+      int i = idx(index);
+      this->set(i, this->values[i] + delta);
     }
 
     /**
-     * @brief Get Arithmetic Mean of the `Array` items in range `[from,to]`
+     * @brief Get min value of items in range `[from,to]`
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
-     * @return double - arithmetic mean
+     * @return T - min value
      */
-    double mean (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+    T min (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
       if (this->S == 0) return 0;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len == 0) return 0;
-      return (this->sum(b, e) * 1.0) / (len * 1.0);
+      return this->values[this->argmin(from, to)];
     }
-
     /**
-     * @brief Get Geometric Mean of the `Array` items in range `[from,to]`
+     * @brief Get max value of items in range `[from,to]`
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
-     * @return double - geometric mean
+     * @return T - max value
      */
-    double meanG (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+    T max (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
       if (this->S == 0) return 0;
-      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
-      this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len == 0) return 0;
-      return pow(this->product(b, e) * 1.0, 1.0 / (len * 1.0));
+      return this->values[this->argmax(from, to)];
     }
-
     /**
-     * @brief Get Harmonic Mean of the `Array` items in range `[from,to]`
+     * @brief Get index of the first min value of items in range `[from,to]`
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
-     * @return double - harmonic mean
+     * @return int - min value index, `-1` if the tree is empty
      */
-    double meanH (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      if (this->S == 0) return 0;
+    int argmin (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return -1;
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len == 0) return 0;
-      double rs = 0.0;
-      for (int i = b; i <= e; i++) rs += (1.0 / (1.0 * this->A[i]));
-      return (len * 1.0) / rs;
+      return this->query(b, e).lo;
     }
-
     /**
-     * @brief Get Weighted Mean of the `Array` items in range `[from,to]` using `weights` array
-     * @param weights Weights Array. If shorter than `[from,to]` range, weights for remaining elements will be `0`.
-     * If longer than `[from,to]` range, remaining weights will not be used.
+     * @brief Get index of the first max value of items in range `[from,to]`
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
-     * @return double - Weighted mean
+     * @return int - max value index, `-1` if the tree is empty
      */
-    double weightedMean (Array<double> weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const {
-      if (this->S == 0 || weights.size() == 0) return 0;
+    int argmax (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return -1;
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len == 0) return 0;
-      double s = 0.0, ws = 0.0;
-      for (int i = b; i <= e; i++) {
-        int wIdx = i - b;
-        if (wIdx >= weights.size()) break;
-        s += (this->A[i] * weights[wIdx]);
-        ws += weights[wIdx];
-      }
-      return s / ws;
+      return this->query(b, e).hi;
     }
-    double weightedMean (const std::vector < double > &weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromVector(weights), from, to); }
-    double weightedMean (const std::list < double > &weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromList(weights), from, to); }
-    double weightedMean (const std::set < double > &weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromSet(weights), from, to); }
-    double weightedMean (std::initializer_list<double> weights, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromInitList(weights), from, to); }
-    double weightedMean (double* weights, int size, int from = ARRAY_BEGIN, int to = ARRAY_END) const { return weightedMean(Array<double>::fromPointer(weights, size), from, to); }
-
     /**
-     * @brief Get Variance of the `Array` items in range `[from,to]`
+     * @brief Get Sum of items in range `[from,to]`
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
-     * @return double - variance
+     * @return T - sum
      */
-    double variance (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+    T sum (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
       if (this->S == 0) return 0;
       int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
       this->checkRange(b, e);
-      int len = e - b + 1;
-      if (len <= 1) return 0;
-      double m = this->mean(b, e), s = 0.0;
-      for (int i = b; i <= e; i++) { s += pow(this->A[i] - m, 2.0); }
-      return s / (this->S - 1.0);
+      return Sum::value(this->query(b, e).sum);
     }
-
     /**
-     * @brief Get Standard Deviation of the `Array` items in range `[from,to]`
+     * @brief Get Arithmetic Mean of items in range `[from,to]`
      * @param from Default 0 (Inclusive)
      * @param to Default Last Index (Inclusive)
-     * @return double - standard deviation
-     */
-    double stdev (int from = ARRAY_BEGIN, int to = ARRAY_END) const { return sqrt(this->variance(from, to)); }
-
-    /*
-     * OPERATORS
-     */
-    // Copy assignment operator
-    Array& operator=(const Array& other) {
-      if (this != &other) {
-        free(this->A);
-        this->S = other.S;
-        if (this->S > 0) {
-          this->A = (T*) malloc(this->S * sizeof(T));
-          for (int i = 0; i < S; i++) this->A[i] = other.A[i];
-        } else this->A = nullptr;
-      }
-      return *this;
-    }
-    // Move assignment operator
-    Array& operator=(Array&& other) noexcept {
-      if (this != &other) {
-        free(this->A);
-        this->S = other.S;
-        this->A = other.A;
-        other.S = 0;
-        other.A = nullptr;
-      }
-      return *this;
-    }
-
-    /*
-     * Arithmetic operations with constants (keeping the Array)
+     * @return double - arithmetic mean
      */
-    Array<T> operator+ (const T& number) const {
-      Array <T> X;
-      X.sizeAlloc(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = this->A[i] + number;
-      return X;
-    }
-    Array<T> operator- (const T& number) const {
-      Array <T> X;
-      X.sizeAlloc(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = this->A[i] - number;
-      return X;
-    }
-    Array<T> operator* (const T& number) const {
-      Array <T> X;
-      X.sizeAlloc(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (this->A[i] * number);
-      return X;
-    }
-    Array<T> operator/ (const T& number) const {
-      Array <T> X;
-      X.sizeAlloc(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (this->A[i] / number);
-      return X;
-    }
-    Array<T> operator% (const T& number) const {
-      Array <T> X;
-      X.sizeAlloc(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (this->A[i] % number);
-      return X;
-    }
-
-    /*
-     * Arithmetic operations with arrays (keeping both arrays)
-     */
-    Array<T> operator+ (const Array<T>& array) const {
-      int max_size = MAX_S(this->S, array.size());
-      Array <T> X;
-      X.sizeAlloc(max_size);
-      for (int i = 0; i < this->S; i++) X[i] += this->A[i];
-      for (int i = 0; i < array.size(); i++) X[i] += array[i];
-      return X;
-    }
-    Array<T> operator+ (const std::vector <T> &STL_Vector) const { return this->operator+(Array::fromVector(STL_Vector)); }
-    Array<T> operator+ (const std::list <T> &STL_List) const { return this->operator+(Array::fromList(STL_List)); }
-    Array<T> operator+ (const std::set <T> &STL_Set) const { return this->operator+(Array::fromSet(STL_Set)); }
-    Array<T> operator+ (const std::initializer_list <T> &STL_InitList) const { return this->operator+(Array::fromInitList(STL_InitList)); }
-    Array<T> operator- (const Array<T>& array) const {
-      int max_size = MAX_S(this->S, array.size());
-      Array <T> X;
-      X.sizeAlloc(max_size);
-      for (int i = 0; i < this->S; i++) X[i] += this->A[i];
-      for (int i = 0; i < array.size(); i++) X[i] -= array[i];
-      return X;
-    }
-    Array<T> operator- (const std::vector <T> &STL_Vector) const { return this->operator-(Array::fromVector(STL_Vector)); }
-    Array<T> operator- (const std::list <T> &STL_List) const { return this->operator-(Array::fromList(STL_List)); }
-    Array<T> operator- (const std::set <T> &STL_Set) const { return this->operator-(Array::fromSet(STL_Set)); }
-    Array<T> operator- (const std::initializer_list <T> &STL_InitList) const { return this->operator-(Array::fromInitList(STL_InitList)); }
-    Array<T> operator* (const Array<T>& array) const {
-      int max_size = MAX_S(this->S, array.size());
-      Array <T> X;
-      X.sizeAlloc(max_size);
-      for (int i = 0; i < this->S; i++) X[i] += this->A[i];
-      for (int i = 0; i < array.size(); i++) X[i] *= array[i];
-      return X;
-    }
-    Array<T> operator* (const std::vector <T> &STL_Vector) const { return this->operator*(Array::fromVector(STL_Vector)); }
-    Array<T> operator* (const std::list <T> &STL_List) const { return this->operator*(Array::fromList(STL_List)); }
-    Array<T> operator* (const std::set <T> &STL_Set) const { return this->operator*(Array::fromSet(STL_Set)); }
-    Array<T> operator* (const std::initializer_list <T> &STL_InitList) const { return this->operator*(Array::fromInitList(STL_InitList)); }
-    Array<T> operator/ (const Array<T>& array) const {
-      int max_size = MAX_S(this->S, array.size());
-      Array <T> X;
-      X.sizeAlloc(max_size);
-      for (int i = 0; i < this->S; i++) X[i] += this->A[i];
-      for (int i = 0; i < array.size(); i++) X[i] /= array[i];
-      return X;
-    }
-    Array<T> operator/ (const std::vector <T> &STL_Vector) const { return this->operator/(Array::fromVector(STL_Vector)); }
-    Array<T> operator/ (const std::list <T> &STL_List) const { return this->operator/(Array::fromList(STL_List)); }
-    Array<T> operator/ (const std::set <T> &STL_Set) const { return this->operator/(Array::fromSet(STL_Set)); }
-    Array<T> operator/ (const std::initializer_list <T> &STL_InitList) const { return this->operator/(Array::fromInitList(STL_InitList)); }
-    Array<T> operator% (const Array<T>& array) const {
-      int max_size = MAX_S(this->S, array.size());
-      Array <T> X;
-      X.sizeAlloc(max_size);
-      for (int i = 0; i < this->S; i++) X[i] += this->A[i];
-      for (int i = 0; i < array.size(); i++) X[i] %= array[i];
-      return X;
+    double mean (int from = ARRAY_BEGIN, int to = ARRAY_END) const {
+      if (this->S == 0) return 0;
+      int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+      this->checkRange(b, e);
+      return Sum::mean(this->query(b, e).sum, e - b + 1);
     }
-    Array<T> operator% (const std::vector <T> &STL_Vector) const { return this->operator%(Array::fromVector(STL_Vector)); }
-    Array<T> operator% (const std::list <T> &STL_List) const { return this->operator%(Array::fromList(STL_List)); }
-    Array<T> operator% (const std::set <T> &STL_Set) const { return this->operator%(Array::fromSet(STL_Set)); }
-    Array<T> operator% (const std::initializer_list <T> &STL_InitList) const { return this->operator%(Array::fromInitList(STL_InitList)); }
+};
 
-    /*
-     * Arithmetic operations with constants (modifying the Array)
-     */
-    Array<T> operator+= (const T& number) {
-      for (int i = 0; i < this->S; i++) this->A[i] += number;
-      return *this;
-    }
-    Array<T> operator-= (const T& number) {
-      for (int i = 0; i < this->S; i++) this->A[i] -= number;
-      return *this;
-    }
-    Array<T> operator*= (const T& number) {
-      for (int i = 0; i < this->S; i++) this->A[i] *= number;
-      return *this;
-    }
-    Array<T> operator/= (const T& number) {
-      for (int i = 0; i < this->S; i++) this->A[i] /= number;
-      return *this;
+/**
+ * @brief Hash index for repeated `contains`, `find`, `count` and `findAll` lookups of elements in an Array.
+ * Distinct items are kept in an open-addressing table (linear probing over 8-byte slots with hash tags,
+ * load factor up to 1/2), so a lookup usually touches one or two adjacent slots and one key. Each distinct item keeps
+ * its first index and count, and the indices of equal items are chained in ascending order.
+ * Lookups take O(1) expected time, `findAll` also O(number of indices). Building takes O(n) expected time.
+ * The index does not follow changes of the Array by itself: call `afterAppend`, `afterInsert` or `afterErase`
+ * after the matching Array change (only the new items are hashed), or `build` after any other change.
+ * Keys whose items were all erased stay in the table (with count 0) until `build`, so memory grows under erase churn
+ */
+template <class T>
+class HashIndex {
+  private:
+    // Indices of the items equal to a key: first, last (end of its chain) and their number
+    struct Entry {
+      int first;
+      int last;
+      int count;
+    };
+    std::vector<T> keys;  // Distinct items, in order of first indexing. Items erased later keep their key with count 0
+    std::vector<Entry> entries;
+    std::vector<int> next;     // `next[i]` = next index with the same item as index `i`, `-1` at the end of the chain
+    std::vector<int> groupOf;  // Key of the item at index `i`
+    std::vector<array_detail::GroupSlot> slots;
+    size_t mask;
+    int S;
+    void reset () {
+      array_detail::GroupSlot empty = { 0, -1 };
+      this->mask = 15;
+      this->slots.assign(this->mask + 1, empty);
+      this->keys.clear();
+      this->entries.clear();
     }
-    Array<T> operator%= (const T& number) {
-      for (int i = 0; i < this->S; i++) this->A[i] %= number;
-      return *this;
+    // Grow the table to hold `distinct` keys at load factor 1/2. Slots are placed again by their tags, without hashing
+    void reserve (size_t distinct) {
+      size_t size = this->mask + 1;
+      while (size < distinct * 2) size *= 2;
+      if (size == this->mask + 1) return;
+      array_detail::GroupSlot empty = { 0, -1 };
+      std::vector<array_detail::GroupSlot> old(size, empty);
+      old.swap(this->slots);
+      this->mask = size - 1;
+      for (size_t k = 0; k < old.size(); k++) {
+        if (old[k].group < 0) continue;
+        size_t t = (size_t) old[k].tag & this->mask;
+        while (this->slots[t].group >= 0) t = (t + 1) & this->mask;
+        this->slots[t] = old[k];
+      }
     }
-
-    
-    /*
-     * Arithmetic operations with other arrays (modifying the first Array)
-     */
-    Array<T> operator+= (const Array<T> &array) {
-      for (int i = this->S; i < array.size(); i++) this->append((T)(0));
-      for (int i = 0; i < array.size(); i++) this->A[i] += array[i];
-      return *this;
+    // Slot holding `x`, or the empty slot where it belongs
+    size_t slotOf (const T& x, uint32_t tag) const {
+      size_t s = (size_t) tag & this->mask;
+      int g;
+      while ((g = this->slots[s].group) >= 0 && !(this->slots[s].tag == tag && this->keys[g] == x)) s = (s + 1) & this->mask;
+      return s;
     }
-    Array<T> operator+= (const std::vector <T> &STL_Vector) { return this->operator+=(Array::fromVector(STL_Vector)); }
-    Array<T> operator+= (const std::list <T> &STL_List) { return this->operator+=(Array::fromList(STL_List)); }
-    Array<T> operator+= (const std::set <T> &STL_Set) { return this->operator+=(Array::fromSet(STL_Set)); }
-    Array<T> operator+= (const std::initializer_list <T> &STL_InitList) { return this->operator+=(Array::fromInitList(STL_InitList)); }
-    Array<T> operator-= (const Array<T> &array) {
-      for (int i = this->S; i < array.size(); i++) this->append((T)(0));
-      for (int i = 0; i < array.size(); i++) this->A[i] -= array[i];
-      return *this;
+    // Key of `x`, `-1` if it was never indexed
+    int lookup (const T& x) const { return this->slots[this->slotOf(x, (uint32_t) array_detail::hashOf(x))].group; }
+    // Key of `x`, added if it was never indexed. The table doubles when it gets half full
+    int keyOf (const T& x) {
+      uint32_t tag = (uint32_t) array_detail::hashOf(x);
+      size_t s = this->slotOf(x, tag);
+      int g = this->slots[s].group;
+      if (g >= 0) return g;
+      g = (int) this->keys.size();
+      Entry entry = { -1, -1, 0 };
+      this->keys.push_back(x);
+      this->entries.push_back(entry);
+      this->slots[s].tag = tag;
+      this->slots[s].group = g;
+      if (this->keys.size() * 2 > this->mask + 1) this->reserve(this->keys.size());
+      return g;
     }
-    Array<T> operator-= (const std::vector <T> &STL_Vector) { return this->operator-=(Array::fromVector(STL_Vector)); }
-    Array<T> operator-= (const std::list <T> &STL_List) { return this->operator-=(Array::fromList(STL_List)); }
-    Array<T> operator-= (const std::set <T> &STL_Set) { return this->operator-=(Array::fromSet(STL_Set)); }
-    Array<T> operator-= (const std::initializer_list <T> &STL_InitList) { return this->operator-=(Array::fromInitList(STL_InitList)); }
-    Array<T> operator*= (const Array<T> &array) {
-      for (int i = this->S; i < array.size(); i++) this->append((T)(0));
-      for (int i = 0; i < array.size(); i++) this->A[i] *= array[i];
-      return *this;
+    // Append index `i` to the chain of key `g` (indices are linked in ascending order)
+    void link (int i, int g) {
+      Entry &entry = this->entries[g];
+      this->next[i] = -1;
+      if (entry.count++ == 0) entry.first = i;
+      else this->next[entry.last] = i;
+      entry.last = i;
     }
-    Array<T> operator*= (const std::vector <T> &STL_Vector) { return this->operator*=(Array::fromVector(STL_Vector)); }
-    Array<T> operator*= (const std::list <T> &STL_List) { return this->operator*=(Array::fromList(STL_List)); }
-    Array<T> operator*= (const std::set <T> &STL_Set) { return this->operator*=(Array::fromSet(STL_Set)); }
-    Array<T> operator*= (const std::initializer_list <T> &STL_InitList) { return this->operator*=(Array::fromInitList(STL_InitList)); }
-    Array<T> operator/= (const Array<T> &array) {
-      for (int i = this->S; i < array.size(); i++) this->append((T)(0));
-      for (int i = 0; i < array.size(); i++) this->A[i] /= array[i];
-      return *this;
+    // Rebuild all chains from `groupOf` after indices moved, without hashing
+    void relink () {
+      Entry empty = { -1, -1, 0 };
+      for (size_t g = 0; g < this->entries.size(); g++) this->entries[g] = empty;
+      for (int i = 0; i < this->S; i++) this->link(i, this->groupOf[i]);
     }
-    Array<T> operator/= (const std::vector <T> &STL_Vector) { return this->operator/=(Array::fromVector(STL_Vector)); }
-    Array<T> operator/= (const std::list <T> &STL_List) { return this->operator/=(Array::fromList(STL_List)); }
-    Array<T> operator/= (const std::set <T> &STL_Set) { return this->operator/=(Array::fromSet(STL_Set)); }
-    Array<T> operator/= (const std::initializer_list <T> &STL_InitList) { return this->operator/=(Array::fromInitList(STL_InitList)); }
-    Array<T> operator%= (const Array<T> &array) {
-      for (int i = this->S; i < array.size(); i++) this->append((T)(0));
-      for (int i = 0; i < array.size(); i++) this->A[i] %= array[i];
-      return *this;
+    // Index position `index` of an Array of `size` items before its change, as the Array method resolved it
+    static int position (int index, int size) {
+      if (index < -size || index > size) throw std::invalid_argument("Invalid Array Index!");
+      return index < 0 ? index + size : index;
     }
-    Array<T> operator%= (const std::vector <T> &STL_Vector) { return this->operator%=(Array::fromVector(STL_Vector)); }
-    Array<T> operator%= (const std::list <T> &STL_List) { return this->operator%=(Array::fromList(STL_List)); }
-    Array<T> operator%= (const std::set <T> &STL_Set) { return this->operator%=(Array::fromSet(STL_Set)); }
-    Array<T> operator%= (const std::initializer_list <T> &STL_InitList) { return this->operator%=(Array::fromInitList(STL_InitList)); }
-
-    /*
-     * Boolean operators - comparing to constant
+  public:
+    HashIndex () : mask(15), S(0) { this->reset(); }
+    /**
+     * @brief Build index of `array` items
+     * @param array Indexed Array
      */
-    Array<bool> operator== (const T& val) const {
-      Array<bool> X(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (this->A[i] == val);
-      return X;
-    }
-    Array<bool> operator>= (const T& val) const {
-      Array<bool> X(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (this->A[i] >= val);
-      return X;
-    }
-    Array<bool> operator<= (const T& val) const {
-      Array<bool> X(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (this->A[i] <= val);
-      return X;
-    }
-    Array<bool> operator> (const T& val) const {
-      Array<bool> X(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (this->A[i] > val);
-      return X;
-    }
-    Array<bool> operator< (const T& val) const {
-      Array<bool> X(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (this->A[i] < val);
-      return X;
-    }
-    Array<bool> operator!= (const T& val) const {
-      Array<bool> X(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (this->A[i] != val);
-      return X;
-    }
+    template <class Alloc>
+    explicit HashIndex (const Array<T, Alloc> &array) : mask(15), S(0) { this->build(array); }
 
-    /* 
-     * Boolean operators - comparing to another `Array`
+    /**
+     * @brief Rebuild index from `array` items (e.g. after the Array changed). Also drops items that were erased
+     * @param array Indexed Array
      */
-    Array<bool> operator== (const Array<T> &array) const {
-      int max_size = MAX_S(this->S, array.size());
-      Array<bool> X(max_size);
-      for (int i = 0; i < max_size; i++) {
-        X[i] = (i >= this->S || i >= array.size()) ? false : (this->A[i] == array[i]);
-      }
-      return X;
-    }
-    Array<bool> operator== (const std::vector <T> &STL_Vector) const { return this->operator==(Array::fromVector(STL_Vector)); }
-    Array<bool> operator== (const std::list <T> &STL_List) const { return this->operator==(Array::fromList(STL_List)); }
-    Array<bool> operator== (const std::set <T> &STL_Set) const { return this->operator==(Array::fromSet(STL_Set)); }
-    Array<bool> operator== (const std::initializer_list <T> &STL_InitList) const { return this->operator==(Array::fromInitList(STL_InitList)); }
-    Array<bool> operator>= (const Array<T> &array) {
-      int max_size = MAX_S(this->S, array.size());
-      Array<bool> X(max_size);
-      for (int i = 0; i < max_size; i++) {
-        X[i] = (i >= this->S || i >= array.size()) ? false : (this->A[i] >= array[i]);
-      }
-      return X;
-    }
-    Array<bool> operator>= (const std::vector <T> &STL_Vector) const { return this->operator>=(Array::fromVector(STL_Vector)); }
-    Array<bool> operator>= (const std::list <T> &STL_List) const { return this->operator>=(Array::fromList(STL_List)); }
-    Array<bool> operator>= (const std::set <T> &STL_Set) const { return this->operator>=(Array::fromSet(STL_Set)); }
-    Array<bool> operator>= (const std::initializer_list <T> &STL_InitList) const { return this->operator>=(Array::fromInitList(STL_InitList)); }
-    Array<bool> operator<= (const Array<T> &array) {
-      int max_size = MAX_S(this->S, array.size());
-      Array<bool> X(max_size);
-      for (int i = 0; i < max_size; i++) {
-        X[i] = (i >= this->S || i >= array.size()) ? false : (this->A[i] <= array[i]);
+    template <class Alloc>
+    void build (const Array<T, Alloc> &array) {
+      this->reset();
+      this->reserve(array.S);
+      this->S = array.S;
+      this->next.resize(this->S);
+      this->groupOf.resize(this->S);
+      for (int i = 0; i < this->S; i++) {
+        int g = this->keyOf(array.A[i]);
+        this->groupOf[i] = g;
+        this->link(i, g);
       }
-      return X;
     }
-    Array<bool> operator<= (const std::vector <T> &STL_Vector) const { return this->operator<=(Array::fromVector(STL_Vector)); }
-    Array<bool> operator<= (const std::list <T> &STL_List) const { return this->operator<=(Array::fromList(STL_List)); }
-    Array<bool> operator<= (const std::set <T> &STL_Set) const { return this->operator<=(Array::fromSet(STL_Set)); }
-    Array<bool> operator<= (const std::initializer_list <T> &STL_InitList) const { return this->operator<=(Array::fromInitList(STL_InitList)); }
-    Array<bool> operator> (const Array<T> &array) {
-      int max_size = MAX_S(this->S, array.size());
-      Array<bool> X(max_size);
-      for (int i = 0; i < max_size; i++) {
-        X[i] = (i >= this->S || i >= array.size()) ? false : (this->A[i] > array[i]);
+    /**
+     * @brief Update index after items were appended to `array` (`array.append(...)`). Only the new items are hashed
+     * @param array Indexed Array, after the change
+     */
+    template <class Alloc>
+    void afterAppend (const Array<T, Alloc> &array) {
+      if (array.S < this->S) throw std::invalid_argument("Array has fewer items than the index");
+      int old = this->S;
+      this->reserve(this->keys.size() + (array.S - old));
+      this->S = array.S;
+      this->next.resize(this->S);
+      this->groupOf.resize(this->S);
+      for (int i = old; i < this->S; i++) {
+        int g = this->keyOf(array.A[i]);
+        this->groupOf[i] = g;
+        this->link(i, g);
       }
-      return X;
     }
-    Array<bool> operator> (const std::vector <T> &STL_Vector) const { return this->operator>(Array::fromVector(STL_Vector)); }
-    Array<bool> operator> (const std::list <T> &STL_List) const { return this->operator>(Array::fromList(STL_List)); }
-    Array<bool> operator> (const std::set <T> &STL_Set) const { return this->operator>(Array::fromSet(STL_Set)); }
-    Array<bool> operator> (const std::initializer_list <T> &STL_InitList) const { return this->operator>(Array::fromInitList(STL_InitList)); }
-    Array<bool> operator< (const Array<T> &array) {
-      int max_size = MAX_S(this->S, array.size());
-      Array<bool> X(max_size);
-      for (int i = 0; i < max_size; i++) {
-        X[i] = (i >= this->S || i >= array.size()) ? false : (this->A[i] < array[i]);
-      }
-      return X;
+    /**
+     * @brief Update index after items were inserted into `array` (`array.insert(..., index)`). Only the new items are hashed,
+     * moved indices are relinked in one linear pass
+     * @param array Indexed Array, after the change
+     * @param index Insert position passed to `array.insert` (Default 0)
+     */
+    template <class Alloc>
+    void afterInsert (const Array<T, Alloc> &array, int index = ARRAY_BEGIN) {
+      if (array.S < this->S) throw std::invalid_argument("Array has fewer items than the index");
+      int added = array.S - this->S;
+      if (added == 0) return;
+      int b = position(index, this->S);
+      this->groupOf.insert(this->groupOf.begin() + b, added, 0);
+      for (int i = b; i < b + added; i++) this->groupOf[i] = this->keyOf(array.A[i]);
+      this->S = array.S;
+      this->next.resize(this->S);
+      this->relink();
     }
-    Array<bool> operator< (const std::vector <T> &STL_Vector) const { return this->operator<(Array::fromVector(STL_Vector)); }
-    Array<bool> operator< (const std::list <T> &STL_List) const { return this->operator<(Array::fromList(STL_List)); }
-    Array<bool> operator< (const std::set <T> &STL_Set) const { return this->operator<(Array::fromSet(STL_Set)); }
-    Array<bool> operator< (const std::initializer_list <T> &STL_InitList) const { return this->operator<(Array::fromInitList(STL_InitList)); }
-    Array<bool> operator!= (const Array<T> &array) {
-      int max_size = MAX_S(this->S, array.size());
-      Array<bool> X(max_size);
-      for (int i = 0; i < max_size; i++) {
-        X[i] = (i >= this->S || i >= array.size()) ? false : (this->A[i] != array[i]);
+    /**
+     * @brief Update index after items were erased from `array` (`array.erase(index, count)`). Moved indices are relinked
+     * in one linear pass, no item is hashed
+     * @param array Indexed Array, after the change
+     * @param index Erase position passed to `array.erase` (Default 0)
+     * @param count Number of items passed to `array.erase` (Default 1), clamped at the end of the Array like `erase` does
+     */
+    template <class Alloc>
+    void afterErase (const Array<T, Alloc> &array, int index = ARRAY_BEGIN, int count = 1) {
+      int removed = 0, b = 0;
+      if (this->S > 0 && count > 0) {
+        b = position(index, this->S);
+        removed = count > this->S - b ? this->S - b : count;
       }
-      return X;
+      if (array.S != this->S - removed) throw std::invalid_argument("Array size does not match the erased items");
+      if (removed == 0) return;
+      this->groupOf.erase(this->groupOf.begin() + b, this->groupOf.begin() + b + removed);
+      this->S = array.S;
+      this->next.resize(this->S);
+      this->relink();
     }
-    Array<bool> operator!= (const std::vector <T> &STL_Vector) const { return this->operator!=(Array::fromVector(STL_Vector)); }
-    Array<bool> operator!= (const std::list <T> &STL_List) const { return this->operator!=(Array::fromList(STL_List)); }
-    Array<bool> operator!= (const std::set <T> &STL_Set) const { return this->operator!=(Array::fromSet(STL_Set)); }
-    Array<bool> operator!= (const std::initializer_list <T> &STL_InitList) const { return this->operator!=(Array::fromInitList(STL_InitList)); }
+
+    // Number of indexed items
+    int size () const noexcept { return this->S; }
 
     /**
-     * Boolean operators for Array Masks (Keeping inital Array Masks)
+     * @brief Check if an indexed item equals `elem` (same as `Array::contains`)
+     * @param elem Searched element
+     * @return true - `elem` found,
+     * @return false - `elem` not found
      */
-    Array<bool> operator! () const {
-      Array<bool> X(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = !(this->A[i]);
-      return X;
-    }
-    Array<bool> operator| (const Array<bool> &mask) const {
-      int max_size = MAX_S(this->S, mask.size());
-      Array<bool> X(max_size);
-      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i];
-      for (int i = 0; i < mask.size(); i++) X[i] = (bool) X[i] | (bool) mask[i];
-      return X;
-    }
-    Array<bool> operator| (const std::vector<bool> &mask) const { return this->operator|(Array<bool>::fromVector(mask)); }
-    Array<bool> operator| (const std::list<bool> &mask) const { return this->operator|(Array<bool>::fromList(mask)); }
-    Array<bool> operator| (const std::set<bool> &mask) const { return this->operator|(Array<bool>::fromSet(mask)); }
-    Array<bool> operator| (const std::initializer_list<bool> &mask) const { return this->operator|(Array<bool>::fromInitList(mask)); }
-    Array<bool> operator& (const Array<bool> &mask) const {
-      int max_size = MAX_S(this->S, mask.size());
-      Array<bool> X(max_size);
-      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i];
-      for (int i = 0; i < mask.size(); i++) X[i] = (bool) X[i] & (bool) mask[i];
-      return X;
+    bool contains (const T& elem) const {
+      int g = this->lookup(elem);
+      return g >= 0 && this->entries[g].count > 0;
     }
-    Array<bool> operator& (const std::vector<bool> &mask) const { return this->operator&(Array<bool>::fromVector(mask)); }
-    Array<bool> operator& (const std::list<bool> &mask) const { return this->operator&(Array<bool>::fromList(mask)); }
-    Array<bool> operator& (const std::set<bool> &mask) const { return this->operator&(Array<bool>::fromSet(mask)); }
-    Array<bool> operator& (const std::initializer_list<bool> &mask) const { return this->operator&(Array<bool>::fromInitList(mask)); }
-    Array<bool> operator^ (const Array<bool> &mask) const {
-      int max_size = MAX_S(this->S, mask.size());
-      Array<bool> X(max_size);
-      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i];
-      for (int i = 0; i < mask.size(); i++) X[i] = (bool) X[i] ^ (bool) mask[i];
-      return X;
-    }
-    Array<bool> operator^ (const std::vector<bool> &mask) const { return this->operator^(Array<bool>::fromVector(mask)); }
-    Array<bool> operator^ (const std::list<bool> &mask) const { return this->operator^(Array<bool>::fromList(mask)); }
-    Array<bool> operator^ (const std::set<bool> &mask) const { return this->operator^(Array<bool>::fromSet(mask)); }
-    Array<bool> operator^ (const std::initializer_list<bool> &mask) const { return this->operator^(Array<bool>::fromInitList(mask)); }
-
     /**
-     * Boolean operators with `bool` constant for Array Mask (Keeping inital Array Mask)
+     * @brief Get index of the first item equal to `elem` (same as `Array::find`)
+     * @param elem Searched element
+     * @return int - first index, `-1` if not found
      */
-    Array<bool> operator| (bool val) const {
-      Array<bool> X(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i] | val;
-      return X;
-    }
-    Array<bool> operator& (bool val) const {
-      Array<bool> X(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i] & val;
-      return X;
+    int find (const T& elem) const {
+      int g = this->lookup(elem);
+      return g >= 0 && this->entries[g].count > 0 ? this->entries[g].first : -1;
     }
-    Array<bool> operator^ (bool val) const {
-      Array<bool> X(this->S);
-      for (int i = 0; i < this->S; i++) X[i] = (bool) A[i] ^ val;
-      return X;
-    }
-
     /**
-     * Boolean operators for Array Masks (modifying initial Array Mask)
+     * @brief Count items equal to `elem` (same as `Array::count`)
+     * @param elem Searched element
+     * @return int - number of occurrences
      */
-    Array<bool> operator|= (const Array<bool> &mask) {
-      int max_size = MAX_S(this->S, mask.size());
-      for (int i = this->S; i < max_size; i++) this->append(false);
-      for (int i = 0; i < mask.size(); i++) this->A[i] = (bool) A[i] | (bool) mask[i];
-      return *this;
-    }
-    Array<bool> operator|= (const std::vector<bool> &mask) { return this->operator|=(Array<bool>::fromVector(mask)); }
-    Array<bool> operator|= (const std::list<bool> &mask) { return this->operator|=(Array<bool>::fromList(mask)); }
-    Array<bool> operator|= (const std::set<bool> &mask) { return this->operator|=(Array<bool>::fromSet(mask)); }
-    Array<bool> operator|= (const std::initializer_list<bool> &mask) { return this->operator|=(Array<bool>::fromInitList(mask)); }
-    Array<bool> operator&= (const Array<bool> &mask) {
-      int max_size = MAX_S(this->S, mask.size());
-      for (int i = this->S; i < max_size; i++) this->append(false);
-      for (int i = 0; i < mask.size(); i++) this->A[i] = (bool) A[i] & (bool) mask[i];
-      return *this;
+    int count (const T& elem) const {
+      int g = this->lookup(elem);
+      return g >= 0 ? this->entries[g].count : 0;
     }
-    Array<bool> operator&= (const std::vector<bool> &mask) { return this->operator&=(Array<bool>::fromVector(mask)); }
-    Array<bool> operator&= (const std::list<bool> &mask) { return this->operator&=(Array<bool>::fromList(mask)); }
-    Array<bool> operator&= (const std::set<bool> &mask) { return this->operator&=(Array<bool>::fromSet(mask)); }
-    Array<bool> operator&= (const std::initializer_list<bool> &mask) { return this->operator&=(Array<bool>::fromInitList(mask)); }
-    Array<bool> operator^= (const Array<bool> &mask) {
-      int max_size = MAX_S(this->S, mask.size());
-      for (int i = this->S; i < max_size; i++) this->append(false);
-      for (int i = 0; i < mask.size(); i++) this->A[i] = (bool) A[i] ^ (bool) mask[i];
-      return *this;
+    /**
+     * @brief Get indices of all items equal to `elem` in ascending order (same as `Array::findAll`)
+     * @param elem Searched element
+     * @return Array<int> - indices
+     */
+    Array<int> findAll (const T& elem) const {
+      Array<int> X;
+      int g = this->lookup(elem);
+      if (g < 0 || this->entries[g].count == 0) return X;
+      X.sizeAlloc(this->entries[g].count);
+      for (int i = this->entries[g].first, k = 0; i >= 0; i = this->next[i]) X.A[k++] = i;
+      X.order = 'a';
+      return X;
     }
-    Array<bool> operator^= (const std::vector<bool> &mask) { return this->operator^=(Array<bool>::fromVector(mask)); }
-    Array<bool> operator^= (const std::list<bool> &mask) { return this->operator^=(Array<bool>::fromList(mask)); }
-    Array<bool> operator^= (const std::set<bool> &mask) { return this->operator^=(Array<bool>::fromSet(mask)); }
-    Array<bool> operator^= (const std::initializer_list<bool> &mask) { return this->operator^=(Array<bool>::fromInitList(mask)); }
 };
 
+/*
+ * Packed `Array<bool>` file I/O (defined after `ArrayWriter` / `ArrayReader`, which it needs complete)
+ */
+template <class Alloc>
+void Array<bool, Alloc>::save (const std::string &path, int from, int to) const {
+  ArrayWriter<bool> writer(path);
+  if (this->S > 0) {
+    int b = idx(from), e = (to == ARRAY_END ? this->S - 1 : idx(to));
+    this->checkRange(b, e);
+    bool buffer[4096];
+    for (int i = b; i <= e; i += 4096) {
+      int n = e - i + 1 < 4096 ? e - i + 1 : 4096;
+      for (int j = 0; j < n; j++) buffer[j] = this->get(i + j);
+      writer.write(buffer, n);
+    }
+  }
+  writer.close();
+}
+
+template <class Alloc>
+Array<bool, Alloc> Array<bool, Alloc>::load (const std::string &path) {
+  ArrayReader<bool> reader(path);
+  if (reader.size() > (unsigned long long) ARRAY_END) throw std::invalid_argument("File holds too many elements for an Array: " + path);
+  Array X((int) reader.size());
+  bool buffer[4096];
+  int pos = 0, got;
+  while ((got = reader.read(buffer, 4096)) > 0) {
+    for (int i = 0; i < got; i++) X.put(pos + i, buffer[i]);
+    pos += got;
+  }
+  reader.close();
+  return X;
+}
+
 #endif // !DINGO_ARRAY_H
@@ -4,6 +4,8 @@
 #include <list>
 #include <set>
 #include <ctime>
+#include <cstdlib>
+#include <algorithm>
 #include "dingo_array.h"
 
 using namespace std;
@@ -124,6 +126,19 @@ void testMethodErase () {
   cout<<"a.erase(-1): ";
   a.erase(-1);
   a.show();
+  Array<int> b({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+  cout<<"b.show(): ";
+  b.show();
+  cout<<"b.erase(8, 5): ";
+  b.erase(8, 5);
+  b.show();
+  cout<<"b.erase(1, 10): ";
+  b.erase(1, 10);
+  b.show();
+  Array<int> c({1, 2});
+  cout<<"c = [1, 2], c.erase(1, 5): ";
+  c.erase(1, 5);
+  c.show();
 }
 
 void testMethodFill () {
@@ -168,6 +183,137 @@ void testMethodResize () {
   a.show();
 }
 
+void testMethodsCapacity () {
+  Array<int> a({1, 2, 3, 4});
+  cout<<"a.show(): ";
+  a.show();
+  cout<<"a.capacity() = "<<a.capacity()<<endl;
+  cout<<"a.reserve(100): ";
+  a.reserve(100);
+  a.show();
+  cout<<"a.capacity() = "<<a.capacity()<<endl;
+  for (int i = 0; i < 1000; i++) a.append(i);
+  cout<<"a.size() after 1000 appends = "<<a.size()<<", a.capacity() >= a.size() -> "<<(a.capacity() >= a.size())<<endl;
+  cout<<"a.erase(4, 1000); a.shrinkToFit(): ";
+  a.erase(4, 1000);
+  a.shrinkToFit();
+  a.show();
+  cout<<"a.capacity() = "<<a.capacity()<<endl;
+  cout<<"a.clear(); a.capacity() = ";
+  a.clear();
+  cout<<a.capacity()<<endl;
+}
+
+void testAllocators () {
+  Array<int, ArrayPoolAllocator> p({5, 1, 4, 1, 3});
+  cout<<"Array<int, ArrayPoolAllocator> p = ";
+  p.show();
+  for (int i = 0; i < 100; i++) p.append(i);
+  cout<<"p.size() after 100 appends = "<<p.size()<<", p.findAll(1) = ";
+  p.findAll(1).show();
+  Array<double, ArrayAlignedAllocator<64>> d(10);
+  d.fill(1.5);
+  cout<<"Array<double, ArrayAlignedAllocator<64>> d(10) filled with 1.5, 64-byte aligned -> "<<(((uintptr_t) &d[0]) % 64 == 0)<<", (d * 2).sum() = "<<(d * 2.0).sum()<<endl;
+  ArrayArena arena(1024);
+  {
+    ArrayArena::Scope scope(arena);
+    Array<int, ArrayArenaAllocator> r({3, 2, 1});
+    r.append(Array<int, ArrayArenaAllocator>(p.slice(0, 4)));
+    r.sort();
+    cout<<"Array<int, ArrayArenaAllocator> r sorted = ";
+    r.show();
+    cout<<"r > 2 = ";
+    Array<bool, ArrayArenaAllocator> m = r > 2;
+    m.show();
+    cout<<"arena.used() > 0 -> "<<(arena.used() > 0)<<endl;
+  }
+  arena.reset();
+  cout<<"arena.reset(); arena.used() = "<<arena.used()<<endl;
+  ArrayArena other(1024);
+  {
+    ArrayArena::Scope scope(arena);
+    Array<int, ArrayArenaAllocator> g({1, 2, 3});
+    size_t before = arena.used();
+    {
+      ArrayArena::Scope inner(other);
+      for (int i = 0; i < 100; i++) g.append(i);
+    }
+    other.reset();
+    cout<<"g created in arena, grown while other is active: arena.used() grew -> "<<(arena.used() > before);
+    cout<<", other.used() = "<<other.used()<<", g.sum() = "<<g.sum()<<endl;
+  }
+  Array<int> q(p);
+  cout<<"Array<int> q(p); q.sum() == p.sum() -> "<<(q.sum() == p.sum())<<endl;
+}
+
+void testMapFile () {
+#if ARRAY_MMAP
+  const char* path = "dingo_array_test.bin";
+  int values[] = {4, 8, 15, 16, 23, 42};
+  FILE* f = fopen(path, "wb");
+  fwrite(values, sizeof(int), 6, f);
+  fclose(f);
+  {
+    Array<int, ArrayMapAllocator> m = Array<int>::mapFile(path);
+    m.advise('s');
+    cout<<"Array<int>::mapFile(path) = ";
+    m.show();
+    cout<<"m.sum() = "<<m.sum()<<", m.max() = "<<m.max()<<", m.find(23) = "<<m.find(23)<<", (m > 15) = ";
+    (m > 15).show();
+    m[0] = 100;
+    cout<<"m[0] = 100 (read-only mapping, file unchanged) -> m[0] = "<<m[0]<<endl;
+  }
+  {
+    Array<int, ArrayMapAllocator> w = Array<int>::mapFile(path, false);
+    w[0] = -4;
+    w.flush();
+  }
+  Array<int, ArrayMapAllocator> r = Array<int>::mapFile(path);
+  cout<<"w[0] = -4; w.flush() with writable mapping -> file now: ";
+  r.show();
+  r.append(108);
+  cout<<"r.append(108) (copies to memory) -> ";
+  r.show();
+  remove(path);
+#endif
+}
+
+void testSaveLoad () {
+  const char* path = "dingo_array_test.dna";
+  Array<double> a({1.5, -2.25, 3.0, 4.75, 1e10});
+  cout<<"a = ";
+  a.show();
+  a.save(path);
+  cout<<"a.save(path); Array<double>::load(path) = ";
+  Array<double>::load(path).show();
+  a.save(path, 1, 3);
+  cout<<"a.save(path, 1, 3); Array<double>::load(path) = ";
+  Array<double>::load(path).show();
+  {
+    ArrayWriter<int> writer(path);
+    for (int chunk = 0; chunk < 3; chunk++) {
+      Array<int> c({chunk * 10, chunk * 10 + 1, chunk * 10 + 2});
+      writer.write(c);
+    }
+    writer.write(99);
+    writer.close();
+  }
+  ArrayReader<int> reader(path);
+  cout<<"ArrayReader<int> reader(path); reader.size() = "<<reader.size()<<endl;
+  Array<int> chunk;
+  while (reader.read(chunk, 4) > 0) {
+    cout<<"reader.read(chunk, 4) -> ";
+    chunk.show();
+  }
+  reader.close();
+  try {
+    Array<float>::load(path);
+  } catch (const std::invalid_argument &e) {
+    cout<<"Array<float>::load(path) -> "<<e.what()<<endl;
+  }
+  remove(path);
+}
+
 void testMethodCount () {
   Array<int> a({1, 2, 3, 4, 1, 2, 3, 2, 3});
   cout<<"a.show(): ";
@@ -186,6 +332,12 @@ void testMethodFind () {
   cout<<"a.find(3, 4) = "<<a.find(3, 4)<<endl;
   cout<<"a.find(0) = "<<a.find(0)<<endl;
   cout<<"a.find({1, 2, 3}) = "<<a.find({1, 2, 3})<<endl;
+  Array<int> b({1, 1, 1, 2, 1, 1, 2});
+  cout<<"b.show(): ";
+  b.show();
+  cout<<"b.find({1, 1, 2}) = "<<b.find({1, 1, 2})<<endl;
+  cout<<"b.findAll({1, 1, 2}) = ";
+  b.findAll({1, 1, 2}).show();
 }
 
 void testMethodFindAll () {
@@ -202,6 +354,23 @@ void testMethodFindAll () {
   a.findAll({1, 2, 3}).show();
 }
 
+void testMethodFindAllMulti () {
+  Array<int> a({1, 2, 3, 4, 1, 2, 3, 2, 3});
+  cout<<"a.show(): ";
+  a.show();
+  PatternSet<int> p({{1, 2}, {2, 3}, {1, 2, 3, 4}, {3}});
+  cout<<"a.findAllMulti(p) = ";
+  a.findAllMulti(p).show();
+  cout<<"a.findAllMulti(p, 4) = ";
+  a.findAllMulti(p, 4).show();
+  cout<<"a.findAllMulti({{3, 2}, {9}}) = ";
+  a.findAllMulti({{3, 2}, {9}}).show();
+  Array<int> b({1, 1, 1, 1});
+  PatternSet<int> r({{1, 1}, {1, 1}});
+  cout<<"b.findAllMulti({{1, 1}, {1, 1}}) = ";
+  b.findAllMulti(r).show();
+}
+
 void testMethodShift () {
   Array<int> a({1, 2, 3, 4, 5, 6});
   cout<<"a.show(): ";
@@ -257,6 +426,40 @@ void testMethodSlice () {
   a.slice().show();
 }
 
+void testMethodView () {
+  Array<int> a({1, 2, 3, 4, 5, 6, 2, 8});
+  cout<<"a.show(): ";
+  a.show();
+  ArrayView<int> v = a.view(1, -2);
+  cout<<"a.view(1, -2) = ";
+  v.show();
+  cout<<"a.view(0, -1, 3) = ";
+  a.view(0, -1, 3).show();
+  cout<<"a.view(1, -2).view(1, -1, 2) = ";
+  v.view(1, -1, 2).show();
+  cout<<"v.size() = "<<v.size()<<", v[0] = "<<v[0]<<", v[-1] = "<<v[-1]<<endl;
+  cout<<"v.find(2) = "<<v.find(2)<<", v.count(2) = "<<v.count(2)<<", v.contains(8) = "<<v.contains(8)<<endl;
+  cout<<"v.findAll(2) = ";
+  v.findAll(2).show();
+  cout<<"v.min() = "<<v.min()<<", v.max() = "<<v.max()<<", v.sum() = "<<v.sum()<<", v.product() = "<<v.product()<<endl;
+  cout<<"v.mean() = "<<v.mean()<<", v.variance() = "<<v.variance()<<", v.stdev() = "<<v.stdev()<<endl;
+  cout<<"(v > 3) = ";
+  (v > 3).show();
+  cout<<"(v == a.view(0, -3)) = ";
+  (v == a.view(0, -3)).show();
+  cout<<"(v * 2 + 1) = ";
+  (v * 2 + 1).show();
+  Array<int> b = v + a.view(2);
+  cout<<"Array<int> b = v + a.view(2) -> ";
+  b.show();
+  cout<<"(a * 2) + a.view(0) = ";
+  Array<int>((a * 2) + a.view(0)).show();
+  cout<<"(v > a.slice(0, 2)) = ";
+  Array<bool>(v > a.slice(0, 2)).show();
+  cout<<"v.toArray() = ";
+  v.toArray().show();
+}
+
 void testMethodClear () {
   Array<int> a({1, 2, 3, 4, 5, 6});
   cout<<"a.show(): ";
@@ -272,6 +475,62 @@ void testMethodUnique () {
   a.show();
   cout<<"a.unique(): ";
   a.unique().show();
+  Array<int> b({3, 1, 3, 2, 3, 1});
+  cout<<"b.show(): ";
+  b.show();
+  cout<<"b.unique(): ";
+  b.unique().show();
+  cout<<"b.sortedUnique(): ";
+  b.sortedUnique().show();
+  cout<<"b.uniqueCounts(): ";
+  b.uniqueCounts().show();
+  cout<<"b.uniqueCounts(true): ";
+  b.uniqueCounts(true).show();
+  cout<<"b.uniqueInverse(): ";
+  b.uniqueInverse().show();
+  cout<<"b.uniqueInverse(true): ";
+  b.uniqueInverse(true).show();
+}
+
+void testMethodsSetOperations () {
+  Array<int> a({5, 1, 3, 3, 9, 7});
+  Array<int> b({4, 3, 8, 5, 5, 10});
+  cout<<"a.show(): ";
+  a.show();
+  cout<<"b.show(): ";
+  b.show();
+  cout<<"a.setUnion(b): ";
+  a.setUnion(b).show();
+  cout<<"a.setIntersection(b): ";
+  a.setIntersection(b).show();
+  cout<<"a.setDifference(b): ";
+  a.setDifference(b).show();
+  cout<<"a.setSymmetricDifference(b): ";
+  a.setSymmetricDifference(b).show();
+  cout<<"a.setUnion(b, 'h'): ";
+  a.setUnion(b, 'h').show();
+  cout<<"a.setIntersection(b, 'h'): ";
+  a.setIntersection(b, 'h').show();
+  cout<<"a.setDifference(b, 'h'): ";
+  a.setDifference(b, 'h').show();
+  cout<<"a.setSymmetricDifference(b, 'h'): ";
+  a.setSymmetricDifference(b, 'h').show();
+  cout<<"a.setIntersection({9, 1, 2}): ";
+  a.setIntersection({9, 1, 2}).show();
+  Array<double> c({0.5, 2.5, 1.5});
+  cout<<"c.setDifference(std::vector<double>({2.5, 4.0})): ";
+  c.setDifference(std::vector<double>({2.5, 4.0})).show();
+  Array<int> d(100000), e(3000);
+  for (int i = 0; i < d.size(); i++) d[i] = 2 * i;
+  for (int i = 0; i < e.size(); i++) e[i] = 67 * i;
+  cout<<"d = even numbers, e = multiples of 67, d.setIntersection(e).size() = "<<d.setIntersection(e).size();
+  cout<<", d.setIntersection(e, 'h').size() = "<<d.setIntersection(e, 'h').size()<<endl;
+  cout<<"e.setDifference(d).size() = "<<e.setDifference(d).size()<<", d.setUnion(e).size() = "<<d.setUnion(e).size()<<endl;
+  try {
+    a.setUnion(b, 'x');
+  } catch (std::invalid_argument& e) {
+    cout<<"a.setUnion(b, 'x') -> "<<e.what()<<endl;
+  }
 }
 
 void testMethodSort () {
@@ -293,6 +552,88 @@ void testMethodSort () {
   a.show();
 }
 
+void testMethodSortEngines () {
+  Array<double> d({2.5, -1.0, 0.0, -7.25, 3.0, 1e10, -0.5});
+  cout<<"d = ";
+  d.show();
+  cout<<"d.toSorted() = ";
+  d.toSorted().show();
+  cout<<"d.toSorted(false, 1, -2) = ";
+  d.toSorted(false, 1, -2).show();
+  vector<int> vec;
+  srand(7);
+  for (int i = 0; i < 5000; i++) vec.push_back(rand() % 2001 - 1000);
+  Array<int> big(vec);
+  Array<int> desc = big.toSorted(false);
+  big.sort();
+  std::sort(vec.begin(), vec.end());
+  cout<<"big.sort() matches std::sort = "<<(big.toVector() == vec)<<endl;
+  std::reverse(vec.begin(), vec.end());
+  cout<<"big.toSorted(false) matches reversed std::sort = "<<(desc.toVector() == vec)<<endl;
+  Array<char> c({'d', 'a', 'c', 'b'});
+  cout<<"c.toSorted() = ";
+  c.toSorted().show();
+}
+
+void testMethodSortParallel () {
+  vector<int> vec;
+  srand(11);
+  for (int i = 0; i < 100000; i++) vec.push_back(rand() % 100001 - 50000);
+  Array<int> a(vec);
+  Array<int> b = a.toSorted(ArrayPolicy(4, 1000), false);
+  a.sortParallel(3);
+  std::sort(vec.begin(), vec.end());
+  cout<<"a.sortParallel(3) matches std::sort = "<<(a.toVector() == vec)<<endl;
+  std::reverse(vec.begin(), vec.end());
+  cout<<"a.toSorted(ArrayPolicy(4, 1000), false) matches reversed std::sort = "<<(b.toVector() == vec)<<endl;
+  Array<char> c({'f', 'e', 'd', 'c', 'b', 'a'});
+  cout<<"c = ";
+  c.show();
+  cout<<"c.sort(ArrayPolicy(2, 1), true, 1, -2): ";
+  c.sort(ArrayPolicy(2, 1), true, 1, -2);
+  c.show();
+}
+
+void testMethodsSortedSearch () {
+  Array<int> a({7, 3, 9, 3, 1, 5, 3, 8});
+  cout<<"a.show(): ";
+  a.show();
+  cout<<"a.isSorted() -> "<<a.isSorted()<<endl;
+  a.sort();
+  cout<<"a.sort(): ";
+  a.show();
+  cout<<"a.isSorted() -> "<<a.isSorted()<<", a.isSorted(false) -> "<<a.isSorted(false)<<endl;
+  cout<<"a.find(3) = "<<a.find(3)<<", a.count(3) = "<<a.count(3)<<", a.contains(4) -> "<<a.contains(4)<<endl;
+  cout<<"a.findAll(3, 2): ";
+  a.findAll(3, 2).show();
+  cout<<"a.searchsorted(3) = "<<a.searchsorted(3)<<", a.searchsorted(3, 'r') = "<<a.searchsorted(3, 'r')<<endl;
+  cout<<"a.searchsorted({0, 3, 6, 10}): ";
+  a.searchsorted({0, 3, 6, 10}).show();
+  cout<<"a.searchsorted({10, 3, 0, 6}, 'r'): ";
+  a.searchsorted({10, 3, 0, 6}, 'r').show();
+  a[0] = 4;
+  cout<<"a[0] = 4, a.isSorted() -> "<<a.isSorted()<<", a.find(4) = "<<a.find(4)<<endl;
+  Array<int> b = a.toSorted(false);
+  cout<<"b = a.toSorted(false): ";
+  b.show();
+  cout<<"b.isSorted(false) -> "<<b.isSorted(false)<<", b.find(3) = "<<b.find(3)<<", b.count(3) = "<<b.count(3)<<endl;
+  cout<<"b.searchsorted({9, 4, 3}): ";
+  b.searchsorted({9, 4, 3}).show();
+  b.reverse();
+  cout<<"b.reverse(), b.isSorted() -> "<<b.isSorted()<<", b.find(8) = "<<b.find(8)<<endl;
+  b.append(2);
+  cout<<"b.append(2), b.isSorted() -> "<<b.isSorted()<<", b.find(2) = "<<b.find(2)<<endl;
+  Array<double> c({2.5, 0.5, 1.5});
+  c.sort();
+  cout<<"c.sort(), c.searchsorted(std::vector<double>({0.0, 1.5, 3.0})): ";
+  c.searchsorted(std::vector<double>({0.0, 1.5, 3.0})).show();
+  try {
+    a.searchsorted(3, 'x');
+  } catch (std::invalid_argument& e) {
+    cout<<"a.searchsorted(3, 'x') -> "<<e.what()<<endl;
+  }
+}
+
 void testMethodForEach () {
   Array<int> a({1, 2, 3, 2, 1, 4});
   cout<<"a.show(): ";
@@ -301,6 +642,9 @@ void testMethodForEach () {
   a.forEach([] (int elem) { cout<<"("<<elem<<"),"; });
   cout<<endl<<"a.forEach([] (int elem, int idx) { cout<<\"(\"<<idx<<\": \"<<elem<<\"),\"; }) -> ";
   a.forEach([] (int elem, int idx) { cout<<"("<<idx<<": "<<elem<<"),"; });
+  int sum = 0;
+  a.forEach([&sum] (int elem) { sum += elem; });
+  cout<<endl<<"a.forEach([&sum] (int elem) { sum += elem; }) -> sum = "<<sum<<endl;
 }
 
 void testMethodFilter () {
@@ -313,6 +657,28 @@ void testMethodFilter () {
   a.filter([] (int elem, int index) { return elem > 1 && index < 4; }).show();
   cout<<"a.filter([] (int elem, int index, Array<int> array) { return elem > array.mean(); }): ";
   a.filter([] (int elem, int index, const Array<int> &array) { return elem > array.mean(); }).show();
+  int limit = 2;
+  cout<<"a.filter([limit] (int elem) { return elem >= limit; }): ";
+  a.filter([limit] (int elem) { return elem >= limit; }).show();
+}
+
+void testMethodCompress () {
+  Array<int> a({5, -1, 3, 0, -7, 8, 2});
+  Array<bool> m({1, 0, 0, 1, 1, 0, 1});
+  cout<<"a.show(): ";
+  a.show();
+  cout<<"a.compress(m): ";
+  a.compress(m).show();
+  cout<<"a[a > 0]: ";
+  a[a > 0].show();
+  cout<<"a[(a > 0) & (a < 6)]: ";
+  a[(a > 0) & (a < 6)].show();
+  cout<<"a.where(a < 0): ";
+  a.where(a < 0).show();
+  Array<double> b(200);
+  for (int i = 0; i < b.size(); i++) b[i] = i * 0.5;
+  cout<<"b[b >= 97.5]: ";
+  b[b >= 97.5].show();
 }
 
 void testMethodMap () {
@@ -325,6 +691,11 @@ void testMethodMap () {
   a.map<int>([] (int elem, int idx) { return elem * idx; }).show();
   cout<<"a.map<double>([] (int elem, int idx, const Array<int> &array) { return elem - array.mean(); }): ";
   a.map<double>([] (int elem, int idx, const Array<int> &array) { return elem - array.mean(); }).show();
+  double scale = 0.5;
+  cout<<"a.map([scale] (int elem) { return elem * scale; }): ";
+  a.map([scale] (int elem) { return elem * scale; }).show();
+  cout<<"a.map([] (int elem) { return elem > 2; }): ";
+  a.map([] (int elem) { return elem > 2; }).show();
 }
 
 void testMethodsMinMax () {
@@ -385,6 +756,239 @@ void testMethodsVarStdev () {
   cout<<"a.stdev(1, -2) = "<<a.stdev(1, -2)<<endl;
 }
 
+void testMethodDescribe () {
+  Array<int> a({1, 2, 3, 4, 5});
+  cout<<"a.show(): ";
+  a.show();
+  ArrayStats<int> st = a.describe();
+  cout<<"a.describe(): count = "<<st.count<<", min = "<<st.min<<", max = "<<st.max<<", sum = "<<st.sum<<", mean = "<<st.mean<<endl;
+  cout<<"  variance = "<<st.variance()<<", stdev = "<<st.stdev()<<", meanG = "<<st.meanG()<<", meanH = "<<st.meanH()<<endl;
+  st = a.describe(1, -2);
+  cout<<"a.describe(1, -2): count = "<<st.count<<", min = "<<st.min<<", max = "<<st.max<<", mean = "<<st.mean<<", variance = "<<st.variance()<<endl;
+  cout<<"|a.describe(1, -2).variance() - a.variance(1, -2)| < 1e-12 -> "<<(fabs(st.variance() - a.variance(1, -2)) < 1e-12)<<endl;
+  Array<double> b(100000);
+  for (int i = 0; i < b.size(); i++) b[i] = 1e300 * (1 + (i % 7));
+  ArrayStats<double> sb = b.describe(), sp = b.describe(ArrayPolicy(4, 1000));
+  cout<<"b.describe().meanG() (product overflows) = "<<sb.meanG()<<endl;
+  cout<<"|b.describe(p).mean - b.describe().mean| < 1e288 -> "<<(fabs(sp.mean - sb.mean) < 1e288)<<", max = "<<sp.max<<endl;
+}
+
+void testRunningStats () {
+  Array<int> a({1, 2, 3, 4, 5});
+  cout<<"a.show(): ";
+  a.show();
+  RunningStats<int> r;
+  for (int i = 0; i < a.size(); i++) r.push(a[i]);
+  cout<<"push each: count = "<<r.count()<<", min = "<<r.min()<<", max = "<<r.max()<<", sum = "<<r.sum()<<", mean = "<<r.mean()<<endl;
+  cout<<"  variance = "<<r.variance()<<", stdev = "<<r.stdev()<<", meanG = "<<r.meanG()<<", meanH = "<<r.meanH()<<endl;
+  RunningStats<int> left, right;
+  left.push(a.slice(0, 1));
+  right.push(a.slice(2));
+  left.merge(right);
+  cout<<"push(a.slice(0, 1)), merge(push(a.slice(2))): mean = "<<left.mean()<<", variance = "<<left.variance()<<endl;
+  Array<double> b(10000);
+  RunningStats<double> rb;
+  for (int i = 0; i < b.size(); i++) {
+    b[i] = 1e9 + (i % 13) * 0.1;
+    rb.push(b[i]);
+  }
+  cout<<"|rb.variance() - b.variance()| < 1e-9 -> "<<(fabs(rb.variance() - b.variance()) < 1e-9)<<endl;
+  cout<<"|rb.stdev() - b.stdev()| < 1e-9 -> "<<(fabs(rb.stdev() - b.stdev()) < 1e-9)<<endl;
+  rb.clear();
+  cout<<"rb.clear(): count = "<<rb.count()<<", mean = "<<rb.mean()<<endl;
+}
+
+void testMethodsMoving () {
+  Array<int> a({4, 1, 3, 5, 2, 6, 0});
+  cout<<"a.show(): ";
+  a.show();
+  cout<<"a.movingSum(3): ";
+  a.movingSum(3).show();
+  cout<<"a.movingMean(3): ";
+  a.movingMean(3).show();
+  cout<<"a.movingMin(3): ";
+  a.movingMin(3).show();
+  cout<<"a.movingMax(3): ";
+  a.movingMax(3).show();
+  cout<<"a.movingVariance(3): ";
+  a.movingVariance(3).show();
+  cout<<"a.movingStdev(2, 2): ";
+  a.movingStdev(2, 2).show();
+  cout<<"a.movingSum(3, 2): ";
+  a.movingSum(3, 2).show();
+  cout<<"a.movingMax(3, 1, 'p'): ";
+  a.movingMax(3, 1, 'p').show();
+  cout<<"a.movingMean(3, 3, 'p'): ";
+  a.movingMean(3, 3, 'p').show();
+  cout<<"a.movingSum(10).size() = "<<a.movingSum(10).size()<<endl;
+  Array<double> b(5000);
+  for (int i = 0; i < b.size(); i++) b[i] = 1e9 + ((i * 37) % 101) * 0.01;
+  Array<double> v = b.movingVariance(100, 50);
+  bool ok = v.size() == 99;
+  for (int k = 0; k < v.size(); k++) ok = ok && fabs(v[k] - b.variance(k * 50, k * 50 + 99)) < 1e-6;
+  cout<<"b.movingVariance(100, 50)[k] == b.variance(k * 50, k * 50 + 99) -> "<<ok<<endl;
+  try {
+    a.movingSum(0);
+  } catch (const std::invalid_argument &e) {
+    cout<<"a.movingSum(0): "<<e.what()<<endl;
+  }
+  try {
+    a.movingMin(2, 1, 'x');
+  } catch (const std::invalid_argument &e) {
+    cout<<"a.movingMin(2, 1, 'x'): "<<e.what()<<endl;
+  }
+}
+
+void testMethodsCumulative () {
+  Array<int> a({3, 1, 4, 1, 5, 9, 2, 6});
+  cout<<"a.show(): ";
+  a.show();
+  cout<<"a.cumsum(): ";
+  a.cumsum().show();
+  cout<<"a.cumprod(0, 4): ";
+  a.cumprod(0, 4).show();
+  cout<<"a.cummin(): ";
+  a.cummin().show();
+  cout<<"a.cummax(2): ";
+  a.cummax(2).show();
+  Array<int> b = a;
+  b.cumsumInPlace(2, 5);
+  cout<<"b = a, b.cumsumInPlace(2, 5): ";
+  b.show();
+  Array<double> c({1.5, -2.0, 0.5, 4.0});
+  cout<<"c.show(): ";
+  c.show();
+  cout<<"c.cumsum(): ";
+  c.cumsum().show();
+  cout<<"c.cummin(): ";
+  c.cummin().show();
+  Array<int> d(100000);
+  for (int i = 0; i < d.size(); i++) d[i] = (int) (((long long) i * 7919) % 1000) - 500;
+  ArrayPolicy p(4, 1000);
+  cout<<"d.cumsum(p) == d.cumsum() -> "<<(d.cumsum(p).toVector() == d.cumsum().toVector())<<endl;
+  cout<<"d.cummax(p, 10, -10) == d.cummax(10, -10) -> "<<(d.cummax(p, 10, -10).toVector() == d.cummax(10, -10).toVector())<<endl;
+  Array<int> e = d;
+  e.cumminInPlace(p);
+  cout<<"e = d, e.cumminInPlace(p) == d.cummin() -> "<<(e.toVector() == d.cummin().toVector())<<endl;
+}
+
+void testRangeQuery () {
+  Array<int> a({5, 2, 8, 2, 9, 1, 7, 9, 3});
+  cout<<"a.show(): ";
+  a.show();
+  RangeQueryIndex<int> ix(a);
+  cout<<"ix.size() = "<<ix.size()<<endl;
+  cout<<"ix.min() = "<<ix.min()<<", ix.max() = "<<ix.max()<<", ix.sum() = "<<ix.sum()<<", ix.mean() = "<<ix.mean()<<endl;
+  cout<<"ix.min(0, 4) = "<<ix.min(0, 4)<<", ix.argmin(0, 4) = "<<ix.argmin(0, 4)<<endl;
+  cout<<"ix.max(2, -2) = "<<ix.max(2, -2)<<", ix.argmax(2, -2) = "<<ix.argmax(2, -2)<<endl;
+  cout<<"ix.sum(-3) = "<<ix.sum(-3)<<", ix.mean(1, 3) = "<<ix.mean(1, 3)<<endl;
+  RangeQueryTree<int> tr(a);
+  tr.set(5, 10);
+  tr.add(-1, -4);
+  cout<<"tr.set(5, 10), tr.add(-1, -4): tr.get(5) = "<<tr.get(5)<<", tr.get(-1) = "<<tr.get(-1)<<endl;
+  cout<<"tr.min() = "<<tr.min()<<", tr.argmin() = "<<tr.argmin()<<", tr.max(0, 6) = "<<tr.max(0, 6)<<", tr.argmax(0, 6) = "<<tr.argmax(0, 6)<<endl;
+  cout<<"tr.sum() = "<<tr.sum()<<", tr.mean(4, 6) = "<<tr.mean(4, 6)<<endl;
+  Array<int> b(5000);
+  for (int i = 0; i < b.size(); i++) b[i] = (int) (((long long) i * 7919) % 1000) - 500;
+  RangeQueryIndex<int> ib(b);
+  bool ok = true;
+  for (int f = 0; f < b.size(); f += 37) {
+    for (int t = f; t < b.size(); t += 101) {
+      ok = ok && ib.min(f, t) == b.min(f, t) && ib.argmax(f, t) == b.argmax(f, t)[0] && ib.sum(f, t) == b.sum(f, t);
+    }
+  }
+  cout<<"RangeQueryIndex<int>(b) == b.min / b.argmax / b.sum -> "<<ok<<endl;
+  Array<double> c({1e20, 1, 1, 3.5});
+  RangeQueryIndex<double> ic(c);
+  cout<<"c = {1e20, 1, 1, 3.5}: ic.sum(1, 2) = "<<ic.sum(1, 2)<<", ic.mean(1, 3) = "<<ic.mean(1, 3)<<", ic.sum(0, 1) = "<<ic.sum(0, 1)<<endl;
+  try {
+    ix.min(5, 2);
+  } catch (const std::invalid_argument &e) {
+    cout<<"ix.min(5, 2): "<<e.what()<<endl;
+  }
+}
+
+void testHashIndex () {
+  Array<int> a({4, 7, 4, 1, 9, 7, 4});
+  cout<<"a.show(): ";
+  a.show();
+  HashIndex<int> h(a);
+  cout<<"h.size() = "<<h.size()<<endl;
+  cout<<"h.contains(9) -> "<<h.contains(9)<<", h.contains(5) -> "<<h.contains(5)<<endl;
+  cout<<"h.find(7) = "<<h.find(7)<<", h.find(5) = "<<h.find(5)<<", h.count(4) = "<<h.count(4)<<endl;
+  cout<<"h.findAll(4): ";
+  h.findAll(4).show();
+  a.append({5, 4});
+  h.afterAppend(a);
+  cout<<"a.append({5, 4}), h.afterAppend(a), h.find(5) = "<<h.find(5)<<", h.findAll(4): ";
+  h.findAll(4).show();
+  a.insert({9, 4}, 2);
+  h.afterInsert(a, 2);
+  cout<<"a.insert({9, 4}, 2), h.afterInsert(a, 2), h.findAll(9): ";
+  h.findAll(9).show();
+  cout<<"h.findAll(4): ";
+  h.findAll(4).show();
+  a.erase(0, 3);
+  h.afterErase(a, 0, 3);
+  cout<<"a.erase(0, 3), h.afterErase(a, 0, 3): ";
+  a.show();
+  cout<<"h.find(4) = "<<h.find(4)<<", h.count(4) = "<<h.count(4)<<", h.count(9) = "<<h.count(9)<<endl;
+  try {
+    h.afterErase(a, 0, 2);
+  } catch (const std::invalid_argument &e) {
+    cout<<"h.afterErase(a, 0, 2): "<<e.what()<<endl;
+  }
+  Array<double> d({2.5, -0.5, 2.5});
+  HashIndex<double> hd(d);
+  cout<<"d.show(): ";
+  d.show();
+  cout<<"hd.count(2.5) = "<<hd.count(2.5)<<", hd.find(-0.5) = "<<hd.find(-0.5)<<endl;
+}
+
+void testMethodsParallelReductions () {
+  Array<int> a(100000);
+  for (int i = 0; i < a.size(); i++) a[i] = (i * 7919) % 1000 - 500;
+  a[500] = -1000;
+  a[70000] = -1000;
+  ArrayPolicy p(4, 1000);
+  cout<<"a.sum(p) == a.sum() -> "<<(a.sum(p) == a.sum())<<endl;
+  cout<<"a.min(p) = "<<a.min(p)<<", a.max(p) = "<<a.max(p)<<endl;
+  cout<<"a.argmin(p) = ";
+  a.argmin(p).show();
+  cout<<"a.argmax(p, 10, -10) == a.argmax(10, -10) -> "<<(a.argmax(p, 10, -10).toVector() == a.argmax(10, -10).toVector())<<endl;
+  cout<<"a.mean(p) == a.mean() -> "<<(a.mean(p) == a.mean())<<endl;
+  cout<<"|a.variance(p) - a.variance()| < 1e-6 -> "<<(fabs(a.variance(p) - a.variance()) < 1e-6)<<endl;
+  cout<<"|a.stdev(p, 5) - a.stdev(5)| < 1e-6 -> "<<(fabs(a.stdev(p, 5) - a.stdev(5)) < 1e-6)<<endl;
+  Array<int> v({1, 2, 3, 4, 5, 10});
+  cout<<"v = [1, 2, 3, 4, 5, 10], v.variance(1, 3) = "<<v.variance(1, 3)<<", v.variance(ArrayPolicy(2, 1), 1, 3) = "<<v.variance(ArrayPolicy(2, 1), 1, 3);
+  cout<<", v.view(1, 3).variance() = "<<v.view(1, 3).variance()<<endl;
+  Array<double> d(5000);
+  d.fill(1.0001);
+  d[123] = 0.0;
+  cout<<"d.product(p) = "<<d.product(ArrayPolicy(4, 100))<<endl;
+}
+
+void testMethodsParallelFunctors () {
+  Array<int> a(100000);
+  for (int i = 0; i < a.size(); i++) a[i] = (i * 7919) % 1000 - 500;
+  ArrayPolicy p(4, 1000);
+  int limit = 250;
+  auto big = [limit] (int elem) { return elem > limit; };
+  cout<<"a.filter(p, big) == a.filter(big) -> "<<(a.filter(p, big).toVector() == a.filter(big).toVector())<<endl;
+  auto odd = [] (int elem, int index) { return (elem + index) % 2 != 0; };
+  cout<<"a.filter(p, odd) == a.filter(odd) -> "<<(a.filter(p, odd).toVector() == a.filter(odd).toVector())<<endl;
+  auto square = [] (int elem) { return (long long) elem * elem; };
+  cout<<"a.map(p, square) == a.map(square) -> "<<(a.map(p, square).toVector() == a.map(square).toVector())<<endl;
+  auto negative = [] (int elem) { return elem < 0; };
+  cout<<"a.map(p, negative) == a.map(negative) -> "<<(a.map(p, negative).toVector() == a.map(negative).toVector())<<endl;
+  std::atomic<long long> sum(0);
+  a.forEach(p, [&sum] (int elem) { sum += elem; });
+  cout<<"a.forEach(p, sum += elem) == a.sum() -> "<<(sum == a.sum())<<endl;
+  Array<int> b({1, 2, 3, 4, 5});
+  cout<<"b.filter(p, odd elements) (serial fallback): ";
+  b.filter(p, [] (int elem) { return elem % 2 == 1; }).show();
+}
+
 void testOperatorsArithmetic () {
   Array<int> a({1, 2, 3, 4, 5});
   Array<int> b({2, 1, 2, 1, 3, 4});
@@ -452,6 +1056,64 @@ void testOperatorsArithmetic () {
   a.show();
 }
 
+void testOperatorsArithmeticKernels () {
+  Array<double> a(37), b(21);
+  for (int i = 0; i < a.size(); i++) a[i] = i * 0.5;
+  for (int i = 0; i < b.size(); i++) b[i] = 2.0;
+  Array<double> c = a * b;
+  cout<<"(a * b).size() = "<<c.size()<<", c[20] = "<<c[20]<<", c[36] = "<<c[36]<<endl;
+  Array<long> l(33);
+  l.fill(1000000000000L);
+  l *= 3L;
+  l -= l / 2L;
+  cout<<"l.sum() = "<<l.sum()<<endl;
+  Array<float> f({1.5f, 2.5f});
+  f += Array<float>({1.0f, 1.0f, 4.0f});
+  cout<<"f += {1, 1, 4}: ";
+  f.show();
+}
+
+void testOperatorsExpressions () {
+  Array<int> a({1, 2, 3, 4, 5});
+  Array<int> b({2, 1, 2, 1, 3, 4});
+  Array<int> c({1, 1, 1});
+  cout<<"a = ";
+  a.show();
+  cout<<"b = ";
+  b.show();
+  cout<<"c = ";
+  c.show();
+  Array<int> x = a * 2 + b - c;
+  cout<<"Array<int> x = a * 2 + b - c -> ";
+  x.show();
+  cout<<"(a * 2 + b - c).sum() = "<<(a * 2 + b - c).sum()<<endl;
+  cout<<"(a * b).mean() = "<<(a * b).mean()<<endl;
+  cout<<"(a - b).min() = "<<(a - b).min()<<", (a - b).max() = "<<(a - b).max()<<endl;
+  cout<<"(a + b)[-1] = "<<(a + b)[-1]<<endl;
+  Array<bool> m = (a > 2) & (b < 3);
+  cout<<"Array<bool> m = (a > 2) & (b < 3) -> ";
+  m.show();
+  cout<<"!(a >= b) = ";
+  (!(a >= b)).show();
+  cout<<"c = c + b * 10 -> ";
+  c = c + b * 10;
+  c.show();
+  cout<<"c -= a * a -> ";
+  c -= a * a;
+  c.show();
+  Array<double> d = a.astype<double>() / 2.0 + 0.5;
+  cout<<"Array<double> d = a.astype<double>() / 2.0 + 0.5 -> ";
+  d.show();
+  cout<<"a.expr().sum() = "<<a.expr().sum()<<endl;
+  cout<<"(a + b).variance() = "<<(a + b).variance()<<", (a + b).find(4) = "<<(a + b).find(4)<<endl;
+  cout<<"(a * 2).slice(1): ";
+  (a * 2).slice(1).show();
+  cout<<"(a * 2).toVector().size() = "<<(a * 2).toVector().size()<<", (a + 1).astype<double>().mean() = "<<(a + 1).astype<double>().mean()<<endl;
+  cout<<"(a + 1)[Array<int>({0, 1})]: ";
+  (a + 1)[Array<int>({0, 1})].show();
+  cout<<"(a * 2).sum(1, 2) = "<<(a * 2).sum(1, 2)<<", (a > 2).count(true) = "<<(a > 2).count(true)<<endl;
+}
+
 void testOperatorsComparison () {
   Array<int> a({1, 2, 3, 4, 5});
   Array<int> b({2, 1, 2, 1, 3, 4});
@@ -517,6 +1179,73 @@ void testOperatorsBoolean () {
   a.show();
 }
 
+void testOperatorsBooleanPacked () {
+  Array<bool> a(130);
+  a.fill(true, 60, 69);
+  a[0] = true;
+  a[-1] = true;
+  a[61].flip();
+  cout<<"capacity(130) = "<<a.capacity()<<endl;
+  cout<<"a.countTrue() = "<<a.countTrue()<<endl;
+  cout<<"a.countTrue(60, 69) = "<<a.countTrue(60, 69)<<endl;
+  cout<<"a.any(1, 59) = "<<a.any(1, 59)<<endl;
+  cout<<"a.all(62, 69) = "<<a.all(62, 69)<<endl;
+  cout<<"a.findAll(true) = ";
+  a.findAll(true).show();
+  Array<bool> b = !a;
+  cout<<"(!a).countTrue() = "<<b.countTrue()<<endl;
+  cout<<"(a | !a).all() = "<<(a | b).all()<<endl;
+  cout<<"(a & !a).any() = "<<(a & b).any()<<endl;
+  cout<<"a.slice(58, 71) = ";
+  a.slice(58, 71).show();
+  Array<bool> m({1, 0, 0, 1, 1, 0});
+  cout<<"m.show(): ";
+  m.show();
+  Array<bool> s = m;
+  s.shift(2, 1, -2);
+  cout<<"m.shift(2, 1, -2): ";
+  s.show();
+  s = m;
+  s.replace(false, true, 0, 2);
+  cout<<"m.replace(false, true, 0, 2): ";
+  s.show();
+  cout<<"m.toSorted(): ";
+  m.toSorted().show();
+  cout<<"m.toSorted(false, 1): ";
+  m.toSorted(false, 1).show();
+  cout<<"a.toSorted().findAll(true).size() = "<<a.toSorted().findAll(true).size()<<", a.toSorted()[-9] = "<<a.toSorted()[-9]<<", a.toSorted()[-10] = "<<a.toSorted()[-10]<<endl;
+  cout<<"m.unique(): ";
+  m.unique().show();
+  cout<<"m.toList().size() = "<<m.toList().size()<<", m.toSet().size() = "<<m.toSet().size()<<endl;
+  cout<<"m.sum() = "<<m.sum()<<", m.min() = "<<m.min()<<", m.max() = "<<m.max()<<", m.mean() = "<<m.mean()<<", m.variance() = "<<m.variance()<<endl;
+  cout<<"m.argmin(): ";
+  m.argmin().show();
+  cout<<"m.argmax(1, 3): ";
+  m.argmax(1, 3).show();
+  cout<<"m.forEach(...): ";
+  m.forEach([] (bool elem, int idx) { cout<<"("<<idx<<": "<<elem<<"),"; });
+  cout<<endl<<"m.filter([] (bool elem, int index) { return elem || index == 1; }): ";
+  m.filter([] (bool elem, int index) { return elem || index == 1; }).show();
+  cout<<"m.map([] (bool elem, int idx) { return elem ? idx : -1; }): ";
+  m.map([] (bool elem, int idx) { return elem ? idx : -1; }).show();
+  ArrayPolicy p(4, 1);
+  std::atomic<int> ones(0);
+  a.forEach(p, [&ones] (bool elem) { ones += elem; });
+  cout<<"a.forEach(p, ...) counts "<<ones<<", a.filter(p, ...).size() = "<<a.filter(p, [] (bool elem) { return elem; }).size();
+  cout<<", a.map(p, ...) == !a -> "<<(a.map(p, [] (bool elem) { return !elem; }) == b).all()<<endl;
+  Array<bool> k({0, 0, 1, 1, 1});
+  cout<<"m < k: ";
+  Array<bool>(m < k).show();
+  cout<<"m >= true: ";
+  Array<bool>(m >= true).show();
+  cout<<"m + k: ";
+  Array<bool>(m + k).show();
+  s = m;
+  s *= k;
+  cout<<"m *= k: ";
+  s.show();
+}
+
 int main () {
   cout<<"Running all tests..."<<endl;
   clock_t begin = clock();
@@ -531,27 +1260,49 @@ int main () {
   testMethodFill();
   testMethodReverse();
   testMethodResize();
+  testMethodsCapacity();
+  testAllocators();
+  testMapFile();
+  testSaveLoad();
   testMethodCount();
   testMethodFind();
   testMethodFindAll();
+  testMethodFindAllMulti();
   testMethodShift();
   testMethodContains();
   testMethodReplace();
   testMethodSlice();
+  testMethodView();
   testMethodClear();
   testMethodUnique();
+  testMethodsSetOperations();
   testMethodSort();
+  testMethodSortEngines();
+  testMethodSortParallel();
+  testMethodsSortedSearch();
   testMethodForEach();
   testMethodFilter();
+  testMethodCompress();
   testMethodMap();
   testMethodsMinMax();
   testMethodsArgminArgmax();
   testMethodsSumProduct();
   testMethodsMeans();
   testMethodsVarStdev();
+  testMethodDescribe();
+  testRunningStats();
+  testMethodsMoving();
+  testMethodsCumulative();
+  testRangeQuery();
+  testHashIndex();
+  testMethodsParallelReductions();
+  testMethodsParallelFunctors();
   testOperatorsArithmetic();
+  testOperatorsArithmeticKernels();
+  testOperatorsExpressions();
   testOperatorsComparison();
   testOperatorsBoolean();
+  testOperatorsBooleanPacked();
   clock_t end = clock();
   double elapsed = double(end - begin) / CLOCKS_PER_SEC;
   cout<<"Testing complete in "<<elapsed<<"s."<<endl;